@@ -0,0 +1,96 @@
+#ifndef OCCA_BENCHMARKS_INTERNAL_LANG_OKLCORPUS_HEADER
+#define OCCA_BENCHMARKS_INTERNAL_LANG_OKLCORPUS_HEADER
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/types/json.hpp>
+
+// OKL sources used to benchmark the translation front end
+struct oklSource_t {
+  std::string name;
+  std::string source;
+  occa::json defines;
+};
+
+struct oklFile_t {
+  const char *filename;
+  const char *defines;
+};
+
+const oklFile_t oklFiles[] = {
+  {"tests/files/addVectors.okl", "{}"},
+  {"tests/files/argKernel.okl", "{}"},
+  {"examples/cpp/06_shared_memory/reduction.okl", "{ block: 256 }"},
+  {"examples/cpp/15_finite_difference/fd2d.okl",
+   "{ sr: 8, w: 1000, h: 1000, dx: 0.01, dt: 0.001, freq: 0.5,"
+   "  mX: 500, mY: 500, Bx: 16, By: 16, tFloat: 'float' }"},
+  {"examples/cpp/16_mandelbulb/rayMarcher.okl",
+   "{ WIDTH: 1024, HEIGHT: 1024, BATCH_SIZE: 16, SHAPE_FUNCTION: 'sdf',"
+   "  PIXEL: 0.002, HALF_PIXEL: 0.001, tFloat: 'float', tFloat3: 'float3' }"},
+  {NULL, NULL}
+};
+
+// Shared-memory stencil kernels, repeated to build larger sources
+inline std::string generateOklKernels(const int kernelCount) {
+  std::stringstream ss;
+  ss << "#define BLOCK 64\n"
+     << "#define STENCIL(a, i) (0.25f * (a[i - 1] + 2.0f * a[i] + a[i + 1]))\n\n";
+
+  for (int k = 0; k < kernelCount; ++k) {
+    ss << "@kernel void stencil" << k << "(const int entries,\n"
+       << "                        const float *in,\n"
+       << "                        float *out) {\n"
+       << "  for (int group = 0; group < entries; group += BLOCK; @outer) {\n"
+       << "    @shared float s_in[BLOCK + 2];\n"
+       << "    @exclusive float value;\n"
+       << "\n"
+       << "    for (int item = 0; item < BLOCK; ++item; @inner) {\n"
+       << "      const int index = group + item;\n"
+       << "      s_in[item + 1] = (index < entries) ? in[index] : 0.0f;\n"
+       << "      if (item == 0) {\n"
+       << "        s_in[0] = (0 < index) ? in[index - 1] : 0.0f;\n"
+       << "        s_in[BLOCK + 1] = ((index + BLOCK) < entries) ? in[index + BLOCK] : 0.0f;\n"
+       << "      }\n"
+       << "    }\n"
+       << "\n"
+       << "    for (int item = 0; item < BLOCK; ++item; @inner) {\n"
+       << "      value = STENCIL(s_in, item + 1) * " << (k + 1) << ";\n"
+       << "      if ((group + item) < entries) {\n"
+       << "        out[group + item] = value;\n"
+       << "      }\n"
+       << "    }\n"
+       << "  }\n"
+       << "}\n\n";
+  }
+  return ss.str();
+}
+
+inline std::vector<oklSource_t> getOklCorpus() {
+  std::vector<oklSource_t> corpus;
+
+  for (int i = 0; oklFiles[i].filename; ++i) {
+    const oklFile_t &oklFile = oklFiles[i];
+    corpus.push_back({
+      oklFile.filename,
+      occa::io::read(occa::env::OCCA_DIR + oklFile.filename),
+      occa::json::parse(oklFile.defines)
+    });
+  }
+
+  const int kernelCounts[] = {1, 8, 64};
+  for (const int kernelCount : kernelCounts) {
+    corpus.push_back({
+      "generated/stencil x" + std::to_string(kernelCount),
+      generateOklKernels(kernelCount),
+      occa::json::parse("{}")
+    });
+  }
+
+  return corpus;
+}
+
+#endif
@@ -0,0 +1,277 @@
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#include <occa/internal/lang/modes/cuda.hpp>
+#include <occa/internal/lang/modes/opencl.hpp>
+#include <occa/internal/lang/modes/openmp.hpp>
+#include <occa/internal/lang/modes/serial.hpp>
+#include <occa/internal/lang/preprocessor.hpp>
+#include <occa/internal/lang/tokenizer.hpp>
+#include <occa/internal/utils/sys.hpp>
+
+#include "oklCorpus.hpp"
+
+using namespace occa::lang;
+
+// Runs each stage of the OKL translation over the corpus and reports
+//   the throughput and allocations per translation:
+//
+//   tokenize   : Source -> tokens
+//   preprocess : Macro expansion and directives (tokenizing is excluded)
+//   parse      : Tokens -> AST, including the shared @dim/@tile/@restrict transforms
+//   <mode>     : Mode-specific AST transforms
+//   print      : AST -> source
+
+//---[ Allocation Counter ]-------------
+std::atomic<occa::udim_t> heapAllocations(0);
+
+void* operator new(std::size_t bytes) {
+  heapAllocations.fetch_add(1, std::memory_order_relaxed);
+  void *ptr = std::malloc(bytes ? bytes : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t bytes) noexcept {
+  std::free(ptr);
+}
+
+occa::udim_t getAllocations() {
+  return heapAllocations.load(std::memory_order_relaxed);
+}
+//======================================
+
+//---[ Stage Stats ]--------------------
+class stageStats_t {
+public:
+  double time;
+  occa::udim_t allocations;
+
+  stageStats_t() :
+    time(-1),
+    allocations(0) {}
+
+  // Keep the fastest run to filter out system noise
+  void add(const double time_,
+           const occa::udim_t allocations_) {
+    if ((time < 0) || (time_ < time)) {
+      time = time_;
+    }
+    allocations = allocations_;
+  }
+
+  stageStats_t operator - (const stageStats_t &other) const {
+    stageStats_t stats;
+    stats.time = (time > other.time) ? (time - other.time) : 0;
+    stats.allocations = (
+      (allocations > other.allocations)
+      ? (allocations - other.allocations)
+      : 0
+    );
+    return stats;
+  }
+};
+
+class stageTimer_t {
+public:
+  double startTime;
+  occa::udim_t startAllocations;
+
+  stageTimer_t() {
+    start();
+  }
+
+  void start() {
+    startAllocations = getAllocations();
+    startTime = occa::sys::currentTime();
+  }
+
+  void stop(stageStats_t &stats) {
+    const double time = occa::sys::currentTime() - startTime;
+    stats.add(time, getAllocations() - startAllocations);
+    start();
+  }
+};
+//======================================
+
+//---[ Stages ]-------------------------
+void failed(const std::string &stage,
+            const std::string &name) {
+  std::cerr << "Failed to " << stage << " [" << name << "]\n";
+  ::exit(1);
+}
+
+stageStats_t tokenize(const oklSource_t &oklSource,
+                      const int iterations) {
+  stageStats_t stats;
+  for (int i = 0; i < iterations; ++i) {
+    stageTimer_t timer;
+
+    tokenizer_t tokenizer;
+    tokenizer.set(oklSource.source.c_str());
+
+    token_t *token;
+    while (!tokenizer.isEmpty()) {
+      tokenizer >> token;
+      delete token;
+    }
+    if (tokenizer.errors) {
+      failed("tokenize", oklSource.name);
+    }
+
+    timer.stop(stats);
+  }
+  return stats;
+}
+
+stageStats_t tokenizeAndPreprocess(const oklSource_t &oklSource,
+                                   const int iterations) {
+  tokenizer_t tokenizer;
+  preprocessor_t preprocessor;
+  occa::lang::stream<token_t*> tokenStream = tokenizer.map(preprocessor);
+
+  stageStats_t stats;
+  for (int i = 0; i < iterations; ++i) {
+    stageTimer_t timer;
+
+    tokenizer.set(oklSource.source.c_str());
+    preprocessor.clear();
+    for (const auto &it : oklSource.defines.object()) {
+      preprocessor.addSourceDefine(it.first, it.second.toString());
+    }
+
+    token_t *token;
+    while (!tokenStream.isEmpty()) {
+      tokenStream >> token;
+      delete token;
+    }
+    if (tokenizer.errors || preprocessor.errors) {
+      failed("preprocess", oklSource.name);
+    }
+
+    timer.stop(stats);
+  }
+  return stats;
+}
+
+// Splits parseSource() into its stages through the parser hooks
+template <class parserType>
+class timedParser : public parserType {
+public:
+  stageTimer_t timer;
+  stageStats_t loadStats;
+  stageStats_t parseStats;
+  stageStats_t transformStats;
+
+  timedParser(const occa::json &settings_) :
+    parserType(settings_) {}
+
+  void translate(const oklSource_t &oklSource) {
+    // Free the previous AST outside of the timings
+    this->clear();
+
+    timer.start();
+    this->parseSource(oklSource.source);
+
+    if (!this->succeeded()) {
+      failed("translate", oklSource.name);
+    }
+  }
+
+  void beforeParsing() override {
+    timer.stop(loadStats);
+    parserType::beforeParsing();
+  }
+
+  void afterParsing() override {
+    timer.stop(parseStats);
+    parserType::afterParsing();
+    timer.stop(transformStats);
+  }
+};
+
+occa::json getParserSettings(const oklSource_t &oklSource) {
+  occa::json settings;
+  settings["defines"] = oklSource.defines;
+  settings["serial/include_std"] = false;
+  return settings;
+}
+
+template <class parserType>
+stageStats_t transform(const oklSource_t &oklSource,
+                       const int iterations) {
+  timedParser<parserType> parser(getParserSettings(oklSource));
+  for (int i = 0; i < iterations; ++i) {
+    parser.translate(oklSource);
+  }
+  return parser.transformStats;
+}
+//======================================
+
+void printStage(const std::string &name,
+                const std::string &stage,
+                const occa::udim_t bytes,
+                const stageStats_t &stats) {
+  const double mbPerSecond = (
+    (stats.time > 0)
+    ? (bytes / (1e6 * stats.time))
+    : 0
+  );
+  std::cout << std::setw(48) << name
+            << std::setw(12) << stage
+            << std::setw(14) << (1e3 * stats.time)
+            << std::setw(12) << mbPerSecond
+            << stats.allocations << '\n';
+}
+
+int main(const int argc, const char **argv) {
+  const int iterations = (argc > 1) ? std::atoi(argv[1]) : 20;
+
+  std::cout << std::left << std::fixed << std::setprecision(3)
+            << std::setw(48) << "Source"
+            << std::setw(12) << "Stage"
+            << std::setw(14) << "Time (ms)"
+            << std::setw(12) << "MB/s"
+            << "Allocations\n";
+
+  for (const oklSource_t &oklSource : getOklCorpus()) {
+    const std::string &name = oklSource.name;
+    const occa::udim_t bytes = oklSource.source.size();
+
+    const stageStats_t tokenizeStats = tokenize(oklSource, iterations);
+    const stageStats_t preprocessStats = (
+      tokenizeAndPreprocess(oklSource, iterations) - tokenizeStats
+    );
+
+    // Parse and print through the serial parser
+    timedParser<okl::serialParser> parser(getParserSettings(oklSource));
+    stageStats_t printStats;
+    for (int i = 0; i < iterations; ++i) {
+      parser.translate(oklSource);
+
+      stageTimer_t timer;
+      const std::string output = parser.toString();
+      timer.stop(printStats);
+    }
+
+    printStage(name, "tokenize", bytes, tokenizeStats);
+    printStage(name, "preprocess", bytes, preprocessStats);
+    printStage(name, "parse", bytes, parser.parseStats);
+    printStage(name, "serial", bytes, parser.transformStats);
+    printStage(name, "openmp", bytes, transform<okl::openmpParser>(oklSource, iterations));
+    printStage(name, "cuda", bytes, transform<okl::cudaParser>(oklSource, iterations));
+    printStage(name, "opencl", bytes, transform<okl::openclParser>(oklSource, iterations));
+    printStage(name, "print", bytes, printStats);
+  }
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <occa/internal/utils/copyEngine.hpp>
+#include <occa/internal/utils/sys.hpp>
+
+using occa::copyEngine_t;
+
+// Compares host copies through the copy engine against a plain memcpy
+//   for sizes ranging from cache-resident to large state buffers
+// Sizes and bandwidths are given for the source buffer
+template <class copyFunction>
+double benchmark(const int iterations,
+                 copyFunction func) {
+  double minTime = -1;
+  for (int i = 0; i < iterations; ++i) {
+    const double start = occa::sys::currentTime();
+    func();
+    const double time = occa::sys::currentTime() - start;
+    if ((minTime < 0) || (time < minTime)) {
+      minTime = time;
+    }
+  }
+  return minTime;
+}
+
+int main(const int argc, const char **argv) {
+  const int iterations = (argc > 1) ? std::atoi(argv[1]) : 10;
+  const int maxThreads = std::max(1, (int) std::thread::hardware_concurrency());
+
+  std::cout << std::left
+            << std::setw(12) << "Size (MB)"
+            << std::setw(24) << "Copy"
+            << std::setw(16) << "Time (ms)"
+            << "GB/s\n";
+
+  for (const occa::udim_t megabytes : {1, 16, 256}) {
+    const occa::udim_t bytes = megabytes * 1024 * 1024;
+    std::vector<char> src(bytes, 1);
+    std::vector<char> dest(bytes, 0);
+
+    auto printTime = [&](const std::string &name, const double time) {
+      std::cout << std::setw(12) << megabytes
+                << std::setw(24) << name
+                << std::setw(16) << (1e3 * time)
+                << (bytes / (1e9 * time)) << '\n';
+    };
+
+    printTime("memcpy", benchmark(iterations, [&]() {
+      ::memcpy(&dest[0], &src[0], bytes);
+    }));
+
+    printTime("streaming stores", benchmark(iterations, [&]() {
+      copyEngine_t::copyBytes(&dest[0], &src[0], bytes, true);
+    }));
+
+    for (int threads = 2; threads <= std::max(2, maxThreads); threads *= 2) {
+      copyEngine_t engine(threads);
+      printTime("engine (" + std::to_string(threads) + " threads)",
+                benchmark(iterations, [&]() {
+                  engine.copy(&dest[0], &src[0], bytes);
+                }));
+    }
+
+    // Converted copies read the same bytes but write half or a quarter of them
+    copyEngine_t engine(maxThreads);
+    const occa::udim_t doubles = bytes / sizeof(double);
+    printTime("double -> float", benchmark(iterations, [&]() {
+      engine.convert(&dest[0], &src[0], doubles,
+                     sizeof(float), sizeof(double),
+                     occa::getDtypeConversion(occa::dtype::float_, occa::dtype::double_));
+    }));
+    printTime("double -> half", benchmark(iterations, [&]() {
+      engine.convert(&dest[0], &src[0], doubles,
+                     2, sizeof(double),
+                     occa::getDtypeConversion(occa::dtype::half, occa::dtype::double_));
+    }));
+  }
+
+  return 0;
+}
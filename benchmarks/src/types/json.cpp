@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <occa/types/json.hpp>
+#include <occa/internal/utils/sys.hpp>
+
+// Measures the json operations on the kernel launch path:
+//   parsing props, looking up settings, merging device and kernel
+//   props and hashing them for the kernel cache
+template <class benchmarkFunction>
+double benchmark(const int iterations,
+                 const int repeats,
+                 benchmarkFunction func) {
+  double minTime = -1;
+  for (int i = 0; i < iterations; ++i) {
+    const double start = occa::sys::currentTime();
+    for (int r = 0; r < repeats; ++r) {
+      func();
+    }
+    const double time = (occa::sys::currentTime() - start) / repeats;
+    if ((minTime < 0) || (time < minTime)) {
+      minTime = time;
+    }
+  }
+  return minTime;
+}
+
+// Props similar to what a device + kernel build looks like
+occa::json getProps(const int defineCount) {
+  occa::json props;
+  props["mode"] = "Serial";
+  props["compiler"] = "g++";
+  props["compiler_flags"] = "-O3 -march=native -fopenmp";
+  props["compiler_env_script"] = "";
+  props["okl/enabled"] = true;
+  props["okl/validate"] = true;
+  props["okl/include_paths"].asArray();
+  props["kernel/verbose"] = false;
+  props["serial/include_std"] = true;
+  for (int i = 0; i < defineCount; ++i) {
+    props["defines/DEFINE_" + std::to_string(i)] = i;
+  }
+  return props;
+}
+
+// Sorted flat vector, compared against the std::map jsonObject uses
+typedef std::vector<std::pair<std::string, occa::json>> flatObject;
+
+flatObject getFlatObject(const occa::jsonObject &object) {
+  return flatObject(object.begin(), object.end());
+}
+
+flatObject::const_iterator findFlat(const flatObject &object,
+                                    const std::string &key) {
+  flatObject::const_iterator it = std::lower_bound(
+    object.begin(), object.end(), key,
+    [](const flatObject::value_type &entry, const std::string &key_) {
+      return entry.first < key_;
+    }
+  );
+  return ((it != object.end()) && (it->first == key)) ? it : object.end();
+}
+
+void mergeFlat(flatObject &object,
+               const flatObject &other) {
+  for (const flatObject::value_type &entry : other) {
+    flatObject::iterator it = std::lower_bound(
+      object.begin(), object.end(), entry.first,
+      [](const flatObject::value_type &entry_, const std::string &key_) {
+        return entry_.first < key_;
+      }
+    );
+    if ((it != object.end()) && (it->first == entry.first)) {
+      it->second = entry.second;
+    } else {
+      object.insert(it, entry);
+    }
+  }
+}
+
+void printTime(const std::string &name,
+               const double time) {
+  std::cout << std::setw(32) << name
+            << (1e6 * time) << '\n';
+}
+
+int main(const int argc, const char **argv) {
+  const int iterations = (argc > 1) ? std::atoi(argv[1]) : 20;
+  const int repeats = 1000;
+
+  std::cout << std::left
+            << std::setw(32) << "Operation"
+            << "Time (us)\n";
+
+  for (const int defineCount : {4, 64}) {
+    std::cout << "\n[ " << defineCount << " defines ]\n";
+
+    // Stored props are assigned once, like the device props
+    occa::json props;
+    props = getProps(defineCount);
+    const std::string source = props.dump(0);
+
+    printTime("parse", benchmark(iterations, repeats, [&]() {
+      occa::json::parse(source);
+    }));
+
+    int found = 0;
+    printTime("get (x4)", benchmark(iterations, repeats, [&]() {
+      found += props.get<bool>("okl/validate");
+      found += props.get<bool>("okl/missing", false);
+      found += props.get<std::string>("compiler_flags").size();
+      found += props.get<int>("defines/DEFINE_3");
+    }));
+
+    printTime("copy", benchmark(iterations, repeats, [&]() {
+      occa::json copy = props;
+    }));
+
+    // Props written through operator[] hand out references,
+    //   so copies of them can't share until they are assigned again
+    occa::json referencedProps = getProps(defineCount);
+    printTime("copy (referenced)", benchmark(iterations, repeats, [&]() {
+      occa::json copy = referencedProps;
+    }));
+
+    const occa::json kernelProps = getProps(4);
+    printTime("merge", benchmark(iterations, repeats, [&]() {
+      occa::json merged = props;
+      merged += kernelProps;
+    }));
+
+    printTime("hash (serialized)", benchmark(iterations, repeats, [&]() {
+      std::string out;
+      props.dumpToString(out);
+      occa::hash(out);
+    }));
+
+    occa::json hashedProps = props;
+    printTime("hash (modified)", benchmark(iterations, repeats, [&]() {
+      hashedProps["kernel/verbose"] = !hashedProps.get<bool>("kernel/verbose");
+      hashedProps.hash();
+    }));
+
+    printTime("hash (cached)", benchmark(iterations, repeats, [&]() {
+      hashedProps.hash();
+    }));
+
+    // The same operations on the define entries stored as a flat vector
+    const occa::jsonObject &defines = props["defines"].object();
+    const occa::jsonObject &kernelDefines = kernelProps["defines"].object();
+    const flatObject flatDefines = getFlatObject(defines);
+    const flatObject flatKernelDefines = getFlatObject(kernelDefines);
+    const std::string key = "DEFINE_3";
+
+    printTime("map find", benchmark(iterations, repeats, [&]() {
+      found += (defines.find(key) != defines.end());
+    }));
+    printTime("flat find", benchmark(iterations, repeats, [&]() {
+      found += (findFlat(flatDefines, key) != flatDefines.end());
+    }));
+
+    printTime("map deep copy", benchmark(iterations, repeats, [&]() {
+      occa::jsonObject copy = defines;
+      found += copy.size();
+    }));
+    printTime("flat deep copy", benchmark(iterations, repeats, [&]() {
+      flatObject copy = flatDefines;
+      found += copy.size();
+    }));
+
+    printTime("map merge", benchmark(iterations, repeats, [&]() {
+      occa::jsonObject merged = defines;
+      for (const auto &entry : kernelDefines) {
+        merged[entry.first] = entry.second;
+      }
+      found += merged.size();
+    }));
+    printTime("flat merge", benchmark(iterations, repeats, [&]() {
+      flatObject merged = flatDefines;
+      mergeFlat(merged, flatKernelDefines);
+      found += merged.size();
+    }));
+
+    if (found < 0) {
+      std::cout << found << '\n';
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <occa/utils/hash.hpp>
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/sys.hpp>
+
+// Measures hashing throughput for the sizes OCCA usually hashes:
+//   small props/cache keys up to large generated kernel sources
+template <class hashFunction>
+double benchmark(const int iterations,
+                 hashFunction func) {
+  double minTime = -1;
+  for (int i = 0; i < iterations; ++i) {
+    const double start = occa::sys::currentTime();
+    func();
+    const double time = occa::sys::currentTime() - start;
+    if ((minTime < 0) || (time < minTime)) {
+      minTime = time;
+    }
+  }
+  return minTime;
+}
+
+int main(const int argc, const char **argv) {
+  const int iterations = (argc > 1) ? std::atoi(argv[1]) : 20;
+
+  std::cout << std::left
+            << std::setw(24) << "Input"
+            << std::setw(16) << "Time (us)"
+            << "MB/s\n";
+
+  const occa::udim_t sizes[] = {64, 1024, 64 * 1024, 16 * 1024 * 1024};
+  for (const occa::udim_t bytes : sizes) {
+    std::string data(bytes, '\0');
+    for (occa::udim_t i = 0; i < bytes; ++i) {
+      data[i] = (char) (i * 31);
+    }
+
+    // Repeat small inputs to get measurable times
+    const int repeats = (int) ((16 * 1024 * 1024) / bytes);
+    occa::hash_t hash;
+    const double time = benchmark(iterations, [&]() {
+      for (int r = 0; r < repeats; ++r) {
+        hash ^= occa::hash(data);
+      }
+    }) / repeats;
+
+    std::cout << std::setw(24) << (std::to_string(bytes) + " bytes")
+              << std::setw(16) << (1e6 * time)
+              << (bytes / (1e6 * time)) << '\n';
+  }
+
+  // hashFile on a generated source file
+  const std::string filename = occa::env::OCCA_CACHE_DIR + "benchmarks/hash/source.okl";
+  std::string source;
+  while (source.size() < (4 * 1024 * 1024)) {
+    source += "@kernel void foo(const int N, float *a) { for (int i = 0; i < N; ++i; @tile(16, @outer, @inner)) { a[i] += 1; } }\n";
+  }
+  occa::io::write(filename, source);
+
+  const double fileTime = benchmark(iterations, [&]() {
+    occa::hashFile(filename);
+  });
+  std::cout << std::setw(24) << "hashFile (4 MB)"
+            << std::setw(16) << (1e6 * fileTime)
+            << (source.size() / (1e6 * fileTime)) << '\n';
+
+  return 0;
+}
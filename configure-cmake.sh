@@ -22,6 +22,7 @@
 : ${ENABLE_FORTRAN="OFF"}
 : ${ENABLE_TESTS="ON"}
 : ${ENABLE_EXAMPLES="ON"}
+: ${ENABLE_BENCHMARKS="OFF"}
 
 cmake -S . -B ${BUILD_DIR} \
   -DCMAKE_BUILD_TYPE=${BUILD_TYPE} \
@@ -40,4 +41,5 @@ cmake -S . -B ${BUILD_DIR} \
   -DENABLE_METAL=${ENABLE_METAL} \
   -DENABLE_FORTRAN=${ENABLE_FORTRAN} \
   -DENABLE_TESTS=${ENABLE_TESTS} \
-  -DENABLE_EXAMPLES=${ENABLE_EXAMPLES}
+  -DENABLE_EXAMPLES=${ENABLE_EXAMPLES} \
+  -DENABLE_BENCHMARKS=${ENABLE_BENCHMARKS}
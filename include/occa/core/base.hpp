@@ -116,6 +116,18 @@ namespace occa {
   occa::memory wrapMemory<void>(const void *ptr,
                                 const dim_t entries,
                                 const occa::json &props);
+
+  occa::memory mmapFile(const std::string &filename,
+                        const dtype_t &dtype,
+                        const occa::json &props);
+
+  template <class T = void>
+  occa::memory mmapFile(const std::string &filename,
+                        const occa::json &props = occa::json());
+
+  template <>
+  occa::memory mmapFile<void>(const std::string &filename,
+                              const occa::json &props);
   //====================================
 
   //---[ Free Functions ]---------------
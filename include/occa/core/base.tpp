@@ -13,6 +13,12 @@ namespace occa {
     return getDevice().wrapMemory(ptr, entries, occa::dtype::get<T>(), props);
   }
 
+  template <class T>
+  occa::memory mmapFile(const std::string &filename,
+                        const occa::json &props) {
+    return getDevice().mmapFile(filename, occa::dtype::get<T>(), props);
+  }
+
   template<typename T>
   void* unwrap(T& occaType) {
     return occaType.unwrap();
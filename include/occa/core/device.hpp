@@ -346,6 +346,27 @@ namespace occa {
      */
     udim_t maxMemoryAllocated() const;
 
+    /**
+     * @startDoc{allocationSnapshot}
+     *
+     * Description:
+     *   Reports live allocations when the device was created with `track_allocations: true`.
+     *   Allocations from [[device.malloc]] and [[memoryPool.reserve]] are grouped by power-of-2 size classes
+     *   and by the `tag` property passed to `malloc` or `createMemoryPool`.
+     *   Memory pool resizes are listed to show why pools grew.
+     *
+     *   With `track_allocation_backtraces: true`, each live allocation also includes where it was made.
+     *   Allocations still alive when the device is freed are reported as leaks.
+     *
+     * Returns:
+     *   A [[json]] object with the keys:
+     *   `enabled`, `bytes`, `peak_bytes`, `allocations`, `total_allocations`,
+     *   `size_classes`, `tags`, `live`, and `pool_resizes`
+     *
+     * @endDoc
+     */
+    occa::json allocationSnapshot() const;
+
     /**
      * @startDoc{finish}
      *
@@ -585,6 +606,56 @@ namespace occa {
     occa::kernel buildKernelFromBinary(const std::string &filename,
                                        const std::string &kernelName,
                                        const occa::json &props = occa::json()) const;
+
+    /**
+     * @startDoc{buildFusedKernel}
+     *
+     * Description:
+     *   Builds one kernel running the `@outer`/`@inner` loop bodies of several OKL kernels
+     *   back-to-back, avoiding a pass over memory per kernel.
+     *
+     *   Kernels need to be a single nest of `@outer` and `@inner` loops with the same bounds.
+     *   Kernel sources are fused by the OKL parser and the fused kernel is cached like any other kernel.
+     *
+     *   The kernels' source files are parsed as one source, in the order they first appear.
+     *   Helper functions with the same name in different files fail to build, as do macros which
+     *   the files define differently. Macros defined by a file stay defined in the files after it.
+     *
+     * Arguments:
+     *   kernels:
+     *     Built OKL kernels, in the order they should run
+     *   dataflow:
+     *     Describes how the kernel arguments connect:
+     *
+     *     ```js
+     *     {
+     *       name: 'scaleAxpy',
+     *       arguments: [
+     *         { y: 'tmp' },  // scale(N, alpha, x, y)
+     *         { x: 'tmp' },  // axpy(N, alpha, x, y)
+     *       ],
+     *       intermediates: ['tmp'],
+     *     }
+     *     ```
+     *
+     *     - `name`: Name of the fused kernel
+     *     - `arguments`: Renames each kernel's arguments, arguments with the same name are shared
+     *     - `intermediates`: Arguments only passed between kernels, which are kept in registers
+     *       rather than loaded and stored
+     *
+     *     The fused kernel takes the remaining arguments in the order they first appear.
+     *   props:
+     *     Backend-specific [[properties|json]] on how to compile the kernel, merged with the
+     *     first kernel's properties
+     *
+     * Returns:
+     *   The compiled [[kernel]].
+     *
+     * @endDoc
+     */
+    occa::kernel buildFusedKernel(const std::vector<occa::kernel> &kernels,
+                                  const occa::json &dataflow,
+                                  const occa::json &props = occa::json()) const;
     //  |===============================
 
     //  |---[ Memory ]------------------
@@ -715,6 +786,51 @@ namespace occa {
                             const dtype_t &dtype,
                             const occa::json &props = occa::json());
 
+    /**
+     * @startDoc{mmapFile}
+     *
+     * Description:
+     *   Maps a file into a [[memory]] object without reading it, pages are loaded as they are accessed.
+     *   This lets kernels stream datasets larger than the host memory.
+     *   Only supported in host modes, such as `Serial` and `OpenMP`.
+     *
+     *   > Note that writing to a read-only mapping is undefined behavior.
+     *
+     * Arguments:
+     *   filename:
+     *     Path to the file, which is mapped in its entirety.
+     *
+     *   props:
+     *     Backend-specific [[json]] properties for the mapping:
+     *
+     *     - `read_only`: Defaults to `true`. Otherwise writes are stored back in the file.
+     *     - `access`: One of `"normal"`, `"sequential"`, or `"random"` which hints at how pages are read (`madvise`).
+     *     - `prefetch`: Defaults to `false`. Starts reading the whole file in the background.
+     *
+     * Overloaded Description:
+     *   Uses the templated type to determine the type, the file size must be a multiple of its bytes.
+     *
+     * Returns:
+     *   The mapped [[memory]]
+     *
+     * @endDoc
+     */
+    template <class T = void>
+    occa::memory mmapFile(const std::string &filename,
+                          const occa::json &props = occa::json());
+
+    /**
+     * @startDoc{mmapFile}
+     *
+     * Overloaded Description:
+     *   Same but the file holds entries of [[dtype_t]].
+     *
+     * @endDoc
+     */
+    occa::memory mmapFile(const std::string &filename,
+                          const dtype_t &dtype,
+                          const occa::json &props);
+
     //  |---[ MemoryPool ]------------------
     /**
      * @startDoc{createMemoryPool}
@@ -729,6 +845,45 @@ namespace occa {
      */
     experimental::memoryPool createMemoryPool(const occa::json &props = occa::json());
 
+    //  |---[ Staging ]-----------------
+    /**
+     * @startDoc{reserveStagingBuffer}
+     *
+     * Description:
+     *   Reserves host memory meant for staging transfers to and from the device.
+     *   Staging buffers are page-locked when the backend supports it (`CUDA`, `HIP`) and regular aligned memory otherwise.
+     *
+     *   Buffers come from a ring owned by the device which is reused once they are released, avoiding an allocation for each transfer.
+     *   Buffers can be released in any order, but the ring space is only reused after the oldest buffers are released.
+     *
+     * Returns:
+     *   A host pointer with at least `bytes` bytes, valid until [[device.releaseStagingBuffer]] is called
+     *
+     * @endDoc
+     */
+    void* reserveStagingBuffer(const udim_t bytes);
+
+    /**
+     * @startDoc{releaseStagingBuffer}
+     *
+     * Description:
+     *   Returns a buffer from [[device.reserveStagingBuffer]] to the device.
+     *   Async transfers using the buffer must be finished before releasing it.
+     *
+     * @endDoc
+     */
+    void releaseStagingBuffer(void *ptr);
+
+    /**
+     * @startDoc{stagingBytesReserved}
+     *
+     * Description:
+     *   Bytes in staging buffers which haven't been released
+     *
+     * @endDoc
+     */
+    udim_t stagingBytesReserved() const;
+
     //  |===============================
 
     /**
@@ -768,6 +923,10 @@ namespace occa {
   template <>
   occa::memory device::malloc<void>(const dim_t entries,
                                     const occa::json &props);
+
+  template <>
+  occa::memory device::mmapFile<void>(const std::string &filename,
+                                      const occa::json &props);
 }
 
 #include "device.tpp"
@@ -30,4 +30,10 @@ namespace occa {
                                   const occa::json &props) {
     return wrapMemory(ptr, entries, occa::dtype::get<T>(), props);
   }
+
+  template <class T>
+  occa::memory device::mmapFile(const std::string &filename,
+                                const occa::json &props) {
+    return mmapFile(filename, occa::dtype::get<T>(), props);
+  }
 }
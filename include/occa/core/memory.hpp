@@ -323,6 +323,9 @@ namespace occa {
      *     Any backend-specific properties for memory transfer.
      *     For example, `async: true`.
      *
+     *     Setting `host_dtype` (`"double"`, `"float"`, or `"half"`) converts the values
+     *     while copying, `bytes` and `offset` still refer to the [[memory]] object.
+     *
      * @endDoc
      */
     void copyFrom(const void *src,
@@ -383,6 +386,9 @@ namespace occa {
      *     Any backend-specific properties for memory transfer.
      *     For example, `async: true`.
      *
+     *     Setting `host_dtype` (`"double"`, `"float"`, or `"half"`) converts the values
+     *     while copying, `bytes` and `offset` still refer to the [[memory]] object.
+     *
      * @endDoc
      */
     void copyTo(void *dest,
@@ -448,6 +454,37 @@ namespace occa {
      */
     occa::memory clone() const;
 
+    /**
+     * @startDoc{layoutDefines}
+     *
+     * Description:
+     *   Returns kernel `defines` with field accessors for memory holding a struct [[dtype_t]].
+     *
+     *   Memory of struct types can be stored as arrays of structs (default),
+     *   one array per field (`layout: "soa"`), or blocks of `layout_width` entries
+     *   stored as arrays per field (`layout: "aosoa"`).
+     *   The accessors hide how the memory is stored so kernels don't depend on the layout.
+     *
+     *   For a `particles` argument with fields `x` and `v[3]`:
+     *
+     *   ```cpp
+     *   props["defines"] += mem.layoutDefines("particles");
+     *   ```
+     *
+     *   defines `particles_x(index)` and `particles_v(index, component)` which can be read and assigned.
+     *
+     * Arguments:
+     *   name:
+     *     Name of the kernel argument holding the memory
+     *   isConst:
+     *     Set for `const` kernel arguments, the accessors then read through `const` pointers
+     *     and can't be assigned
+     *
+     * @endDoc
+     */
+    occa::json layoutDefines(const std::string &name,
+                             const bool isConst = false) const;
+
     /**
      * @startDoc{free}
      *
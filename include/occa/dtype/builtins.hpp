@@ -24,6 +24,8 @@ namespace occa {
     extern const dtype_t long_;
     extern const dtype_t float_;
     extern const dtype_t double_;
+    // IEEE 754 binary16, only used to store values
+    extern const dtype_t half;
 
     extern const dtype_t int8;
     extern const dtype_t uint8;
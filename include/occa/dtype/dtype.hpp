@@ -43,6 +43,7 @@ namespace occa {
     dtypeTuple_t *tuple_;
     dtypeStruct_t *struct_;
     mutable dtypeVector_t flatDtype;
+    mutable uint64_t signature_;
 
   public:
     dtype_t();
@@ -238,6 +239,23 @@ namespace occa {
     static bool isCyclic(const dtypeVector_t &vec,
                          const int cycleLength);
 
+    /**
+     * @startDoc{signature}
+     *
+     * Description:
+     *   Compact form of the flattened type, computed once per type.
+     *   The upper 32 bits identify the shortest repeating sequence of flattened types
+     *   and the lower 32 bits hold the number of flattened types.
+     *
+     *   [[dtype_t.canBeCastedTo]] compares signatures instead of flattened types.
+     *
+     * @endDoc
+     */
+    uint64_t signature() const;
+
+    static bool canBeCasted(const uint64_t fromSignature,
+                            const uint64_t toSignature);
+
     static dtype_t tuple(const dtype_t &dtype,
                          const int size,
                          const bool registered_ = false);
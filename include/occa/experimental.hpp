@@ -2,5 +2,6 @@
 #define OCCA_EXPERIMENTAL_HEADER
 
 #include <occa/experimental/kernelBuilder.hpp>
+#include <occa/experimental/kernelTuner.hpp>
 
 #endif
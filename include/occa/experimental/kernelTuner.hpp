@@ -0,0 +1,77 @@
+#ifndef OCCA_EXPERIMENTAL_CORE_KERNELTUNER_HEADER
+#define OCCA_EXPERIMENTAL_CORE_KERNELTUNER_HEADER
+
+#include <functional>
+#include <vector>
+
+#include <occa/core/device.hpp>
+#include <occa/core/kernel.hpp>
+#include <occa/types/json.hpp>
+
+namespace occa {
+  // Picks the fastest values for tunable kernel defines, such as the
+  //   sizes given to @tile or @max_inner_dims:
+  //
+  //   occa::kernelTuner tuner(device, "addVectors.okl", "addVectors");
+  //   tuner.addCandidates("TILE_SIZE", {16, 64, 256});
+  //
+  //   occa::kernel addVectors = tuner.getKernel(entries, [&](occa::kernel kernel) {
+  //     kernel(entries, o_a, o_b, o_ab);
+  //   });
+  //
+  // Each candidate is timed with stream tags through the run callback.
+  //   The winner is stored in the OCCA cache by device, kernel source,
+  //   properties and problem size class, so later runs skip tuning.
+  //
+  // Properties:
+  //   - tuner/iterations: Timed runs per candidate, default 3
+  class kernelTuner {
+  public:
+    typedef std::function<void (occa::kernel kernel)> runFunction_t;
+
+  private:
+    occa::device device;
+    std::string filename;
+    std::string kernelName;
+    occa::json props;
+    occa::json candidates;
+    hashedKernelMap kernelMap;
+
+  public:
+    kernelTuner(occa::device device_,
+                const std::string &filename_,
+                const std::string &kernelName_,
+                const occa::json &props_ = occa::json());
+
+    void addCandidates(const std::string &define,
+                       const std::vector<occa::json> &values);
+
+    // Returns the variant tuned for [problemSize], tuning it first if needed
+    occa::kernel getKernel(const udim_t problemSize,
+                           runFunction_t run);
+
+    // Returns the tuned defines for [problemSize], tuning them first if needed
+    occa::json getDefines(const udim_t problemSize,
+                          runFunction_t run);
+
+    // Problem sizes are grouped by the next power of 2
+    static int getSizeClass(const udim_t problemSize);
+
+    std::string getResultsFilename() const;
+
+    void free();
+
+  private:
+    occa::kernel buildVariant(const occa::json &defines);
+
+    occa::json tune(runFunction_t run);
+
+    double timeVariant(const occa::json &defines,
+                       runFunction_t run,
+                       const int iterations);
+
+    std::vector<occa::json> getCandidateDefines() const;
+  };
+}
+
+#endif
@@ -21,6 +21,7 @@ namespace occa {
 
     // Buffer memory
     mutable occa::memory returnMemory;
+    mutable int returnMemoryEntries;
 
     template <class ReturnType>
     void setupReturnMemory(const ReturnType &value) const {
@@ -32,9 +33,13 @@ namespace occa {
     void setupReturnMemoryArray(const int size) const {
       size_t bytes = sizeof(ReturnType) * size;
       if (bytes > returnMemory.size()) {
-        returnMemory = device_.template malloc<ReturnType>(size);
+        // Grow geometrically so reductions of different sizes reuse the buffer
+        returnMemory = device_.template malloc<void>(
+          std::max(bytes, (size_t) (2 * returnMemory.size()))
+        );
       }
       returnMemory.setDtype(dtype::get<ReturnType>());
+      returnMemoryEntries = size;
     }
 
     template <class ReturnType>
@@ -332,13 +337,15 @@ namespace occa {
   public:
     typelessArray() :
       tileSize(-1),
-      tileIterations(-1) {}
+      tileIterations(-1),
+      returnMemoryEntries(0) {}
 
     typelessArray(const typelessArray &other) :
       device_(other.device_),
       dtype_(other.dtype_),
       tileSize(other.tileSize),
-      tileIterations(other.tileIterations) {}
+      tileIterations(other.tileIterations),
+      returnMemoryEntries(0) {}
 
     typelessArray& operator = (const typelessArray &other) {
       device_ = other.device_;
@@ -596,7 +603,11 @@ namespace occa {
 
     template <class T2>
     T2 finishReturnMemoryReduction(reductionType type) const {
-      return functional::hostReduction<T2>(type, returnMemory);
+      // The buffer can be larger than the entries written by the last reduction
+      return functional::hostReduction<T2>(
+        type,
+        returnMemory.slice(0, returnMemoryEntries)
+      );
     }
     //==================================
   };
@@ -56,7 +56,8 @@ namespace occa {
     template <class T>
     T hostReduction(reductionType type, occa::memory mem) {
       const int entryCount = (int) mem.length();
-      T *values = new T[entryCount];
+      occa::device device = mem.getDevice();
+      T *values = (T*) device.reserveStagingBuffer(entryCount * sizeof(T));
       mem.copyTo(values);
 
       T reductionValue = values[0];
@@ -110,7 +111,7 @@ namespace occa {
           break;
       }
 
-      delete [] values;
+      device.releaseStagingBuffer(values);
 
       return reductionValue;
     }
@@ -2,6 +2,7 @@
 #define OCCA_UTILS_JSON_HEADER
 
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <occa/dtype/builtins.hpp>
@@ -11,7 +12,10 @@
 namespace occa {
   class json;
   class jsonKeyValue;
+  class jsonObjectData_t;
 
+  // Stays a std::map since object() and operator[] hand out references
+  //   to entries which have to survive inserts of their siblings
   typedef std::map<std::string, json> jsonObject;
   typedef std::vector<json>           jsonArray;
   typedef std::initializer_list<jsonKeyValue> jsonInitializerList;
@@ -23,7 +27,8 @@ namespace occa {
     primitive number;
     std::string string;
     jsonArray array;
-    jsonObject object;
+    // Objects are shared between copies until one of them is modified
+    std::shared_ptr<jsonObjectData_t> object;
   } jsonValue_t;
 
   /**
@@ -146,9 +151,7 @@ namespace occa {
       type = type_;
     }
 
-    inline json(const json &j) :
-      type(j.type),
-      value_(j.value_) {}
+    json(const json &j);
 
     inline json(const bool value) :
       type(number_) {
@@ -225,10 +228,7 @@ namespace occa {
       value_.string = value.getFullString();
     }
 
-    inline json(const jsonObject &value) :
-      type(object_) {
-      value_.object = value;
-    }
+    json(const jsonObject &value);
 
     inline json(const jsonArray &value) :
       type(array_) {
@@ -338,7 +338,7 @@ namespace occa {
 
     inline json& operator = (const jsonObject &value) {
       type = object_;
-      value_.object = value;
+      setObject(value);
       return *this;
     }
 
@@ -645,7 +645,7 @@ namespace occa {
     }
 
     inline jsonObject& object() {
-      return value_.object;
+      return leakObject();
     }
 
     inline bool boolean() const {
@@ -664,9 +664,7 @@ namespace occa {
       return value_.array;
     }
 
-    inline const jsonObject& object() const {
-      return value_.object;
-    }
+    const jsonObject& object() const;
 
     json& operator [] (const char *c);
     const json& operator [] (const char *c) const;
@@ -741,7 +739,9 @@ namespace occa {
     json& set(const std::string &key,
               const T &value);
 
-    json getPathValue(const char *key) const;
+    // Returns the value at the `/`-delimited path without copying it,
+    //   or an uninitialized json if the path doesn't exist
+    const json& getPathValue(const char *key) const;
 
     /**
      * @startDoc{get[0]}
@@ -837,7 +837,8 @@ namespace occa {
       case string_:
         return value_.string == j.value_.string;
       case object_:
-        return value_.object == j.value_.object;
+        return ((value_.object == j.value_.object)
+                || (object() == j.object()));
       case array_:
         return value_.array == j.value_.array;
       default:
@@ -944,12 +945,29 @@ namespace occa {
       return toString();
     }
 
+    // Hashes the JSON structure directly without serializing it
+    // Objects cache their hash until they're modified, so hashing
+    //   again only rehashes the objects that changed
     hash_t hash() const;
 
     std::string toString() const;
 
     friend std::ostream& operator << (std::ostream &out,
                                       const json &j);
+
+  private:
+    void hashValue(hasher_t &hasher) const;
+    void hashChild(hasher_t &hasher) const;
+
+    static const jsonObject& emptyObject();
+
+    // Makes sure we're the only owner of the object before writing
+    jsonObject& writeObject();
+    // References handed out to entries in our object (e.g. through
+    //   operator []) can modify it at any time, so it's never shared
+    //   with copies again
+    jsonObject& leakObject();
+    void setObject(const jsonObject &obj);
   };
 
   class jsonKeyValue {
@@ -3,7 +3,7 @@ namespace occa {
   json& json::set(const char *key,
                   const T &value) {
     type = object_;
-    value_.object[key] = value;
+    writeObject()[key] = value;
     return *this;
   }
 
@@ -16,7 +16,7 @@ namespace occa {
   template <class T>
   T json::get(const char *key,
                const T &default_) const {
-    const json value = getPathValue(key);
+    const json &value = getPathValue(key);
     if (value.isInitialized()) {
       return (T) value;
     }
@@ -1,6 +1,7 @@
 #ifndef OCCA_UTILS_HEADER
 #define OCCA_UTILS_HEADER
 
+#include <occa/utils/atomic.hpp>
 #include <occa/utils/env.hpp>
 #include <occa/utils/exception.hpp>
 #include <occa/utils/hash.hpp>
@@ -0,0 +1,75 @@
+#ifndef OCCA_UTILS_ATOMIC_HEADER
+#define OCCA_UTILS_ATOMIC_HEADER
+
+#include <occa/defines.hpp>
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define OCCA_HAS_ATOMIC_BUILTINS 1
+#else
+#  define OCCA_HAS_ATOMIC_BUILTINS 0
+#endif
+
+namespace occa {
+  namespace atomics {
+    //---[ Striped Locks ]--------------
+    // Spin lock picked by hashing an address into a fixed table of locks.
+    // Used by the OpenMP @atomic code which has no lock-free equivalent,
+    //   so only updates to addresses sharing a stripe contend
+    class stripeLock {
+    private:
+      int stripe;
+
+    public:
+      stripeLock(const void *ptr);
+      ~stripeLock();
+
+      stripeLock(const stripeLock &other) = delete;
+      stripeLock& operator = (const stripeLock &other) = delete;
+
+      static int getStripe(const void *ptr);
+    };
+    //==================================
+
+    //---[ Min / Max ]------------------
+    // Lock-free through compare-and-swap loops when the compiler
+    //   supports the __atomic builtins, striped locks otherwise
+    template <class TM, class TV>
+    inline void min(TM *ptr, const TV &value_) {
+      TM value = (TM) value_;
+#if OCCA_HAS_ATOMIC_BUILTINS
+      TM current;
+      __atomic_load(ptr, &current, __ATOMIC_RELAXED);
+      while ((value < current)
+             && !__atomic_compare_exchange(ptr, &current, &value,
+                                           true,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+#else
+      stripeLock lock(ptr);
+      if (value < *ptr) {
+        *ptr = value;
+      }
+#endif
+    }
+
+    template <class TM, class TV>
+    inline void max(TM *ptr, const TV &value_) {
+      TM value = (TM) value_;
+#if OCCA_HAS_ATOMIC_BUILTINS
+      TM current;
+      __atomic_load(ptr, &current, __ATOMIC_RELAXED);
+      while ((current < value)
+             && !__atomic_compare_exchange(ptr, &current, &value,
+                                           true,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+#else
+      stripeLock lock(ptr);
+      if (*ptr < value) {
+        *ptr = value;
+      }
+#endif
+    }
+    //==================================
+  }
+}
+
+#endif
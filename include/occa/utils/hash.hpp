@@ -18,7 +18,7 @@ namespace occa {
    *   An object used to represent a hash value.
    *   It's intent isn't for security purposes, but rather to distinguish "things".
    *
-   *   > It currently uses FNV hashing since it's quick, but it can be changed if something more useful shows up.
+   *   > It currently uses a 256-bit multiply-rotate hash that processes 4 words at a time, see [[hasher_t]].
    *
    * @endDoc
    */
@@ -168,6 +168,52 @@ namespace occa {
   std::ostream& operator << (std::ostream &out,
                            const hash_t &hash);
 
+  /**
+   * @startDoc{hasher_t}
+   *
+   * Description:
+   *   Incrementally builds a [[hash_t]] from data passed in pieces,
+   *   giving the same result as hashing the concatenated data at once.
+   *
+   *   Data is consumed in 32-byte stripes split across 4 independent 64-bit lanes.
+   *
+   * @endDoc
+   */
+  class hasher_t {
+  private:
+    uint64_t lanes[4];
+    unsigned char buffer[32];
+    int bufferBytes;
+    udim_t totalBytes;
+
+  public:
+    hasher_t();
+
+    void clear();
+
+    /**
+     * @startDoc{update}
+     *
+     * Description:
+     *   Append data to the hash
+     *
+     * @endDoc
+     */
+    void update(const void *ptr, udim_t bytes);
+    void update(const std::string &str);
+
+    /**
+     * @startDoc{digest}
+     *
+     * Description:
+     *   Return the hash of all data passed so far.
+     *   More data can still be appended afterwards.
+     *
+     * @endDoc
+     */
+    hash_t digest() const;
+  };
+
   hash_t hash(const void *ptr, udim_t bytes);
 
   template <class T>
@@ -134,6 +134,18 @@ namespace occa {
     return getDevice().wrapMemory(ptr, entries, dtype::byte, props);
   }
 
+  occa::memory mmapFile(const std::string &filename,
+                        const dtype_t &dtype,
+                        const occa::json &props) {
+    return getDevice().mmapFile(filename, dtype, props);
+  }
+
+  template <>
+  occa::memory mmapFile<void>(const std::string &filename,
+                              const occa::json &props) {
+    return getDevice().mmapFile(filename, dtype::byte, props);
+  }
+
   void memcpy(memory dest, const void *src,
               const dim_t bytes,
               const dim_t offset,
@@ -1,15 +1,58 @@
+#include <algorithm>
+#include <cctype>
+#include <map>
+
 #include <occa/core/device.hpp>
 #include <occa/core/base.hpp>
 #include <occa/internal/core/device.hpp>
 #include <occa/internal/core/kernel.hpp>
 #include <occa/internal/core/memory.hpp>
+#include <occa/internal/core/memoryLayout.hpp>
 #include <occa/internal/core/memoryPool.hpp>
 #include <occa/internal/modes.hpp>
 #include <occa/internal/utils/sys.hpp>
 #include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/string.hpp>
 #include <occa/internal/io.hpp>
 
 namespace occa {
+  namespace {
+    // Macros #define'd directly in [source] with their definitions,
+    //   macros from #include'd files are left out
+    std::map<std::string, std::string> getSourceDefines(const std::string &source) {
+      std::map<std::string, std::string> defines;
+
+      const strVector lines = split(source, '\n');
+      const int lineCount = (int) lines.size();
+      for (int i = 0; i < lineCount; ++i) {
+        std::string line = strip(lines[i]);
+        if (!startsWith(line, "#")) {
+          continue;
+        }
+        line = stripLeft(line.substr(1));
+        if (!startsWith(line, "define") || (line.size() <= 6) || !isspace(line[6])) {
+          continue;
+        }
+
+        while (endsWith(line, "\\") && ((i + 1) < lineCount)) {
+          line = line.substr(0, line.size() - 1) + ' ' + strip(lines[++i]);
+        }
+        line = stripLeft(line.substr(6));
+
+        size_t nameEnd = 0;
+        while ((nameEnd < line.size())
+               && (isalnum(line[nameEnd]) || (line[nameEnd] == '_'))) {
+          ++nameEnd;
+        }
+        if (nameEnd) {
+          defines[line.substr(0, nameEnd)] = strip(line.substr(nameEnd));
+        }
+      }
+
+      return defines;
+    }
+  }
+
   //---[ Utils ]------------------------
   occa::json getModeSpecificProps(const std::string &mode,
                                   const occa::json &props) {
@@ -156,6 +199,11 @@ namespace occa {
 
   void device::free() {
     if (modeDevice) {
+      const std::string leakReport = modeDevice->allocationTracker.leakReport();
+      if (leakReport.size()) {
+        io::stderr << leakReport;
+      }
+
       modeDevice->freeResources();
 
       // ~modeDevice_t NULLs all wrappers
@@ -240,6 +288,13 @@ namespace occa {
     return 0;
   }
 
+  occa::json device::allocationSnapshot() const {
+    if (modeDevice) {
+      return modeDevice->allocationTracker.snapshot();
+    }
+    return occa::json();
+  }
+
   void device::finish() {
     if (modeDevice) {
       modeDevice->finish();
@@ -306,10 +361,13 @@ namespace occa {
 
     kernelProps = kernelProperties(props);
 
+    // Specialized argument values and fused kernels are folded into the kernel source
     kernelHash = (
       hash()
       ^ modeDevice->kernelHash(kernelProps)
       ^ kernelHeaderHash(kernelProps)
+      ^ occa::hash(kernelProps.getPathValue("okl/specialize"))
+      ^ occa::hash(kernelProps.getPathValue("okl/fusion"))
       ^ sourceHash
     );
 
@@ -388,6 +446,7 @@ namespace occa {
 
     if (cachedKernel.isInitialized()) {
       cachedKernel.modeKernel->hash = kernelHash;
+      cachedKernel.modeKernel->originalFilename = realFilename;
     } else {
       sys::rmrf(hashDir);
     }
@@ -431,6 +490,100 @@ namespace occa {
                                                     kernelName,
                                                     props));
   }
+
+  kernel device::buildFusedKernel(const std::vector<occa::kernel> &kernels,
+                                  const occa::json &dataflow,
+                                  const occa::json &props) const {
+    assertInitialized();
+
+    OCCA_ERROR("No kernels given to fuse",
+               kernels.size() > 0);
+
+    const std::string name = dataflow.get<std::string>("name");
+    OCCA_ERROR("Fused kernel needs a [name]",
+               name.size() > 0);
+
+    const occa::json &arguments = dataflow["arguments"];
+    OCCA_ERROR("Fused kernel [arguments] needs one entry per kernel",
+               !arguments.isInitialized()
+               || (arguments.isArray() && (arguments.array().size() == kernels.size())));
+
+    const occa::json &defines = kernels[0].properties().getPathValue("defines");
+
+    occa::json fusion;
+    fusion["name"] = name;
+    fusion["stages"].asArray();
+    fusion["intermediates"] = dataflow.get<occa::json>("intermediates",
+                                                       occa::json(occa::json::array_));
+
+    std::string source;
+    strVector filenames;
+    // Macro -> file defining it, sources are preprocessed as one file
+    //   so macros stay defined in the files after them
+    std::map<std::string, std::string> defineFilenames;
+    std::map<std::string, std::string> sourceDefines;
+    occa::json includePaths = kernels[0].properties().get<occa::json>(
+      "okl/include_paths",
+      occa::json(occa::json::array_)
+    );
+    for (size_t i = 0; i < kernels.size(); ++i) {
+      modeKernel_t *modeKernel = kernels[i].getModeKernel();
+      OCCA_ERROR("Kernel " << i << " is not initialized",
+                 modeKernel != NULL);
+      OCCA_ERROR("Kernel [" << modeKernel->name << "] was not built from OKL source",
+                 modeKernel->properties.get("okl/enabled", true)
+                 && modeKernel->originalFilename.size());
+      OCCA_ERROR("Kernel [" << modeKernel->name << "] is from a different device",
+                 modeKernel->modeDevice == modeDevice);
+      // Sources are parsed together so their defines have to agree
+      OCCA_ERROR("Kernel [" << modeKernel->name << "] has different [defines] than ["
+                 << kernels[0].getModeKernel()->name << "]",
+                 modeKernel->properties.getPathValue("defines") == defines);
+
+      occa::json stage;
+      stage["kernel"] = modeKernel->name;
+      stage["arguments"] = (
+        arguments.isInitialized()
+        ? arguments[(int) i]
+        : occa::json(occa::json::object_)
+      );
+      fusion["stages"] += stage;
+
+      // Kernels from the same file share its source
+      const std::string &filename = modeKernel->originalFilename;
+      if (std::find(filenames.begin(), filenames.end(), filename) != filenames.end()) {
+        continue;
+      }
+      filenames.push_back(filename);
+
+      const std::string fileSource = io::read(filename);
+      for (const auto &it : getSourceDefines(fileSource)) {
+        const std::string &macro = it.first;
+        std::map<std::string, std::string>::const_iterator defineIt = sourceDefines.find(macro);
+        if (defineIt == sourceDefines.end()) {
+          sourceDefines[macro] = it.second;
+          defineFilenames[macro] = filename;
+          continue;
+        }
+        OCCA_ERROR("Kernel [" << modeKernel->name << "] can't be fused, [" << filename
+                   << "] and [" << defineFilenames[macro] << "] define the macro ["
+                   << macro << "] differently",
+                   defineIt->second == it.second);
+      }
+
+      source += fileSource;
+      source += '\n';
+      // Keep relative #include paths working from the fused source
+      includePaths += io::dirname(filename);
+    }
+
+    occa::json fusedProps = kernels[0].properties();
+    fusedProps += props;
+    fusedProps["okl/fusion"] = fusion;
+    fusedProps["okl/include_paths"] = includePaths;
+
+    return buildKernelFromString(source, name, fusedProps);
+  }
   //  |=================================
 
   //  |---[ Memory ]--------------------
@@ -450,14 +603,34 @@ namespace occa {
 
     occa::json memProps = memoryProperties(props);
 
-    memory mem(modeDevice->malloc(bytes, src, memProps));
+    // Entries are transposed from the host AoS layout after allocating
+    memoryLayout_t *layout = NULL;
+    if (memoryLayout_t::isRequested(memProps)) {
+      layout = new memoryLayout_t(dtype, entries, memProps);
+      memProps["use_host_pointer"] = false;
+    }
+    const udim_t allocatedBytes = layout ? layout->bytes() : bytes;
+
+    memory mem(modeDevice->malloc(allocatedBytes,
+                                  layout ? NULL : src,
+                                  memProps));
     mem.setDtype(dtype);
+    if (layout) {
+      mem.getModeMemory()->layout = layout;
+    }
 
-    modeDevice->bytesAllocated += bytes;
+    modeDevice->bytesAllocated += allocatedBytes;
     modeDevice->maxBytesAllocated = std::max(
       modeDevice->maxBytesAllocated, modeDevice->bytesAllocated
     );
+    modeDevice->allocationTracker.add(mem.getModeMemory()->modeBuffer,
+                                      allocatedBytes,
+                                      "malloc",
+                                      memProps.get<std::string>("tag", ""));
 
+    if (layout && src) {
+      mem.copyFrom(src);
+    }
     return mem;
   }
 
@@ -524,6 +697,30 @@ namespace occa {
     return mem;
   }
 
+  template <>
+  occa::memory device::mmapFile<void>(const std::string &filename,
+                                      const occa::json &props) {
+    return mmapFile(filename, dtype::byte, props);
+  }
+
+  occa::memory device::mmapFile(const std::string &filename,
+                                const dtype_t &dtype,
+                                const occa::json &props) {
+    assertInitialized();
+
+    occa::json memProps = memoryProperties(props);
+
+    memory mem(modeDevice->mmapFile(filename, memProps));
+
+    OCCA_ERROR("File [" << filename << "] with " << mem.size() << " bytes"
+               << " does not hold a whole number of [" << dtype << "] entries",
+               (mem.size() % dtype.bytes()) == 0);
+
+    mem.setDtype(dtype);
+
+    return mem;
+  }
+
   memoryPool device::createMemoryPool(const occa::json &props) {
     assertInitialized();
 
@@ -535,6 +732,25 @@ namespace occa {
   }
   //  |=================================
 
+  //  |---[ Staging ]-------------------
+  void* device::reserveStagingBuffer(const udim_t bytes) {
+    assertInitialized();
+    return modeDevice->stagingRing.reserve(bytes);
+  }
+
+  void device::releaseStagingBuffer(void *ptr) {
+    assertInitialized();
+    modeDevice->stagingRing.release(ptr);
+  }
+
+  udim_t device::stagingBytesReserved() const {
+    if (modeDevice) {
+      return modeDevice->stagingRing.reservedBytes();
+    }
+    return 0;
+  }
+  //  |=================================
+
   void* device::unwrap() {
     assertInitialized();
     return modeDevice->unwrap();
@@ -176,6 +176,12 @@ namespace occa {
     }
 
     modeKernel->setupRun();
+
+    modeKernel_t *variantKernel = modeKernel->specializer.getVariant(*modeKernel);
+    if (variantKernel) {
+      variantKernel->run();
+      return;
+    }
     modeKernel->run();
   }
 
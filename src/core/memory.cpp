@@ -3,9 +3,101 @@
 #include <occa/core/device.hpp>
 #include <occa/internal/core/device.hpp>
 #include <occa/internal/core/memory.hpp>
+#include <occa/internal/core/memoryLayout.hpp>
 #include <occa/internal/utils/sys.hpp>
 
 namespace occa {
+  namespace {
+    // Bytes seen by the host, which always uses an AoS layout
+    udim_t hostBytes(const modeMemory_t *mem) {
+      if (mem->layout) {
+        return mem->layout->entries * mem->layout->structBytes;
+      }
+      return mem->size;
+    }
+
+    void getLayoutEntries(const memoryLayout_t &layout,
+                          const udim_t bytes,
+                          const udim_t offset,
+                          udim_t &firstEntry,
+                          udim_t &count) {
+      OCCA_ERROR("Host copies of memory with a ["
+                 << memoryLayout_t::typeToString(layout.type) << "] layout"
+                 << " must use whole entries of [" << layout.structBytes << "] bytes",
+                 ((bytes % layout.structBytes) == 0)
+                 && ((offset % layout.structBytes) == 0));
+      firstEntry = offset / layout.structBytes;
+      count = bytes / layout.structBytes;
+    }
+
+    void copyLayoutFrom(modeMemory_t *mem,
+                        const void *src,
+                        const udim_t bytes,
+                        const udim_t offset,
+                        const occa::json &props) {
+      udim_t firstEntry, count;
+      getLayoutEntries(*(mem->layout), bytes, offset, firstEntry, count);
+      mem->layout->copyFrom(mem, src, firstEntry, count, props);
+    }
+
+    void copyLayoutTo(void *dest,
+                      const modeMemory_t *mem,
+                      const udim_t bytes,
+                      const udim_t offset,
+                      const occa::json &props) {
+      udim_t firstEntry, count;
+      getLayoutEntries(*(mem->layout), bytes, offset, firstEntry, count);
+      mem->layout->copyTo(dest, mem, firstEntry, count, props);
+    }
+
+    // Returns dtype::none if the host uses the memory dtype
+    const dtype_t& getHostDtype(const modeMemory_t *mem,
+                                const occa::json &props) {
+      const std::string name = props.get<std::string>("host_dtype", "");
+      if (!name.size()) {
+        return dtype::none;
+      }
+      const dtype_t &hostDtype = dtype_t::getBuiltin(name);
+      OCCA_ERROR("Unknown host_dtype [" << name << "]",
+                 hostDtype != dtype::none);
+      return (hostDtype == *(mem->dtype_)) ? dtype::none : hostDtype;
+    }
+
+    dtypeConversion_t getHostConversion(const modeMemory_t *mem,
+                                        const dtype_t &destDtype,
+                                        const dtype_t &srcDtype,
+                                        const udim_t bytes,
+                                        const udim_t offset) {
+      const dtype_t &memDtype = *(mem->dtype_);
+
+      dtypeConversion_t conversion = getDtypeConversion(destDtype, srcDtype);
+      OCCA_ERROR("Unable to convert from [" << srcDtype << "] to [" << destDtype << "]",
+                 conversion != NULL);
+      OCCA_ERROR("Converted copies must use whole [" << memDtype << "] entries",
+                 ((bytes % memDtype.bytes()) == 0)
+                 && ((offset % memDtype.bytes()) == 0));
+      OCCA_ERROR("Converted copies are not supported for memory with a layout",
+                 !mem->layout);
+
+      return conversion;
+    }
+
+    // Device copies don't transpose, both sides need to be stored the same way
+    void assertSameLayout(const modeMemory_t *dest,
+                          const modeMemory_t *src,
+                          const udim_t bytes,
+                          const udim_t destOffset,
+                          const udim_t srcOffset) {
+      OCCA_ERROR("Copies between memory with layouts require both memory objects"
+                 " to have the same layout",
+                 dest->layout && src->layout
+                 && dest->layout->matches(*(src->layout)));
+      OCCA_ERROR("Copies between memory with layouts must copy the whole memory",
+                 (destOffset == 0) && (srcOffset == 0)
+                 && (bytes == hostBytes(dest)));
+    }
+  }
+
   memory::memory() :
       modeMemory(NULL) {}
 
@@ -121,6 +213,9 @@ namespace occa {
     assertInitialized();
     OCCA_ERROR("Memory dtype [" << dtype__.name() << "] must be registered",
                dtype__.isRegistered());
+    OCCA_ERROR("Cannot change the dtype of memory with a ["
+               << memoryLayout_t::typeToString(modeMemory->layout->type) << "] layout",
+               !modeMemory->layout || (*(modeMemory->layout->dtype) == dtype__));
     modeMemory->dtype_ = &(dtype__.self());
   }
 
@@ -142,6 +237,9 @@ namespace occa {
     if (modeMemory == NULL) {
       return 0;
     }
+    if (modeMemory->layout) {
+      return modeMemory->layout->entries;
+    }
     return modeMemory->size / modeMemory->dtype_->bytes();
   }
 
@@ -179,6 +277,10 @@ namespace occa {
                << offset_ << " + " << bytes << " > " << size() << ")",
                (offset_ + (dim_t) bytes) <= (dim_t) size());
 
+    OCCA_ERROR("Cannot slice memory with a ["
+               << memoryLayout_t::typeToString(modeMemory->layout->type) << "] layout",
+               !modeMemory->layout || ((offset == 0) && ((udim_t) bytes == size())));
+
     occa::memory m(modeMemory->slice(offset_, bytes));
     m.setDtype(dtype());
 
@@ -191,7 +293,7 @@ namespace occa {
                         const occa::json &props) {
     assertInitialized();
 
-    udim_t bytes_ = ((bytes == -1) ? modeMemory->size : bytes);
+    udim_t bytes_ = ((bytes == -1) ? hostBytes(modeMemory) : bytes);
 
     OCCA_ERROR("Trying to allocate negative bytes (" << bytes << ")",
                bytes >= -1);
@@ -199,9 +301,26 @@ namespace occa {
     OCCA_ERROR("Cannot have a negative offset (" << offset << ")",
                offset >= 0);
 
-    OCCA_ERROR("Destination memory has size [" << modeMemory->size << "],"
+    OCCA_ERROR("Destination memory has size [" << hostBytes(modeMemory) << "],"
                << " trying to access [" << offset << ", " << (offset + bytes_) << "]",
-               (bytes_ + offset) <= modeMemory->size);
+               (bytes_ + offset) <= hostBytes(modeMemory));
+
+    const dtype_t &hostDtype = getHostDtype(modeMemory, props);
+    if (hostDtype != dtype::none) {
+      const dtype_t &memDtype = *(modeMemory->dtype_);
+      dtypeConversion_t conversion = getHostConversion(
+        modeMemory, memDtype, hostDtype, bytes_, offset
+      );
+      modeMemory->convertFrom(src, hostDtype, conversion,
+                              bytes_ / memDtype.bytes(), offset,
+                              props);
+      return;
+    }
+
+    if (modeMemory->layout) {
+      copyLayoutFrom(modeMemory, src, bytes_, offset, props);
+      return;
+    }
 
     modeMemory->copyFrom(src, bytes_, offset, props);
   }
@@ -213,7 +332,7 @@ namespace occa {
                         const occa::json &props) {
     assertInitialized();
 
-    udim_t bytes_ = ((bytes == -1) ? modeMemory->size : bytes);
+    udim_t bytes_ = ((bytes == -1) ? hostBytes(modeMemory) : bytes);
 
     OCCA_ERROR("Trying to allocate negative bytes (" << bytes << ")",
                bytes >= -1);
@@ -232,6 +351,12 @@ namespace occa {
                << " trying to access [" << destOffset << ", " << (destOffset + bytes_) << "]",
                (bytes_ + destOffset) <= modeMemory->size);
 
+    if (modeMemory->layout || src.modeMemory->layout) {
+      assertSameLayout(modeMemory, src.modeMemory, bytes_, destOffset, srcOffset);
+      // Copy the whole allocation, including the AoSoA padding
+      bytes_ = modeMemory->size;
+    }
+
     modeMemory->copyFrom(src.modeMemory, bytes_, destOffset, srcOffset, props);
   }
 
@@ -241,7 +366,7 @@ namespace occa {
                       const occa::json &props) const {
     assertInitialized();
 
-    udim_t bytes_ = ((bytes == -1) ? modeMemory->size : bytes);
+    udim_t bytes_ = ((bytes == -1) ? hostBytes(modeMemory) : bytes);
 
     OCCA_ERROR("Trying to allocate negative bytes (" << bytes << ")",
                bytes >= -1);
@@ -249,9 +374,26 @@ namespace occa {
     OCCA_ERROR("Cannot have a negative offset (" << offset << ")",
                offset >= 0);
 
-    OCCA_ERROR("Source memory has size [" << modeMemory->size << "],"
+    OCCA_ERROR("Source memory has size [" << hostBytes(modeMemory) << "],"
                << " trying to access [" << offset << ", " << (offset + bytes_) << "]",
-               (bytes_ + offset) <= modeMemory->size);
+               (bytes_ + offset) <= hostBytes(modeMemory));
+
+    const dtype_t &hostDtype = getHostDtype(modeMemory, props);
+    if (hostDtype != dtype::none) {
+      const dtype_t &memDtype = *(modeMemory->dtype_);
+      dtypeConversion_t conversion = getHostConversion(
+        modeMemory, hostDtype, memDtype, bytes_, offset
+      );
+      modeMemory->convertTo(dest, hostDtype, conversion,
+                            bytes_ / memDtype.bytes(), offset,
+                            props);
+      return;
+    }
+
+    if (modeMemory->layout) {
+      copyLayoutTo(dest, modeMemory, bytes_, offset, props);
+      return;
+    }
 
     modeMemory->copyTo(dest, bytes_, offset, props);
   }
@@ -263,7 +405,7 @@ namespace occa {
                       const occa::json &props) const {
     assertInitialized();
 
-    udim_t bytes_ = ((bytes == -1) ? modeMemory->size : bytes);
+    udim_t bytes_ = ((bytes == -1) ? hostBytes(modeMemory) : bytes);
 
     OCCA_ERROR("Trying to allocate negative bytes (" << bytes << ")",
                bytes >= -1);
@@ -282,6 +424,11 @@ namespace occa {
                << " trying to access [" << destOffset << ", " << (destOffset + bytes_) << "]",
                (bytes_ + destOffset) <= dest.modeMemory->size);
 
+    if (modeMemory->layout || dest.modeMemory->layout) {
+      assertSameLayout(dest.modeMemory, modeMemory, bytes_, destOffset, srcOffset);
+      bytes_ = modeMemory->size;
+    }
+
     dest.modeMemory->copyFrom(modeMemory, bytes_, destOffset, srcOffset, props);
   }
 
@@ -316,6 +463,13 @@ namespace occa {
       return occa::memory();
     }
 
+    if (modeMemory->layout) {
+      return (
+        occa::device(modeMemory->getModeDevice())
+        .malloc(length(), dtype(), *this, properties())
+      );
+    }
+
     occa::memory mem = (
       occa::device(modeMemory->getModeDevice())
       .malloc(size(), *this, properties())
@@ -325,6 +479,12 @@ namespace occa {
     return mem;
   }
 
+  occa::json memory::layoutDefines(const std::string &name,
+                                   const bool isConst) const {
+    assertInitialized();
+    return memoryLayout_t::getDefines(name, dtype(), modeMemory->layout, isConst);
+  }
+
   void memory::free() {
     if (modeMemory == NULL) return;
     delete modeMemory;
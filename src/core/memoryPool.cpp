@@ -167,6 +167,11 @@ namespace occa {
     memory mem(modeMemoryPool->reserve(bytes));
     mem.setDtype(dtype);
 
+    modeMemoryPool->modeDevice->allocationTracker.add(mem.getModeMemory(),
+                                                      bytes,
+                                                      "reserve",
+                                                      modeMemoryPool->properties.get<std::string>("tag", ""));
+
     return mem;
   }
 
@@ -14,6 +14,7 @@ namespace occa {
     const dtype_t long_("long", sizeof(long), true);
     const dtype_t float_("float", sizeof(float), true);
     const dtype_t double_("double", sizeof(double), true);
+    const dtype_t half("half", 2, true);
 
     const dtype_t int8    = get<int8_t>();
     const dtype_t uint8   = get<uint8_t>();
@@ -1,3 +1,5 @@
+#include <mutex>
+
 #include <occa/defines.hpp>
 #include <occa/dtype/builtins.hpp>
 #include <occa/dtype/dtype.hpp>
@@ -6,6 +8,23 @@
 #include <occa/internal/utils/sys.hpp>
 
 namespace occa {
+  namespace {
+    // Unique ids for flattened dtype sequences, 0 is reserved for bytes
+    uint64_t getSequenceId(const dtypeVector_t &sequence) {
+      static std::mutex mutex;
+      static std::map<dtypeVector_t, uint64_t> sequenceIds;
+
+      std::lock_guard<std::mutex> lock(mutex);
+      std::map<dtypeVector_t, uint64_t>::iterator it = sequenceIds.find(sequence);
+      if (it != sequenceIds.end()) {
+        return it->second;
+      }
+      const uint64_t id = sequenceIds.size() + 1;
+      sequenceIds[sequence] = id;
+      return id;
+    }
+  }
+
   //---[ Dtype_T ]------------------------
   dtype_t::dtype_t() :
     ref(NULL),
@@ -13,7 +32,8 @@ namespace occa {
     bytes_(0),
     registered(false),
     tuple_(NULL),
-    struct_(NULL) {}
+    struct_(NULL),
+    signature_(0) {}
 
   dtype_t::dtype_t(const std::string &name__,
                    const int bytes__,
@@ -23,7 +43,8 @@ namespace occa {
     bytes_(bytes__),
     registered(registered_),
     tuple_(NULL),
-    struct_(NULL) {}
+    struct_(NULL),
+    signature_(0) {}
 
   dtype_t::dtype_t(const std::string &name__,
                    const dtype_t &other,
@@ -33,7 +54,8 @@ namespace occa {
     bytes_(0),
     registered(false),
     tuple_(NULL),
-    struct_(NULL) {
+    struct_(NULL),
+    signature_(0) {
 
     *this = other;
 
@@ -47,7 +69,8 @@ namespace occa {
     bytes_(0),
     registered(false),
     tuple_(NULL),
-    struct_(NULL) {
+    struct_(NULL),
+    signature_(0) {
 
     *this = other;
   }
@@ -62,6 +85,9 @@ namespace occa {
       delete tuple_;
       delete struct_;
 
+      flatDtype.clear();
+      signature_ = 0;
+
       if (other.registered) {
         // Clear values
         ref     = &other;
@@ -166,6 +192,10 @@ namespace occa {
 
     bytes_ += (dtype.bytes_ * tupleSize_);
 
+    // Fields change the flattened type
+    flatDtype.clear();
+    signature_ = 0;
+
     if (tupleSize_ == 1) {
       struct_->addField(field, dtype);
     } else {
@@ -179,7 +209,7 @@ namespace occa {
   void dtype_t::setFlattenedDtype() const {
     const dtype_t &self_ = self();
     if (!self_.flatDtype.size()) {
-      self_.addFlatDtypes(flatDtype);
+      self_.addFlatDtypes(self_.flatDtype);
     }
   }
 
@@ -244,45 +274,64 @@ namespace occa {
   }
 
   bool dtype_t::canBeCastedTo(const dtype_t &other) const {
-    const dtype_t &from = self();
-    const dtype_t &to   = other.self();
+    return canBeCasted(signature(), other.signature());
+  }
 
-    // Anything can be casted from/to bytes
-    if ((&from == &dtype::byte) ||
-        (&to == &dtype::byte)) {
-      return true;
+  uint64_t dtype_t::signature() const {
+    const dtype_t &self_ = self();
+    if (self_.signature_) {
+      return self_.signature_;
     }
 
-    from.setFlattenedDtype();
-    to.setFlattenedDtype();
-
-    const dtypeVector_t &fromVec = from.flatDtype;
-    const int fromEntries = (int) fromVec.size();
+    // Anything can be casted from/to bytes, which uses sequence id 0
+    if (&self_ == &dtype::byte) {
+      self_.signature_ = 1;
+      return self_.signature_;
+    }
 
-    const dtypeVector_t &toVec = to.flatDtype;
-    const int toEntries = (int) toVec.size();
+    self_.setFlattenedDtype();
+    const dtypeVector_t &vec = self_.flatDtype;
+    const int entries = (int) vec.size();
 
-    int entries = fromEntries;
-    // Check if type cycles (e.g. float -> float2)
-    if (fromEntries < toEntries) {
-      if (!isCyclic(toVec, fromEntries)) {
-        return false;
-      }
-      entries = fromEntries;
-    } else if (fromEntries > toEntries) {
-      if (!isCyclic(fromVec, toEntries)) {
-        return false;
+    // Find the shortest cycle (e.g. float4 -> float)
+    int cycleLength = entries;
+    for (int length = 1; length < entries; ++length) {
+      if (isCyclic(vec, length)) {
+        cycleLength = length;
+        break;
       }
-      entries = toEntries;
     }
 
-    for (int i = 0; i < entries; ++i) {
-      if (fromVec[i] != toVec[i]) {
-        return false;
-      }
+    const dtypeVector_t cycle(vec.begin(), vec.begin() + cycleLength);
+    const uint64_t sequenceId = getSequenceId(cycle);
+
+    self_.signature_ = (sequenceId << 32) | (uint32_t) entries;
+    return self_.signature_;
+  }
+
+  bool dtype_t::canBeCasted(const uint64_t fromSignature,
+                            const uint64_t toSignature) {
+    const uint32_t fromId = (uint32_t) (fromSignature >> 32);
+    const uint32_t toId   = (uint32_t) (toSignature >> 32);
+
+    // Anything can be casted from/to bytes
+    if (!fromId || !toId) {
+      return true;
+    }
+    if (fromId != toId) {
+      return false;
     }
 
-    return true;
+    // Same cycle, so one needs to be a repetition of the other
+    const uint32_t fromEntries = (uint32_t) fromSignature;
+    const uint32_t toEntries   = (uint32_t) toSignature;
+    if (!fromEntries || !toEntries) {
+      return fromEntries == toEntries;
+    }
+    return (
+      ((fromEntries % toEntries) == 0)
+      || ((toEntries % fromEntries) == 0)
+    );
   }
 
   bool dtype_t::isCyclic(const dtypeVector_t &vec,
@@ -331,6 +380,7 @@ namespace occa {
       dtypeMap["long"]   = &dtype::long_;
       dtypeMap["float"]  = &dtype::float_;
       dtypeMap["double"] = &dtype::double_;
+      dtypeMap["half"]   = &dtype::half;
 
       // Sized primitives
       dtypeMap["int8"]   = dtype::get<int8_t>().ref;
@@ -0,0 +1,181 @@
+#include <occa/experimental/kernelTuner.hpp>
+#include <occa/core/streamTag.hpp>
+#include <occa/utils/exception.hpp>
+#include <occa/utils/hash.hpp>
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/string.hpp>
+
+namespace occa {
+  kernelTuner::kernelTuner(occa::device device_,
+                           const std::string &filename_,
+                           const std::string &kernelName_,
+                           const occa::json &props_) :
+    device(device_),
+    filename(io::findInPaths(filename_, env::OCCA_KERNEL_PATH)),
+    kernelName(kernelName_),
+    props(props_),
+    candidates(occa::json::object_) {}
+
+  void kernelTuner::addCandidates(const std::string &define,
+                                  const std::vector<occa::json> &values) {
+    occa::json &defineValues = candidates[define];
+    defineValues.asArray();
+    for (const occa::json &value : values) {
+      defineValues += value;
+    }
+  }
+
+  occa::kernel kernelTuner::getKernel(const udim_t problemSize,
+                                      runFunction_t run) {
+    return buildVariant(getDefines(problemSize, run));
+  }
+
+  occa::json kernelTuner::getDefines(const udim_t problemSize,
+                                     runFunction_t run) {
+    const std::string sizeClass = occa::toString(getSizeClass(problemSize));
+    const std::string resultsFilename = getResultsFilename();
+
+    occa::json results(occa::json::object_);
+    if (io::isFile(resultsFilename)) {
+      results = occa::json::read(resultsFilename);
+    }
+
+    const occa::json &cachedResult = results.getPathValue(sizeClass.c_str());
+    if (cachedResult.isObject()) {
+      return cachedResult.getPathValue("defines");
+    }
+
+    occa::json result = tune(run);
+    if (props.get("verbose", false)) {
+      io::stdout << "Tuned [" << kernelName << "] for size class [" << sizeClass << "]: "
+                 << result["defines"].toString() << '\n';
+    }
+
+    results[sizeClass] = result;
+    io::stageFile(
+      resultsFilename,
+      false,
+      [&](const std::string &tempFilename) -> bool {
+        results.write(tempFilename);
+        return true;
+      }
+    );
+
+    return result["defines"];
+  }
+
+  int kernelTuner::getSizeClass(const udim_t problemSize) {
+    int sizeClass = 0;
+    while ((sizeClass < 63) && ((((udim_t) 1) << sizeClass) < problemSize)) {
+      ++sizeClass;
+    }
+    return sizeClass;
+  }
+
+  std::string kernelTuner::getResultsFilename() const {
+    const hash_t tuningHash = (
+      occa::hash(device)
+      ^ occa::hashFile(filename)
+      ^ occa::hash(kernelName)
+      ^ occa::hash(props)
+      ^ occa::hash(candidates)
+    );
+    return io::hashDir(tuningHash) + "tuning.json";
+  }
+
+  void kernelTuner::free() {
+    hashedKernelMapIterator it = kernelMap.begin();
+    while (it != kernelMap.end()) {
+      it->second.free();
+      ++it;
+    }
+    kernelMap.clear();
+  }
+
+  occa::kernel kernelTuner::buildVariant(const occa::json &defines) {
+    occa::kernel &kernel = kernelMap[occa::hash(defines)];
+    if (!kernel.isInitialized()) {
+      occa::json variantProps = props;
+      variantProps["defines"] += defines;
+      kernel = device.buildKernel(filename, kernelName, variantProps);
+    }
+    return kernel;
+  }
+
+  occa::json kernelTuner::tune(runFunction_t run) {
+    const int iterations = props.get("tuner/iterations", 3);
+    OCCA_ERROR("[kernelTuner] Needs at least 1 timed iteration",
+               iterations > 0);
+
+    occa::json bestDefines;
+    double bestTime = -1;
+    for (const occa::json &defines : getCandidateDefines()) {
+      double time;
+      try {
+        time = timeVariant(defines, run, iterations);
+      } catch (occa::exception &exc) {
+        // Candidates can fail to build, such as tiles larger than the device allows
+        OCCA_FORCE_WARNING("[kernelTuner] Skipping [" << kernelName << "] candidate "
+                           << defines.toString() << ":\n" << exc.message);
+        continue;
+      }
+
+      if ((bestTime < 0) || (time < bestTime)) {
+        bestDefines = defines;
+        bestTime = time;
+      }
+    }
+
+    OCCA_ERROR("[kernelTuner] No candidate for [" << kernelName << "] could be built",
+               bestTime >= 0);
+
+    occa::json result;
+    result["defines"] = bestDefines;
+    result["time"] = bestTime;
+    return result;
+  }
+
+  double kernelTuner::timeVariant(const occa::json &defines,
+                                  runFunction_t run,
+                                  const int iterations) {
+    occa::kernel kernel = buildVariant(defines);
+
+    // Warm up caches and lazy initialization outside the timed runs
+    run(kernel);
+    device.finish();
+
+    double bestTime = -1;
+    for (int i = 0; i < iterations; ++i) {
+      occa::streamTag startTag = device.tagStream();
+      run(kernel);
+      occa::streamTag endTag = device.tagStream();
+      device.waitFor(endTag);
+
+      const double time = device.timeBetween(startTag, endTag);
+      if ((bestTime < 0) || (time < bestTime)) {
+        bestTime = time;
+      }
+    }
+    return bestTime;
+  }
+
+  std::vector<occa::json> kernelTuner::getCandidateDefines() const {
+    // Cartesian product of the candidate values of each define
+    std::vector<occa::json> candidateDefines(1, occa::json(occa::json::object_));
+
+    for (const auto &entry : candidates.object()) {
+      std::vector<occa::json> nextCandidateDefines;
+      for (const occa::json &defines : candidateDefines) {
+        for (const occa::json &value : entry.second.array()) {
+          occa::json nextDefines = defines;
+          nextDefines[entry.first] = value;
+          nextCandidateDefines.push_back(nextDefines);
+        }
+      }
+      candidateDefines.swap(nextCandidateDefines);
+    }
+
+    return candidateDefines;
+  }
+}
@@ -6,7 +6,8 @@ namespace occa {
     template <>
     bool hostReduction<bool>(reductionType type, occa::memory mem) {
       const int entryCount = (int) mem.length();
-      bool *values = new bool[entryCount];
+      occa::device device = mem.getDevice();
+      bool *values = (bool*) device.reserveStagingBuffer(entryCount * sizeof(bool));
       mem.copyTo(values);
 
       bool reductionValue = values[0];
@@ -48,7 +49,7 @@ namespace occa {
           break;
       }
 
-      delete [] values;
+      device.releaseStagingBuffer(values);
 
       return reductionValue;
     }
@@ -56,7 +57,8 @@ namespace occa {
     template <>
     float hostReduction<float>(reductionType type, occa::memory mem) {
       const int entryCount = (int) mem.length();
-      float *values = new float[entryCount];
+      occa::device device = mem.getDevice();
+      float *values = (float*) device.reserveStagingBuffer(entryCount * sizeof(float));
       mem.copyTo(values);
 
       float reductionValue = values[0];
@@ -94,7 +96,7 @@ namespace occa {
           break;
       }
 
-      delete [] values;
+      device.releaseStagingBuffer(values);
 
       return reductionValue;
     }
@@ -102,7 +104,8 @@ namespace occa {
     template <>
     double hostReduction<double>(reductionType type, occa::memory mem) {
       const int entryCount = (int) mem.length();
-      double *values = new double[entryCount];
+      occa::device device = mem.getDevice();
+      double *values = (double*) device.reserveStagingBuffer(entryCount * sizeof(double));
       mem.copyTo(values);
 
       double reductionValue = values[0];
@@ -140,7 +143,7 @@ namespace occa {
           break;
       }
 
-      delete [] values;
+      device.releaseStagingBuffer(values);
 
       return reductionValue;
     }
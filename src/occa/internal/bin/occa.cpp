@@ -102,7 +102,8 @@ namespace occa {
 
       bool removedSomething = false;
       if (options["kernels"]) {
-        removedSomething |= safeRmrf(io::cachePath(), promptCheck);
+        // Remove kernels cached by older OCCA versions as well
+        removedSomething |= safeRmrf(io::cacheRootPath(), promptCheck);
       }
       if (options["locks"]) {
         const std::string lockPath = env::OCCA_CACHE_DIR + "locks/";
@@ -186,6 +187,14 @@ namespace occa {
         translationInfo["translate_info/okl_version"] = OKL_VERSION_STR;
         // Kernel properties
         translationInfo["kernel_properties"] = kernelProps;
+        // Barriers skipped by the @shared dependency analysis
+        lang::okl::withLauncher *withLauncherParser = dynamic_cast<lang::okl::withLauncher*>(parser);
+        if (withLauncherParser) {
+          json &removedBarriers = translationInfo["removed_barriers"].asArray();
+          for (const std::string &location : withLauncherParser->removedBarriers) {
+            removedBarriers += location;
+          }
+        }
 
         io::stdout
             << "/* Translation Info:\n"
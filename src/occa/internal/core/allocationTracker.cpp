@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <sstream>
+
+#include <occa/internal/core/allocationTracker.hpp>
+#include <occa/internal/utils/sys.hpp>
+
+namespace occa {
+  allocationTracker_t::usage_t::usage_t() :
+    allocations(0),
+    bytes(0),
+    peakBytes(0),
+    totalAllocations(0) {}
+
+  allocationTracker_t::allocationTracker_t(const occa::json &props) :
+    isEnabled(props.get("track_allocations", false)),
+    useBacktraces(props.get("track_allocation_backtraces", false)),
+    nextId(0) {
+    poolResizes.asArray();
+  }
+
+  void allocationTracker_t::addUsage(usage_t &usage, const udim_t bytes) {
+    ++usage.allocations;
+    ++usage.totalAllocations;
+    usage.bytes += bytes;
+    usage.peakBytes = std::max(usage.peakBytes, usage.bytes);
+  }
+
+  void allocationTracker_t::removeUsage(usage_t &usage, const udim_t bytes) {
+    --usage.allocations;
+    usage.bytes -= bytes;
+  }
+
+  void allocationTracker_t::add(const void *key,
+                                const udim_t bytes,
+                                const std::string &kind,
+                                const std::string &tag) {
+    if (!isEnabled || !key) {
+      return;
+    }
+
+    allocation_t &allocation = allocations[key];
+    allocation.id    = nextId++;
+    allocation.bytes = bytes;
+    allocation.kind  = kind;
+    allocation.tag   = tag;
+    if (useBacktraces) {
+      // Skip this frame
+      sys::getStackFrames(allocation.frames, 1);
+    }
+
+    addUsage(totalUsage, bytes);
+    addUsage(tagUsage[tag], bytes);
+    ++sizeClassCounts[getSizeClass(bytes)];
+  }
+
+  void allocationTracker_t::remove(const void *key) {
+    if (!isEnabled) {
+      return;
+    }
+
+    std::map<const void*, allocation_t>::iterator it = allocations.find(key);
+    if (it == allocations.end()) {
+      return;
+    }
+
+    const allocation_t &allocation = it->second;
+    removeUsage(totalUsage, allocation.bytes);
+    removeUsage(tagUsage[allocation.tag], allocation.bytes);
+
+    allocations.erase(it);
+  }
+
+  void allocationTracker_t::addPoolResize(const std::string &tag,
+                                          const udim_t fromBytes,
+                                          const udim_t toBytes,
+                                          const udim_t reservedBytes) {
+    if (!isEnabled) {
+      return;
+    }
+
+    occa::json resize;
+    resize["tag"]            = tag;
+    resize["from_bytes"]     = fromBytes;
+    resize["to_bytes"]       = toBytes;
+    resize["reserved_bytes"] = reservedBytes;
+    poolResizes += resize;
+  }
+
+  udim_t allocationTracker_t::getSizeClass(const udim_t bytes) {
+    udim_t sizeClass = 1;
+    while (sizeClass < bytes) {
+      sizeClass <<= 1;
+    }
+    return sizeClass;
+  }
+
+  std::vector<const allocationTracker_t::allocation_t*> allocationTracker_t::getLiveAllocations() const {
+    std::vector<const allocation_t*> liveAllocations;
+    for (const auto &it : allocations) {
+      liveAllocations.push_back(&(it.second));
+    }
+    std::sort(liveAllocations.begin(), liveAllocations.end(),
+              [](const allocation_t *a, const allocation_t *b) {
+                return a->id < b->id;
+              });
+    return liveAllocations;
+  }
+
+  occa::json allocationTracker_t::snapshot() const {
+    occa::json snapshot;
+    snapshot["enabled"] = isEnabled;
+    if (!isEnabled) {
+      return snapshot;
+    }
+
+    snapshot["bytes"]             = totalUsage.bytes;
+    snapshot["peak_bytes"]        = totalUsage.peakBytes;
+    snapshot["allocations"]       = totalUsage.allocations;
+    snapshot["total_allocations"] = totalUsage.totalAllocations;
+
+    // Live allocations per size class, next to how many were ever made
+    std::map<udim_t, usage_t> sizeClassUsage;
+    for (const auto &it : allocations) {
+      addUsage(sizeClassUsage[getSizeClass(it.second.bytes)], it.second.bytes);
+    }
+
+    occa::json &sizeClasses = snapshot["size_classes"].asArray();
+    for (const auto &it : sizeClassCounts) {
+      const usage_t &usage = sizeClassUsage[it.first];
+
+      occa::json sizeClass;
+      sizeClass["max_bytes"]         = it.first;
+      sizeClass["allocations"]       = usage.allocations;
+      sizeClass["bytes"]             = usage.bytes;
+      sizeClass["total_allocations"] = it.second;
+      sizeClasses += sizeClass;
+    }
+
+    occa::json &tags = snapshot["tags"].asObject();
+    for (const auto &it : tagUsage) {
+      occa::json &tag = tags[it.first.size() ? it.first : "untagged"];
+      tag["allocations"]       = it.second.allocations;
+      tag["bytes"]             = it.second.bytes;
+      tag["peak_bytes"]        = it.second.peakBytes;
+      tag["total_allocations"] = it.second.totalAllocations;
+    }
+
+    occa::json &live = snapshot["live"].asArray();
+    for (const allocation_t *allocation : getLiveAllocations()) {
+      occa::json entry;
+      entry["id"]    = allocation->id;
+      entry["bytes"] = allocation->bytes;
+      entry["kind"]  = allocation->kind;
+      entry["tag"]   = allocation->tag;
+      if (allocation->frames.size()) {
+        entry["backtrace"] = sys::stacktrace(allocation->frames);
+      }
+      live += entry;
+    }
+
+    snapshot["pool_resizes"] = poolResizes;
+
+    return snapshot;
+  }
+
+  std::string allocationTracker_t::leakReport() const {
+    if (!isEnabled || allocations.empty()) {
+      return "";
+    }
+
+    const int liveCount = (int) allocations.size();
+
+    std::stringstream ss;
+    ss << "Device freed with " << liveCount << " live allocation"
+       << (liveCount == 1 ? "" : "s")
+       << " (" << totalUsage.bytes << " bytes)\n";
+
+    for (const allocation_t *allocation : getLiveAllocations()) {
+      ss << "  - " << allocation->bytes << " bytes from " << allocation->kind;
+      if (allocation->tag.size()) {
+        ss << " [" << allocation->tag << "]";
+      }
+      ss << '\n';
+      if (allocation->frames.size()) {
+        ss << sys::stacktrace(allocation->frames, "      ");
+      }
+    }
+
+    return ss.str();
+  }
+}
@@ -0,0 +1,82 @@
+#ifndef OCCA_INTERNAL_CORE_ALLOCATIONTRACKER_HEADER
+#define OCCA_INTERNAL_CORE_ALLOCATIONTRACKER_HEADER
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <occa/types/json.hpp>
+#include <occa/types/typedefs.hpp>
+
+namespace occa {
+  //---[ Allocation Tracker ]-----------
+  // Opt-in bookkeeping of live device allocations, enabled through
+  //   the device properties:
+  //   - track_allocations: Record allocations and memory pool reservations
+  //   - track_allocation_backtraces: Also record where they were made
+  //
+  // Allocations are keyed by the object that frees them: the buffer for
+  //   device allocations and the reservation for memory pools.
+  class allocationTracker_t {
+  public:
+    struct allocation_t {
+      udim_t id;
+      udim_t bytes;
+      std::string kind;
+      std::string tag;
+      std::vector<void*> frames;
+    };
+
+    struct usage_t {
+      udim_t allocations;
+      udim_t bytes;
+      udim_t peakBytes;
+      udim_t totalAllocations;
+
+      usage_t();
+    };
+
+    bool isEnabled;
+    bool useBacktraces;
+
+    allocationTracker_t(const occa::json &props);
+
+    void add(const void *key,
+             const udim_t bytes,
+             const std::string &kind,
+             const std::string &tag);
+
+    void remove(const void *key);
+
+    void addPoolResize(const std::string &tag,
+                       const udim_t fromBytes,
+                       const udim_t toBytes,
+                       const udim_t reservedBytes);
+
+    // Size classes are the next power of 2
+    static udim_t getSizeClass(const udim_t bytes);
+
+    occa::json snapshot() const;
+
+    // Returns an empty string if there are no live allocations
+    std::string leakReport() const;
+
+  private:
+    udim_t nextId;
+    usage_t totalUsage;
+
+    std::map<const void*, allocation_t> allocations;
+    std::map<std::string, usage_t> tagUsage;
+    std::map<udim_t, udim_t> sizeClassCounts;
+    occa::json poolResizes;
+
+    // Ordered by when they were made
+    std::vector<const allocation_t*> getLiveAllocations() const;
+
+    static void addUsage(usage_t &usage, const udim_t bytes);
+    static void removeUsage(usage_t &usage, const udim_t bytes);
+  };
+  //====================================
+}
+
+#endif
@@ -1,3 +1,4 @@
+#include <occa/internal/core/device.hpp>
 #include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
 #include <occa/internal/modes/serial/buffer.hpp>
@@ -30,6 +31,7 @@ namespace occa {
       if (!isWrapped) {
         modeDevice->bytesAllocated -= size;
       }
+      modeDevice->allocationTracker.remove(this);
 
       modeDevice->removeMemoryRef(this);
     }
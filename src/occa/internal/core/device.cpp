@@ -5,6 +5,7 @@
 #include <occa/internal/core/stream.hpp>
 #include <occa/internal/core/streamTag.hpp>
 #include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/sys.hpp>
 #include <occa/internal/io.hpp>
 
 namespace occa {
@@ -13,7 +14,9 @@ namespace occa {
     properties(properties_),
     needsLauncherKernel(false),
     bytesAllocated(0),
-    maxBytesAllocated(0) {}
+    maxBytesAllocated(0),
+    allocationTracker(properties_),
+    stagingRing(this) {}
 
   modeDevice_t::~modeDevice_t() {
     // Null all wrappers
@@ -26,6 +29,7 @@ namespace occa {
 
   // Must be called before ~modeDevice_t()!
   void modeDevice_t::freeResources() {
+    stagingRing.free();
     freeRing<modeKernel_t>(kernelRing);
     freeRing<modeBuffer_t>(memoryRing);
     freeRing<modeStream_t>(streamRing);
@@ -142,4 +146,18 @@ namespace occa {
       cachedKernels.erase(it);
     }
   }
+
+  modeMemory_t* modeDevice_t::mmapFile(const std::string &filename,
+                                       const occa::json &props) {
+    OCCA_FORCE_ERROR("Mode [" << mode << "] does not support memory-mapped files");
+    return NULL;
+  }
+
+  void* modeDevice_t::mallocStagingMemory(const udim_t bytes) {
+    return sys::malloc(bytes);
+  }
+
+  void modeDevice_t::freeStagingMemory(void *ptr) {
+    sys::free(ptr);
+  }
 }
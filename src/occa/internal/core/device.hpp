@@ -3,6 +3,8 @@
 
 #include <occa/core/device.hpp>
 #include <occa/types/json.hpp>
+#include <occa/internal/core/allocationTracker.hpp>
+#include <occa/internal/core/stagingRing.hpp>
 #include <occa/internal/utils/gc.hpp>
 #include <occa/internal/lang/kernelMetadata.hpp>
 
@@ -24,6 +26,9 @@ namespace occa {
 
     udim_t bytesAllocated;
     udim_t maxBytesAllocated;
+    allocationTracker_t allocationTracker;
+
+    stagingRing_t stagingRing;
 
     cachedKernelMap cachedKernels;
 
@@ -118,8 +123,16 @@ namespace occa {
                                      const udim_t bytes,
                                      const occa::json &props) = 0;
 
+    // Modes without host-addressable memory can't map files
+    virtual modeMemory_t* mmapFile(const std::string &filename,
+                                   const occa::json &props);
+
     virtual modeMemoryPool_t* createMemoryPool(const occa::json &props)=0;
 
+    // Host memory backing the staging ring, page-locked if the backend supports it
+    virtual void* mallocStagingMemory(const udim_t bytes);
+    virtual void freeStagingMemory(void *ptr);
+
     virtual udim_t memorySize() const = 0;
     //  |===============================
 
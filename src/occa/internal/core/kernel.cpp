@@ -10,7 +10,9 @@ namespace occa {
     modeDevice(modeDevice_),
     name(name_),
     sourceFilename(sourceFilename_),
-    properties(properties_) {
+    properties(properties_),
+    validateTypes(properties_.get("type_validation", true)),
+    specializer(properties_) {
     modeDevice->addKernelRef(this);
   }
 
@@ -83,12 +85,7 @@ namespace occa {
   void modeKernel_t::setupRun() {
     const int argc = (int) arguments.size();
 
-    const bool validateTypes = (
-      metadata.isInitialized()
-      && properties.get("type_validation", true)
-    );
-
-    if (!validateTypes) {
+    if (!validateTypes || !metadata.isInitialized()) {
       return;
     }
 
@@ -101,6 +98,10 @@ namespace occa {
                << argc << ']',
                argc == metaArgc);
 
+    if ((int) validatedDtypes.size() != metaArgc) {
+      validatedDtypes.assign(metaArgc, NULL);
+    }
+
     // TODO: Get original arg #
     for (int i = 0; i < argc; ++i) {
       kernelArgData &arg = arguments[i];
@@ -123,10 +124,18 @@ namespace occa {
         continue;
       }
 
+      // Memory dtypes are registered, so the same pointer means the same type
+      if (validatedDtypes[i] == mem->dtype_) {
+        continue;
+      }
+
       OCCA_ERROR("(" << hash << ":" << name << ") Argument [" << (i + 1) << "] has wrong runtime type.\n"
                  << "Expected type: " << argInfo.dtype << '\n'
                  << "Received type: " << *(mem->dtype_) << '\n',
-                 mem->dtype_->canBeCastedTo(argInfo.dtype));
+                 dtype_t::canBeCasted(mem->dtype_->signature(),
+                                      argInfo.dtype.signature()));
+
+      validatedDtypes[i] = mem->dtype_;
     }
   }
 
@@ -3,6 +3,7 @@
 
 #include <occa/core/kernel.hpp>
 #include <occa/types/json.hpp>
+#include <occa/internal/core/kernelSpecializer.hpp>
 #include <occa/internal/utils/gc.hpp>
 #include <occa/internal/lang/kernelMetadata.hpp>
 
@@ -13,6 +14,8 @@ namespace occa {
     occa::modeDevice_t *modeDevice;
     std::string name;
     std::string sourceFilename, binaryFilename;
+    // Source file passed to buildKernel, before any mode translated it
+    std::string originalFilename;
     occa::json properties;
     hash_t hash;
 
@@ -21,6 +24,13 @@ namespace occa {
     std::vector<kernelArgData> arguments;
     lang::kernelMetadata_t metadata;
 
+    // Memory dtypes which already passed type validation, per argument
+    bool validateTypes;
+    std::vector<const dtype_t*> validatedDtypes;
+
+    // Variants specialized on runtime scalar arguments
+    kernelSpecializer_t specializer;
+
     // References
     gc::ring_t<kernel> kernelRing;
 
@@ -0,0 +1,184 @@
+#include <chrono>
+
+#include <occa/core/device.hpp>
+#include <occa/utils/env.hpp>
+#include <occa/utils/exception.hpp>
+#include <occa/internal/core/device.hpp>
+#include <occa/internal/core/kernel.hpp>
+#include <occa/internal/core/kernelSpecializer.hpp>
+
+namespace occa {
+  kernelSpecializer_t::variant_t::variant_t() :
+    failed(false) {}
+
+  kernelSpecializer_t::kernelSpecializer_t(const occa::json &props) :
+    argNames(props.toVector<std::string>("specialize_args")),
+    isEnabled(!argNames.empty()),
+    async(props.get("specialize_async", true)),
+    setupArgs(false) {}
+
+  modeKernel_t* kernelSpecializer_t::getVariant(modeKernel_t &genericKernel) {
+    if (!isEnabled || !setupArgIndices(genericKernel)) {
+      return NULL;
+    }
+
+    // Looked up on every launch, so keep the key cheap to build
+    const int argCount = (int) argNames.size();
+    std::string key;
+    for (int i = 0; i < argCount; ++i) {
+      key += genericKernel.arguments[argIndices[i]].value.toString();
+      key += ',';
+    }
+
+    std::map<std::string, variant_t>::iterator it = variants.find(key);
+    if (it == variants.end()) {
+      variant_t &variant = variants[key];
+
+      occa::json specializations;
+      for (int i = 0; i < argCount; ++i) {
+        specializations[argNames[i]] = genericKernel.arguments[argIndices[i]].value;
+      }
+
+      // Keep user-given specializations and don't specialize variants again
+      variant.props = genericKernel.properties;
+      variant.props["okl/specialize"] += specializations;
+      variant.props.remove("specialize_args");
+
+      startBuild(genericKernel, variant);
+      it = variants.find(key);
+    }
+
+    variant_t &variant = it->second;
+    if (!finishBuild(genericKernel, variant)) {
+      return NULL;
+    }
+
+    modeKernel_t *variantKernel = variant.kernel.getModeKernel();
+    variantKernel->arguments = genericKernel.arguments;
+    variantKernel->outerDims = genericKernel.outerDims;
+    variantKernel->innerDims = genericKernel.innerDims;
+
+    return variantKernel;
+  }
+
+  bool kernelSpecializer_t::setupArgIndices(modeKernel_t &genericKernel) {
+    if (setupArgs) {
+      return isEnabled;
+    }
+
+    const lang::kernelMetadata_t &metadata = genericKernel.metadata;
+    if (!metadata.isInitialized()
+        || !genericKernel.properties.get("okl/enabled", true)) {
+      OCCA_FORCE_WARNING("(" << genericKernel.name << ") [specialize_args] requires an OKL kernel");
+      setupArgs = true;
+      isEnabled = false;
+      return false;
+    }
+
+    // Only keep the indices once every argument checks out, otherwise
+    //   a launch after a failed one would use a partial list
+    std::vector<int> indices;
+    const int metaArgc = (int) metadata.arguments.size();
+    for (const std::string &argName : argNames) {
+      int argIndex = -1;
+      for (int i = 0; i < metaArgc; ++i) {
+        if (metadata.arguments[i].name == argName) {
+          argIndex = i;
+          break;
+        }
+      }
+
+      OCCA_ERROR("(" << genericKernel.name << ") Kernel has no argument ["
+                 << argName << "] to specialize",
+                 argIndex >= 0);
+
+      const lang::argMetadata_t &argInfo = metadata.arguments[argIndex];
+      OCCA_ERROR("(" << genericKernel.name << ") Only const scalar arguments can be specialized, ["
+                 << argName << "] is not",
+                 argInfo.isConst && !argInfo.isPtr);
+
+      indices.push_back(argIndex);
+    }
+
+    OCCA_ERROR("(" << genericKernel.name << ") Kernel expects ["
+               << metaArgc << "] arguments, received ["
+               << genericKernel.arguments.size() << ']',
+               (int) genericKernel.arguments.size() == metaArgc);
+
+    argIndices.swap(indices);
+    setupArgs = true;
+    return true;
+  }
+
+  void kernelSpecializer_t::startBuild(modeKernel_t &genericKernel,
+                                       variant_t &variant) {
+    if (!async) {
+      loadVariant(genericKernel, variant);
+      return;
+    }
+
+    // The job only reads the copies taken here, the kernel and its device
+    //   keep being used on this thread while it runs.
+    // settings() is per-thread so the job would otherwise build with the
+    //   base settings instead of the ones in effect on this thread
+    const occa::json buildSettings = settings();
+    const occa::json deviceProps = genericKernel.modeDevice->properties;
+    const std::string sourceFilename = genericKernel.originalFilename;
+    const std::string kernelName = genericKernel.name;
+    const occa::json props = variant.props;
+
+    variant.build = std::async(std::launch::async, [=]() {
+      settings() = buildSettings;
+
+      // Compile into the cache through a private device, keeping the
+      //   kernel's device single-threaded
+      occa::device builder(deviceProps);
+      builder.buildKernel(sourceFilename, kernelName, props);
+    });
+  }
+
+  bool kernelSpecializer_t::finishBuild(modeKernel_t &genericKernel,
+                                        variant_t &variant) {
+    if (variant.failed) {
+      return false;
+    }
+
+    if (variant.build.valid()) {
+      const bool isReady = (
+        variant.build.wait_for(std::chrono::seconds(0)) == std::future_status::ready
+      );
+      if (!isReady) {
+        return false;
+      }
+
+      try {
+        variant.build.get();
+        // Loads the binary compiled in the background from the cache
+        loadVariant(genericKernel, variant);
+      } catch (occa::exception &exc) {
+        OCCA_FORCE_WARNING("(" << genericKernel.name << ") Failed to build specialized kernel:\n"
+                           << exc.message);
+      }
+    }
+
+    if (!variant.kernel.isInitialized()) {
+      variant.failed = true;
+      return false;
+    }
+    return true;
+  }
+
+  void kernelSpecializer_t::loadVariant(modeKernel_t &genericKernel,
+                                        variant_t &variant) {
+    try {
+      variant.kernel = occa::device(genericKernel.modeDevice).buildKernel(
+        genericKernel.originalFilename,
+        genericKernel.name,
+        variant.props
+      );
+    } catch (occa::exception &exc) {
+      OCCA_FORCE_WARNING("(" << genericKernel.name << ") Failed to build specialized kernel:\n"
+                         << exc.message);
+    }
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef OCCA_INTERNAL_CORE_KERNELSPECIALIZER_HEADER
+#define OCCA_INTERNAL_CORE_KERNELSPECIALIZER_HEADER
+
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <occa/core/kernel.hpp>
+#include <occa/types/json.hpp>
+#include <occa/types/typedefs.hpp>
+
+namespace occa {
+  class modeKernel_t;
+
+  //---[ Kernel Specializer ]-----------
+  // Opt-in JIT specialization on runtime scalar arguments, enabled
+  //   through the kernel properties:
+  //   - specialize_args: Names of const scalar arguments to specialize
+  //   - specialize_async: Run the generic kernel while variants compile
+  //                       in the background (default: true)
+  //
+  // Variants are built from the same source with the argument values
+  //   passed as [okl/specialize] and are cached by those values.
+  class kernelSpecializer_t {
+  public:
+    struct variant_t {
+      occa::json props;
+      std::future<void> build;
+      occa::kernel kernel;
+      bool failed;
+
+      variant_t();
+    };
+
+    strVector argNames;
+    bool isEnabled;
+    bool async;
+
+    kernelSpecializer_t(const occa::json &props);
+
+    // Returns the variant matching the current arguments, ready to launch,
+    //   or NULL if the generic kernel should be launched
+    modeKernel_t* getVariant(modeKernel_t &genericKernel);
+
+  private:
+    bool setupArgs;
+    std::vector<int> argIndices;
+    std::map<std::string, variant_t> variants;
+
+    bool setupArgIndices(modeKernel_t &genericKernel);
+
+    void startBuild(modeKernel_t &genericKernel,
+                    variant_t &variant);
+
+    bool finishBuild(modeKernel_t &genericKernel,
+                     variant_t &variant);
+
+    void loadVariant(modeKernel_t &genericKernel,
+                     variant_t &variant);
+  };
+  //====================================
+}
+
+#endif
@@ -79,6 +79,7 @@ namespace occa {
 
         // Some backends inject additional arguments
         deviceKernel->properties["type_validation"] = false;
+        deviceKernel->validateTypes = false;
       }
     }
 
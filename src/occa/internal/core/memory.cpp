@@ -1,8 +1,16 @@
+#include <algorithm>
+#include <vector>
+
+#include <occa/internal/core/memoryLayout.hpp>
 #include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/buffer.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
 
 namespace occa {
+  namespace {
+    // Keeps converted copies from staging the whole memory at full precision
+    const udim_t stagingBytes = (4 * 1024 * 1024);
+  }
 
   modeMemory_t::modeMemory_t(modeBuffer_t *modeBuffer_,
                              udim_t size_, dim_t offset_) :
@@ -10,11 +18,14 @@ namespace occa {
     ptr(NULL),
     dtype_(&dtype::byte),
     size(size_),
-    offset(offset_) {
+    offset(offset_),
+    layout(NULL) {
     modeBuffer->addModeMemoryRef(this);
   }
 
   modeMemory_t::~modeMemory_t() {
+    delete layout;
+
     // NULL all wrappers
     while (memoryRing.head) {
       memory *mem = (memory*) memoryRing.head;
@@ -89,4 +100,47 @@ namespace occa {
 
     return modeBuffer->slice(offset+offset_, bytes);
   }
+
+  void modeMemory_t::convertTo(void *dest,
+                               const dtype_t &hostDtype,
+                               dtypeConversion_t conversion,
+                               const udim_t entries,
+                               const udim_t offset_,
+                               const occa::json &props) const {
+    const udim_t entryBytes = dtype_->bytes();
+    const udim_t hostEntryBytes = hostDtype.bytes();
+    const udim_t stagingEntries = std::min(entries, stagingBytes / entryBytes);
+
+    // The staging buffer is reused before returning
+    occa::json syncProps = props;
+    syncProps["async"] = false;
+
+    std::vector<char> staging(stagingEntries * entryBytes);
+    for (udim_t i = 0; i < entries; i += stagingEntries) {
+      const udim_t count = std::min(stagingEntries, entries - i);
+      copyTo(&(staging[0]), count * entryBytes, offset_ + (i * entryBytes), syncProps);
+      conversion(((char*) dest) + (i * hostEntryBytes), &(staging[0]), count);
+    }
+  }
+
+  void modeMemory_t::convertFrom(const void *src,
+                                 const dtype_t &hostDtype,
+                                 dtypeConversion_t conversion,
+                                 const udim_t entries,
+                                 const udim_t offset_,
+                                 const occa::json &props) {
+    const udim_t entryBytes = dtype_->bytes();
+    const udim_t hostEntryBytes = hostDtype.bytes();
+    const udim_t stagingEntries = std::min(entries, stagingBytes / entryBytes);
+
+    occa::json syncProps = props;
+    syncProps["async"] = false;
+
+    std::vector<char> staging(stagingEntries * entryBytes);
+    for (udim_t i = 0; i < entries; i += stagingEntries) {
+      const udim_t count = std::min(stagingEntries, entries - i);
+      conversion(&(staging[0]), ((const char*) src) + (i * hostEntryBytes), count);
+      copyFrom(&(staging[0]), count * entryBytes, offset_ + (i * entryBytes), syncProps);
+    }
+  }
 }
@@ -3,11 +3,13 @@
 
 #include <occa/core/memory.hpp>
 #include <occa/types/json.hpp>
+#include <occa/internal/utils/dtypeConversion.hpp>
 #include <occa/internal/utils/gc.hpp>
 
 namespace occa {
   class kernelArgData;
   class modeBuffer_t;
+  class memoryLayout_t;
 
   class modeMemory_t : public gc::ringEntry_t {
    public:
@@ -20,6 +22,9 @@ namespace occa {
     udim_t size;
     dim_t offset;
 
+    // Set for struct dtypes allocated with a non-AoS layout
+    memoryLayout_t *layout;
+
     modeMemory_t(modeBuffer_t *modeBuffer_,
                  udim_t size_, dim_t offset_);
 
@@ -63,6 +68,22 @@ namespace occa {
                           const occa::json &props = occa::json()) = 0;
 
     virtual void* unwrap() = 0;
+
+    // Host copies converting [entries] values between the memory dtype and [hostDtype]
+    // The default implementations convert through a bounded host staging buffer
+    virtual void convertTo(void *dest,
+                           const dtype_t &hostDtype,
+                           dtypeConversion_t conversion,
+                           const udim_t entries,
+                           const udim_t offset,
+                           const occa::json &props) const;
+
+    virtual void convertFrom(const void *src,
+                             const dtype_t &hostDtype,
+                             dtypeConversion_t conversion,
+                             const udim_t entries,
+                             const udim_t offset,
+                             const occa::json &props);
     //==================================
 
     //---[ Friend Functions ]-----------
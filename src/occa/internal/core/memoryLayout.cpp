@@ -0,0 +1,367 @@
+#include <algorithm>
+#include <cstring>
+
+#include <occa/internal/core/memory.hpp>
+#include <occa/internal/core/memoryLayout.hpp>
+#include <occa/internal/utils/string.hpp>
+
+namespace occa {
+  memoryLayout_t::memoryLayout_t(const dtype_t &dtype_,
+                                 const udim_t entries_,
+                                 const occa::json &props) :
+    type(getType(props.get<std::string>("layout", "aos"))),
+    dtype(&(dtype_.self())),
+    entries(entries_),
+    width(1),
+    structBytes(dtype_.bytes()) {
+
+    OCCA_ERROR("Memory layout [" << typeToString(type) << "] requires a struct dtype,"
+               << " received [" << dtype_ << "]",
+               dtype_.isStruct());
+
+    if (type == type_t::aosoa) {
+      const int width_ = props.get("layout_width", 8);
+      OCCA_ERROR("Memory layout width must be positive, received [" << width_ << "]",
+                 width_ > 0);
+      width = width_;
+    }
+
+    addFields(fields, dtype_);
+  }
+
+  bool memoryLayout_t::isRequested(const occa::json &props) {
+    return (getType(props.get<std::string>("layout", "aos")) != type_t::aos);
+  }
+
+  memoryLayout_t::type_t memoryLayout_t::getType(const std::string &name) {
+    if (name == "aos") {
+      return type_t::aos;
+    }
+    if (name == "soa") {
+      return type_t::soa;
+    }
+    if (name == "aosoa") {
+      return type_t::aosoa;
+    }
+    OCCA_FORCE_ERROR("Unknown memory layout [" << name << "],"
+                     << " expected [aos], [soa], or [aosoa]");
+    return type_t::aos;
+  }
+
+  std::string memoryLayout_t::typeToString(const type_t type_) {
+    switch (type_) {
+      case type_t::soa:   return "soa";
+      case type_t::aosoa: return "aosoa";
+      default:            return "aos";
+    }
+  }
+
+  void memoryLayout_t::addFields(std::vector<field_t> &fields_,
+                                 const dtype_t &dtype_) {
+    const strVector &names = dtype_.structFieldNames();
+    const int fieldCount = (int) names.size();
+
+    udim_t offset = 0;
+    for (int i = 0; i < fieldCount; ++i) {
+      const dtype_t &fieldDtype = dtype_[i];
+
+      field_t field;
+      field.name   = names[i];
+      field.offset = offset;
+      field.bytes  = fieldDtype.bytes();
+
+      if (fieldDtype.isTuple()) {
+        // Only tuples of non-struct types have a type name for accessors
+        dtypeVector_t flatDtypes;
+        fieldDtype.addFlatDtypes(flatDtypes);
+
+        field.components = fieldDtype.tupleSize();
+        field.dtype = (
+          ((int) flatDtypes.size() == field.components)
+          ? flatDtypes[0]
+          : NULL
+        );
+      } else {
+        field.components = 1;
+        field.dtype = &(fieldDtype.self());
+      }
+      field.alignment = getAlignment(
+        field.dtype
+        ? field.dtype->bytes()
+        : field.bytes
+      );
+
+      fields_.push_back(field);
+      offset += field.bytes;
+    }
+  }
+
+  udim_t memoryLayout_t::getAlignment(const udim_t bytes_) {
+    // Largest power of two dividing the value size, up to 16 bytes
+    udim_t alignment = 1;
+    while ((alignment < 16) && !(bytes_ % (2 * alignment))) {
+      alignment *= 2;
+    }
+    return alignment;
+  }
+
+  udim_t memoryLayout_t::soaOffset(const field_t &field,
+                                   const udim_t entries_) const {
+    udim_t offset = 0;
+    for (const field_t &other : fields) {
+      offset = (offset + other.alignment - 1) / other.alignment * other.alignment;
+      if (&other == &field) {
+        break;
+      }
+      offset += entries_ * other.bytes;
+    }
+    return offset;
+  }
+
+  udim_t memoryLayout_t::soaBytes(const udim_t entries_) const {
+    // Round up to the largest alignment so AoSoA blocks stay aligned
+    udim_t alignment = 1;
+    for (const field_t &field : fields) {
+      alignment = std::max(alignment, field.alignment);
+    }
+    const field_t &lastField = fields.back();
+    const udim_t end = soaOffset(lastField, entries_) + (entries_ * lastField.bytes);
+    return (end + alignment - 1) / alignment * alignment;
+  }
+
+  udim_t memoryLayout_t::bytes() const {
+    return bytes(entries);
+  }
+
+  udim_t memoryLayout_t::bytes(const udim_t entries_) const {
+    switch (type) {
+      case type_t::soa:
+        return soaBytes(entries_);
+      case type_t::aosoa: {
+        // AoSoA pads the last block
+        const udim_t blocks = (entries_ + width - 1) / width;
+        return blocks * soaBytes(width);
+      }
+      default:
+        return entries_ * structBytes;
+    }
+  }
+
+  bool memoryLayout_t::matches(const memoryLayout_t &other) const {
+    return (
+      (type == other.type)
+      && (*dtype == *(other.dtype))
+      && (entries == other.entries)
+      && (width == other.width)
+    );
+  }
+
+  udim_t memoryLayout_t::fieldOffset(const field_t &field,
+                                     const udim_t entry,
+                                     const udim_t entries_) const {
+    switch (type) {
+      case type_t::soa:
+        return soaOffset(field, entries_) + (entry * field.bytes);
+      case type_t::aosoa:
+        return (
+          ((entry / width) * soaBytes(width))
+          + soaOffset(field, width)
+          + ((entry % width) * field.bytes)
+        );
+      default:
+        return (entry * structBytes) + field.offset;
+    }
+  }
+
+  void memoryLayout_t::getStagingRange(const udim_t firstEntry,
+                                       const udim_t count,
+                                       udim_t &stagingStart,
+                                       udim_t &stagingEntries) const {
+    if (type != type_t::aosoa) {
+      stagingStart = firstEntry;
+      stagingEntries = count;
+      return;
+    }
+    const udim_t lastBlock = (firstEntry + count + width - 1) / width;
+    stagingStart = (firstEntry / width) * width;
+    stagingEntries = (lastBlock * width) - stagingStart;
+  }
+
+  void memoryLayout_t::transpose(char *staging,
+                                 const char *aos,
+                                 const udim_t stagingStart,
+                                 const udim_t stagingEntries,
+                                 const udim_t firstEntry,
+                                 const udim_t count,
+                                 const bool toStaging) const {
+    const udim_t stagingOffset = firstEntry - stagingStart;
+
+    for (const field_t &field : fields) {
+      const char *aosField = aos + field.offset;
+      for (udim_t i = 0; i < count; ++i) {
+        char *stagingPtr = (
+          staging + fieldOffset(field, stagingOffset + i, stagingEntries)
+        );
+        char *aosPtr = (char*) (aosField + (i * structBytes));
+        if (toStaging) {
+          ::memcpy(stagingPtr, aosPtr, field.bytes);
+        } else {
+          ::memcpy(aosPtr, stagingPtr, field.bytes);
+        }
+      }
+    }
+  }
+
+  void memoryLayout_t::copyFrom(modeMemory_t *mem,
+                                const void *src,
+                                const udim_t firstEntry,
+                                const udim_t count,
+                                const occa::json &props) const {
+    if (!count) {
+      return;
+    }
+
+    // The staging buffer is freed before returning
+    occa::json syncProps = props;
+    syncProps["async"] = false;
+
+    udim_t stagingStart, stagingEntries;
+    getStagingRange(firstEntry, count, stagingStart, stagingEntries);
+
+    std::vector<char> staging(bytes(stagingEntries));
+
+    if (type == type_t::aosoa) {
+      const udim_t stagingBytes = staging.size();
+      const udim_t offset = (stagingStart / width) * soaBytes(width);
+
+      // Blocks which are partially written keep their other entries
+      const udim_t end = firstEntry + count;
+      if ((firstEntry != stagingStart)
+          || ((end < entries) && (end != (stagingStart + stagingEntries)))) {
+        mem->copyTo(&(staging[0]), stagingBytes, offset, syncProps);
+      }
+
+      transpose(&(staging[0]), (const char*) src,
+                stagingStart, stagingEntries,
+                firstEntry, count,
+                true);
+
+      mem->copyFrom(&(staging[0]), stagingBytes, offset, syncProps);
+      return;
+    }
+
+    transpose(&(staging[0]), (const char*) src,
+              stagingStart, stagingEntries,
+              firstEntry, count,
+              true);
+
+    // Each field is a contiguous range in both the staging buffer and device memory
+    for (const field_t &field : fields) {
+      mem->copyFrom(&(staging[fieldOffset(field, 0, count)]),
+                    count * field.bytes,
+                    fieldOffset(field, firstEntry, entries),
+                    syncProps);
+    }
+  }
+
+  void memoryLayout_t::copyTo(void *dest,
+                              const modeMemory_t *mem,
+                              const udim_t firstEntry,
+                              const udim_t count,
+                              const occa::json &props) const {
+    if (!count) {
+      return;
+    }
+
+    occa::json syncProps = props;
+    syncProps["async"] = false;
+
+    udim_t stagingStart, stagingEntries;
+    getStagingRange(firstEntry, count, stagingStart, stagingEntries);
+
+    std::vector<char> staging(bytes(stagingEntries));
+
+    if (type == type_t::aosoa) {
+      mem->copyTo(&(staging[0]),
+                  staging.size(),
+                  (stagingStart / width) * soaBytes(width),
+                  syncProps);
+    } else {
+      for (const field_t &field : fields) {
+        mem->copyTo(&(staging[fieldOffset(field, 0, count)]),
+                    count * field.bytes,
+                    fieldOffset(field, firstEntry, entries),
+                    syncProps);
+      }
+    }
+
+    transpose(&(staging[0]), (const char*) dest,
+              stagingStart, stagingEntries,
+              firstEntry, count,
+              false);
+  }
+
+  occa::json memoryLayout_t::getDefines(const std::string &name,
+                                        const dtype_t &dtype_,
+                                        const memoryLayout_t *layout,
+                                        const bool isConst) {
+    OCCA_ERROR("Field accessors require a struct dtype, received [" << dtype_ << "]",
+               dtype_.isStruct());
+
+    std::vector<field_t> aosFields;
+    if (!layout) {
+      addFields(aosFields, dtype_);
+    }
+    const std::vector<field_t> &fields_ = layout ? layout->fields : aosFields;
+
+    const type_t type_ = layout ? layout->type : type_t::aos;
+    const udim_t structBytes_ = dtype_.bytes();
+    const udim_t entries_ = layout ? layout->entries : 0;
+    const udim_t width_ = layout ? layout->width : 1;
+
+    occa::json defines;
+    defines.asObject();
+
+    for (const field_t &field : fields_) {
+      OCCA_ERROR("Field [" << field.name << "] does not have a type name for its accessor",
+                 field.dtype && field.dtype->name().size());
+
+      std::string offset;
+      switch (type_) {
+        case type_t::soa:
+          offset = (
+            toString(layout->soaOffset(field, entries_))
+            + " + ((INDEX) * " + toString(field.bytes) + ")"
+          );
+          break;
+        case type_t::aosoa:
+          offset = (
+            "(((INDEX) / " + toString(width_) + ") * " + toString(layout->soaBytes(width_)) + ")"
+            + " + " + toString(layout->soaOffset(field, width_))
+            + " + (((INDEX) % " + toString(width_) + ") * " + toString(field.bytes) + ")"
+          );
+          break;
+        default:
+          offset = (
+            "((INDEX) * " + toString(structBytes_) + ")"
+            + " + " + toString(field.offset)
+          );
+      }
+
+      std::string accessor = name + "_" + field.name;
+      if (field.components > 1) {
+        accessor += "(INDEX, COMPONENT)";
+        offset += " + ((COMPONENT) * " + toString(field.dtype->bytes()) + ")";
+      } else {
+        accessor += "(INDEX)";
+      }
+
+      const std::string qualifier = isConst ? "const " : "";
+      defines[accessor] = (
+        "(*((" + qualifier + field.dtype->name() + "*) (((" + qualifier + "char*) (" + name + ")) + " + offset + ")))"
+      );
+    }
+
+    return defines;
+  }
+}
@@ -0,0 +1,120 @@
+#ifndef OCCA_INTERNAL_CORE_MEMORYLAYOUT_HEADER
+#define OCCA_INTERNAL_CORE_MEMORYLAYOUT_HEADER
+
+#include <string>
+#include <vector>
+
+#include <occa/dtype.hpp>
+#include <occa/types/json.hpp>
+
+namespace occa {
+  class modeMemory_t;
+
+  //---[ Memory Layout ]----------------
+  // Device-side layout of memory holding struct dtypes
+  //
+  // The host always sees an array of structs (AoS), with fields packed
+  //   the same way dtype_t sums up the field bytes.
+  // On the device, the same entries can be stored as:
+  //   - soa:   One array per field
+  //   - aosoa: Blocks of [width] entries, each block stored as SoA
+  // Each field array starts aligned to the values its accessor reads,
+  //   so fields can be padded apart on the device.
+  //
+  // Copies from/to the host are transposed through a host staging buffer
+  //   and kernels access fields through the generated accessor defines.
+  class memoryLayout_t {
+  public:
+    enum class type_t {
+      aos, soa, aosoa
+    };
+
+    struct field_t {
+      std::string name;
+      // Tuple fields are stored as [components] consecutive values of [dtype]
+      const dtype_t *dtype;
+      int components;
+      // Offset in the host struct
+      udim_t offset;
+      udim_t bytes;
+      // Alignment of the field arrays on the device
+      udim_t alignment;
+    };
+
+    type_t type;
+    const dtype_t *dtype;
+    udim_t entries;
+    udim_t width;
+    udim_t structBytes;
+    std::vector<field_t> fields;
+
+    memoryLayout_t(const dtype_t &dtype_,
+                   const udim_t entries_,
+                   const occa::json &props);
+
+    // Returns false for the default (AoS) layout
+    static bool isRequested(const occa::json &props);
+
+    static type_t getType(const std::string &name);
+    static std::string typeToString(const type_t type_);
+
+    // Device bytes for all entries or only [entries_] entries
+    udim_t bytes() const;
+    udim_t bytes(const udim_t entries_) const;
+
+    bool matches(const memoryLayout_t &other) const;
+
+    // Byte offset of [field] for [entry] if the layout only had
+    //   [entries_] entries (used for both device memory and host staging)
+    udim_t fieldOffset(const field_t &field,
+                       const udim_t entry,
+                       const udim_t entries_) const;
+
+    void copyFrom(modeMemory_t *mem,
+                  const void *src,
+                  const udim_t firstEntry,
+                  const udim_t count,
+                  const occa::json &props) const;
+
+    void copyTo(void *dest,
+                const modeMemory_t *mem,
+                const udim_t firstEntry,
+                const udim_t count,
+                const occa::json &props) const;
+
+    // Field accessor defines: [name]_[field](index) for scalar fields
+    //   and [name]_[field](index, component) for tuple fields
+    static occa::json getDefines(const std::string &name,
+                                 const dtype_t &dtype_,
+                                 const memoryLayout_t *layout,
+                                 const bool isConst);
+
+  private:
+    static void addFields(std::vector<field_t> &fields_,
+                          const dtype_t &dtype_);
+
+    static udim_t getAlignment(const udim_t bytes_);
+
+    // Start of [field]'s array when [entries_] entries are stored as SoA
+    udim_t soaOffset(const field_t &field,
+                     const udim_t entries_) const;
+    udim_t soaBytes(const udim_t entries_) const;
+
+    // Range of blocks (AoSoA) or entries holding [firstEntry, firstEntry + count)
+    void getStagingRange(const udim_t firstEntry,
+                         const udim_t count,
+                         udim_t &stagingStart,
+                         udim_t &stagingEntries) const;
+
+    void transpose(char *staging,
+                   const char *aos,
+                   const udim_t stagingStart,
+                   const udim_t stagingEntries,
+                   const udim_t firstEntry,
+                   const udim_t count,
+                   const bool toStaging) const;
+  };
+  //====================================
+}
+
+#endif
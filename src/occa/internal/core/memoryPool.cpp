@@ -23,6 +23,11 @@ namespace occa {
       memoryPoolRing.removeRef(memPool);
       memPool->modeMemoryPool = NULL;
     }
+    if (modeDevice) {
+      for (modeMemory_t* m : reservations) {
+        modeDevice->allocationTracker.remove(m);
+      }
+    }
     if (buffer) delete buffer;
     size=0;
   }
@@ -72,6 +77,8 @@ namespace occa {
     auto pos = reservations.find(mem);
     reservations.erase(pos);
 
+    modeDevice->allocationTracker.remove(mem);
+
     /*Find how much of this mem is removed from reserved space*/
     dim_t lo = (mem->offset / alignment) * alignment; //Round down to alignment
     dim_t hi = ((mem->offset + mem->size + alignment - 1)
@@ -149,6 +156,8 @@ namespace occa {
     if (verbose) {
       io::stdout << "MemoryPool: Resizing to " << alignedBytes << " bytes\n";
     }
+    modeDevice->allocationTracker.addPoolResize(properties.get<std::string>("tag", ""),
+                                                size, alignedBytes, reserved);
 
     if (reservations.size() == 0) {
       /*
@@ -0,0 +1,132 @@
+#include <algorithm>
+
+#include <occa/internal/core/device.hpp>
+#include <occa/internal/core/stagingRing.hpp>
+#include <occa/utils/exception.hpp>
+
+namespace occa {
+  const udim_t stagingRing_t::alignment = 64;
+  const udim_t stagingRing_t::minBytes  = (1024 * 1024);
+
+  stagingRing_t::stagingRing_t(modeDevice_t *modeDevice_) :
+    modeDevice(modeDevice_),
+    ptr(NULL),
+    ringBytes(0),
+    head(0),
+    usedBytes(0),
+    peakBytes(0) {}
+
+  void* stagingRing_t::reserve(const udim_t bytes) {
+    const udim_t alignedBytes = (
+      bytes
+      ? ((bytes + alignment - 1) / alignment) * alignment
+      : alignment
+    );
+
+    usedBytes += alignedBytes;
+    peakBytes = std::max(peakBytes, usedBytes);
+
+    // Only resize while nothing is using the ring
+    if (reservations.empty() && (ringBytes < peakBytes)) {
+      if (ptr) {
+        modeDevice->freeStagingMemory(ptr);
+      }
+      ringBytes = std::max(minBytes, peakBytes);
+      ptr = (char*) modeDevice->mallocStagingMemory(ringBytes);
+      head = 0;
+    }
+
+    udim_t offset;
+    if (findSpace(alignedBytes, offset)) {
+      reservations.push_back({offset, alignedBytes, false});
+      head = offset + alignedBytes;
+      return ptr + offset;
+    }
+
+    void *overflowPtr = modeDevice->mallocStagingMemory(alignedBytes);
+    overflow[overflowPtr] = alignedBytes;
+    return overflowPtr;
+  }
+
+  bool stagingRing_t::findSpace(const udim_t bytes,
+                                udim_t &offset) const {
+    if (reservations.empty()) {
+      offset = 0;
+      return bytes <= ringBytes;
+    }
+
+    const udim_t tail = reservations.front().offset;
+    const bool isWrapped = (reservations.back().offset < tail);
+
+    if (isWrapped) {
+      offset = head;
+      return (head + bytes) <= tail;
+    }
+    if ((head + bytes) <= ringBytes) {
+      offset = head;
+      return true;
+    }
+    // Skip the end of the ring and wrap around
+    offset = 0;
+    return bytes <= tail;
+  }
+
+  void stagingRing_t::release(void *ptr_) {
+    if (!ptr_) {
+      return;
+    }
+
+    std::map<void*, udim_t>::iterator it = overflow.find(ptr_);
+    if (it != overflow.end()) {
+      usedBytes -= it->second;
+      modeDevice->freeStagingMemory(ptr_);
+      overflow.erase(it);
+      return;
+    }
+
+    const udim_t offset = (udim_t) (((char*) ptr_) - ptr);
+    bool found = false;
+    for (reservation_t &reservation : reservations) {
+      if (!reservation.released && (reservation.offset == offset)) {
+        reservation.released = true;
+        usedBytes -= reservation.bytes;
+        found = true;
+        break;
+      }
+    }
+    OCCA_ERROR("Staging buffer was not reserved from this device",
+               found);
+
+    while (reservations.size() && reservations.front().released) {
+      reservations.pop_front();
+    }
+    if (reservations.empty()) {
+      head = 0;
+    }
+  }
+
+  void stagingRing_t::free() {
+    for (auto &it : overflow) {
+      modeDevice->freeStagingMemory(it.first);
+    }
+    overflow.clear();
+    reservations.clear();
+
+    if (ptr) {
+      modeDevice->freeStagingMemory(ptr);
+    }
+    ptr = NULL;
+    ringBytes = 0;
+    head = 0;
+    usedBytes = 0;
+    peakBytes = 0;
+  }
+
+  udim_t stagingRing_t::size() const {
+    return ringBytes;
+  }
+
+  udim_t stagingRing_t::reservedBytes() const {
+    return usedBytes;
+  }
+}
@@ -0,0 +1,62 @@
+#ifndef OCCA_INTERNAL_CORE_STAGINGRING_HEADER
+#define OCCA_INTERNAL_CORE_STAGINGRING_HEADER
+
+#include <deque>
+#include <map>
+
+#include <occa/types/typedefs.hpp>
+
+namespace occa {
+  class modeDevice_t;
+
+  //---[ Staging Ring ]-----------------
+  // Host memory reused across transfers, allocated through the mode
+  //   so backends can page-lock it
+  //
+  // Reservations are carved out of a ring buffer in order and can be
+  //   released in any order. Space is reused once the oldest
+  //   reservations are released.
+  // Reservations that don't fit get a one-off allocation, and the ring
+  //   grows to the peak usage the next time it's empty.
+  class stagingRing_t {
+  public:
+    static const udim_t alignment;
+    static const udim_t minBytes;
+
+    stagingRing_t(modeDevice_t *modeDevice_);
+
+    void* reserve(const udim_t bytes);
+    void release(void *ptr_);
+
+    // Must be called before the mode device is destroyed
+    void free();
+
+    udim_t size() const;
+    udim_t reservedBytes() const;
+
+  private:
+    struct reservation_t {
+      udim_t offset;
+      udim_t bytes;
+      bool released;
+    };
+
+    modeDevice_t *modeDevice;
+
+    char *ptr;
+    udim_t ringBytes;
+    udim_t head;
+
+    udim_t usedBytes;
+    udim_t peakBytes;
+
+    std::deque<reservation_t> reservations;
+    std::map<void*, udim_t> overflow;
+
+    bool findSpace(const udim_t bytes,
+                   udim_t &offset) const;
+  };
+  //====================================
+}
+
+#endif
@@ -60,10 +60,16 @@ namespace occa {
     static const unsigned char DT_DIR = 'd';
 #endif
 
-    std::string cachePath() {
+    const int cacheVersion = 2;
+
+    std::string cacheRootPath() {
       return env::OCCA_CACHE_DIR + "cache/";
     }
 
+    std::string cachePath() {
+      return cacheRootPath() + "v" + std::to_string(cacheVersion) + "/";
+    }
+
     std::string libraryPath() {
       return env::OCCA_CACHE_DIR + "libraries/";
     }
@@ -87,6 +93,11 @@ namespace occa {
       return libraryPaths;
     }
 
+    mutex_t &getLibraryPathMutex() {
+      static mutex_t mutex;
+      return mutex;
+    }
+
     void endWithSlash(std::string &dir) {
       const int chars = (int) dir.size();
       if ((0 < chars) &&
@@ -207,13 +218,21 @@ namespace occa {
       const std::string library = path.substr(0, firstSlash);
       const std::string relativePath = path.substr(firstSlash);
 
-      libraryPathMap_t libraryPaths = getLibraryPathMap();
+      mutex_t &mutex = getLibraryPathMutex();
+      mutex.lock();
+      const libraryPathMap_t &libraryPaths = getLibraryPathMap();
       libraryPathMap_t::const_iterator it = libraryPaths.find(library);
-      if (it == libraryPaths.end()) {
+      const std::string libraryPath = (
+        (it != libraryPaths.end())
+        ? it->second
+        : ""
+      );
+      mutex.unlock();
+
+      if (!libraryPath.size()) {
         return "";
       }
-
-      return it->second + relativePath;
+      return libraryPath + relativePath;
     }
 
     std::string binaryName(const std::string &filename) {
@@ -5,6 +5,7 @@
 #include <iostream>
 
 #include <occa/types.hpp>
+#include <occa/utils/mutex.hpp>
 #include <occa/internal/io/enums.hpp>
 
 namespace occa {
@@ -23,11 +24,19 @@ namespace occa {
   namespace io {
     typedef std::map<std::string, std::string> libraryPathMap_t;
 
+    // Bumped when hashing or the cache layout changes so older
+    //   caches are left alone instead of being misread
+    extern const int cacheVersion;
+
+    std::string cacheRootPath();
     std::string cachePath();
     std::string libraryPath();
 
     std::string currentWorkingDirectory();
     libraryPathMap_t &getLibraryPathMap();
+    // Kernels can be built off the calling thread, so the library
+    //   paths are only read or updated while holding this mutex
+    mutex_t &getLibraryPathMutex();
 
     void endWithSlash(std::string &dir);
     std::string endWithSlash(const std::string &dir);
@@ -113,6 +113,39 @@ namespace occa {
           | operatorType::decrement
         );
       }
+
+      bool atomic::isMinMaxExpression(expressionStatement &exprSmnt,
+                                      std::string &functionName,
+                                      exprNode *&argument) {
+        // Cases:
+        //   @atomic i = min(i, value);
+        //   @atomic i = max(value, i);
+        if (!(expr(exprSmnt.expr).opType() & operatorType::assign)) {
+          return false;
+        }
+
+        binaryOpNode &assignNode = (binaryOpNode&) *exprSmnt.expr;
+        if (!(assignNode.rightValue->type() & exprNodeType::call)) {
+          return false;
+        }
+
+        callNode &call = (callNode&) *assignNode.rightValue;
+        const std::string callName = call.value->toString();
+        if (((callName != "min") && (callName != "max"))
+            || (call.args.size() != 2)) {
+          return false;
+        }
+
+        const std::string variable = assignNode.leftValue->toString();
+        for (int i = 0; i < 2; ++i) {
+          if (call.args[i]->toString() == variable) {
+            functionName = callName;
+            argument = call.args[1 - i];
+            return true;
+          }
+        }
+        return false;
+      }
     }
   }
 }
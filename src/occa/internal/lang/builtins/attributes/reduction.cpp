@@ -0,0 +1,90 @@
+#include <occa/internal/lang/expr.hpp>
+#include <occa/internal/lang/parser.hpp>
+#include <occa/internal/lang/statement.hpp>
+#include <occa/internal/lang/variable.hpp>
+#include <occa/internal/lang/builtins/attributes/reduction.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace attributes {
+      reduction::reduction() {}
+
+      const std::string& reduction::name() const {
+        static std::string name_ = "reduction";
+        return name_;
+      }
+
+      bool reduction::forStatementType(const int sType) const {
+        return (sType & statementType::for_);
+      }
+
+      bool reduction::isValid(const attributeToken_t &attr) const {
+        reductionVarVector reductions;
+        return getReductions(attr, reductions);
+      }
+
+      bool reduction::getReductions(const attributeToken_t &attr,
+                                    reductionVarVector &reductions) {
+        if (attr.kwargs.size()) {
+          attr.printError("[@reduction] does not take kwargs");
+          return false;
+        }
+
+        const int argCount = (int) attr.args.size();
+        if (!argCount || (argCount % 2)) {
+          attr.printError("[@reduction] expects pairs of (operator, variable) arguments");
+          return false;
+        }
+
+        for (int i = 0; i < argCount; i += 2) {
+          exprNode *opExpr = attr.args[i].expr;
+          exprNode *varExpr = attr.args[i + 1].expr;
+
+          if (!opExpr || (opExpr->type() != exprNodeType::string)) {
+            attr.printError("[@reduction] operators must be strings, such as \"+\" or \"max\"");
+            return false;
+          }
+
+          const std::string op = opExpr->to<stringNode>().value;
+          if (!isValidOperator(op)) {
+            attr.printError("[@reduction] has an invalid operator: " + op);
+            return false;
+          }
+
+          if (!varExpr || (varExpr->type() != exprNodeType::variable)) {
+            attr.printError("[@reduction] expects a declared variable after each operator");
+            return false;
+          }
+
+          reductionVar_t reductionVar;
+          reductionVar.op = op;
+          reductionVar.variable = &(varExpr->to<variableNode>().value);
+          reductions.push_back(reductionVar);
+        }
+
+        return true;
+      }
+
+      bool reduction::isValidOperator(const std::string &op) {
+        return (
+          (op == "+") || (op == "*")
+          || (op == "&") || (op == "|") || (op == "^")
+          || (op == "&&") || (op == "||")
+          || (op == "min") || (op == "max")
+        );
+      }
+
+      std::string reduction::getCombineSource(const std::string &op,
+                                              const std::string &left,
+                                              const std::string &right) {
+        if (op == "min") {
+          return "((" + right + " < " + left + ") ? " + right + " : " + left + ")";
+        }
+        if (op == "max") {
+          return "((" + left + " < " + right + ") ? " + right + " : " + left + ")";
+        }
+        return "(" + left + " " + op + " " + right + ")";
+      }
+    }
+  }
+}
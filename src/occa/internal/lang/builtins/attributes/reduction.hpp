@@ -0,0 +1,51 @@
+#ifndef OCCA_INTERNAL_LANG_BUILTINS_ATTRIBUTES_REDUCTION_HEADER
+#define OCCA_INTERNAL_LANG_BUILTINS_ATTRIBUTES_REDUCTION_HEADER
+
+#include <vector>
+
+#include <occa/internal/lang/attribute.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace attributes {
+      //---[ @reduction ]---------------
+      // Declares reductions on @outer/@inner loops:
+      //   @reduction("+", sum)
+      //   @reduction("min", lower, "max", upper)
+      //
+      // Supported operators: +, *, &, |, ^, &&, ||, min, max
+      //
+      // The reduction variable is declared outside the loop and its
+      //   initial value should be the identity of the operator
+      class reduction : public attribute_t {
+      public:
+        struct reductionVar_t {
+          std::string op;
+          variable_t *variable;
+        };
+        typedef std::vector<reductionVar_t> reductionVarVector;
+
+        reduction();
+
+        virtual const std::string& name() const;
+
+        virtual bool forStatementType(const int sType) const;
+
+        virtual bool isValid(const attributeToken_t &attr) const;
+
+        static bool getReductions(const attributeToken_t &attr,
+                                  reductionVarVector &reductions);
+
+        static bool isValidOperator(const std::string &op);
+
+        // Source code combining [left] and [right] with [op]
+        static std::string getCombineSource(const std::string &op,
+                                            const std::string &left,
+                                            const std::string &right);
+      };
+      //================================
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include <occa/internal/lang/expr.hpp>
+#include <occa/internal/lang/parser.hpp>
+#include <occa/internal/lang/statement.hpp>
+#include <occa/internal/lang/variable.hpp>
+#include <occa/internal/lang/modes/oklForStatement.hpp>
+#include <occa/internal/lang/builtins/attributes/unroll.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace attributes {
+      unroll::unroll() {}
+
+      const std::string& unroll::name() const {
+        static std::string name_ = "unroll";
+        return name_;
+      }
+
+      bool unroll::forStatementType(const int sType) const {
+        return (sType & statementType::for_);
+      }
+
+      bool unroll::isValid(const attributeToken_t &attr) const {
+        if (attr.kwargs.size()) {
+          attr.printError("[@unroll] does not take kwargs");
+          return false;
+        }
+        if (1 < attr.args.size()) {
+          attr.printError("[@unroll] takes at most 1 argument");
+          return false;
+        }
+        if (!attr.args.size()) {
+          return true;
+        }
+
+        exprNode *expr = attr.args[0].expr;
+        bool error = !(expr && expr->canEvaluate());
+        if (!error) {
+          primitive value = expr->evaluate();
+          error = !(value.isInteger() && (0 < (int) value));
+        }
+        if (error) {
+          attr.printError("[@unroll] argument must be a positive integer");
+          return false;
+        }
+        return true;
+      }
+
+      bool unroll::applyCodeTransformations(blockStatement &root,
+                                            unrollPragmaCallback getPragmaSource) {
+        bool success = true;
+        statementArray::from(root)
+            .flatFilterByStatementType(statementType::for_, "unroll")
+            .forEach([&](statement_t *smnt) {
+                forStatement &forSmnt = (forStatement&) *smnt;
+
+                if (forSmnt.hasAttribute("outer") || forSmnt.hasAttribute("inner")) {
+                  forSmnt.printError("[@unroll] cannot be used on [@outer] or [@inner] loops");
+                  success = false;
+                  return;
+                }
+
+                const std::string pragmaSource = getPragmaSource(
+                  getUnrollCount(forSmnt)
+                );
+                if (!pragmaSource.size()) {
+                  return;
+                }
+
+                blockStatement &parent = *(forSmnt.up);
+                parent.addBefore(
+                  forSmnt,
+                  *(new pragmaStatement(&parent,
+                                        pragmaToken(forSmnt.source->origin,
+                                                    pragmaSource)))
+                );
+              });
+        return success;
+      }
+
+      int unroll::getUnrollCount(forStatement &forSmnt) {
+        attributeToken_t &attr = forSmnt.attributes["unroll"];
+        if (attr.args.size()) {
+          return (int) attr.args[0].expr->evaluate();
+        }
+
+        const bool printErrors = false;
+        okl::oklForStatement oklForSmnt(forSmnt, "@unroll", printErrors);
+        exprNode *countExpr = oklForSmnt.getIterationCount();
+        if (!countExpr) {
+          return 0;
+        }
+
+        int count = 0;
+        if (countExpr->canEvaluate()) {
+          primitive value = countExpr->evaluate();
+          if (value.isInteger() && (0 < (int) value)) {
+            count = (int) value;
+          }
+        }
+        delete countExpr;
+
+        return count;
+      }
+    }
+  }
+}
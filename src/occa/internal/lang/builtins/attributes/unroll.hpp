@@ -0,0 +1,47 @@
+#ifndef OCCA_INTERNAL_LANG_BUILTINS_ATTRIBUTES_UNROLL_HEADER
+#define OCCA_INTERNAL_LANG_BUILTINS_ATTRIBUTES_UNROLL_HEADER
+
+#include <functional>
+
+#include <occa/internal/lang/attribute.hpp>
+
+namespace occa {
+  namespace lang {
+    class blockStatement;
+    class forStatement;
+
+    // Returns the pragma source for unrolling [count] iterations,
+    //   where a [count] of 0 means the trip count is unknown.
+    // An empty string skips adding the pragma
+    typedef std::function<std::string (const int count)> unrollPragmaCallback;
+
+    namespace attributes {
+      //---[ @unroll ]------------------
+      // Unrolls regular for-loops:
+      //   @unroll    -> Fully unroll if the trip count is known
+      //   @unroll(n) -> Unroll by a factor of n
+      //
+      // Loop bounds using specialized kernel arguments become
+      //   compile-time constants, giving a known trip count
+      class unroll : public attribute_t {
+      public:
+        unroll();
+
+        virtual const std::string& name() const;
+
+        virtual bool forStatementType(const int sType) const;
+
+        virtual bool isValid(const attributeToken_t &attr) const;
+
+        static bool applyCodeTransformations(blockStatement &root,
+                                             unrollPragmaCallback getPragmaSource);
+
+        // Unroll factor from @unroll(n) or the trip count, 0 if unknown
+        static int getUnrollCount(forStatement &forSmnt);
+      };
+      //================================
+    }
+  }
+}
+
+#endif
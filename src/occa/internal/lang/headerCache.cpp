@@ -0,0 +1,117 @@
+#include <occa/internal/io.hpp>
+#include <occa/internal/lang/headerCache.hpp>
+#include <occa/internal/lang/tokenizer.hpp>
+
+namespace occa {
+  namespace lang {
+    headerCache_t headerCache;
+
+    //---[ Cached Header ]--------------
+    cachedHeader_t::cachedHeader_t(const std::string &filename,
+                                   const std::string &content,
+                                   const hash_t &contentHash_) :
+      file(new file_t(filename, content)),
+      contentHash(contentHash_),
+      canReplay(true) {
+      // Tokens can be shared across threads so we can't reference count the file
+      file->dontUseRefs();
+
+      tokenizer_t tokenizer(file);
+      token_t *token;
+      while (!tokenizer.isEmpty()) {
+        tokenizer.setNext(token);
+        tokens.push_back(token);
+      }
+      canReplay = !tokenizer.errors;
+
+      const int tokenCount = (int) tokens.size();
+      for (int i = 0; canReplay && (i < (tokenCount - 1)); ++i) {
+        if (!(token_t::safeOperatorType(tokens[i]) & operatorType::hash)) {
+          continue;
+        }
+        token_t *directive = tokens[i + 1];
+        if (directive->type() & tokenType::identifier) {
+          const std::string &name = directive->to<identifierToken>().value;
+          canReplay = (name != "include") && (name != "line");
+        }
+      }
+
+      // Popping the header source always creates a newline
+      if (!tokenCount
+          || !(tokens[tokenCount - 1]->type() & tokenType::newline)) {
+        tokens.push_back(
+          new newlineToken(
+            tokenCount
+            ? tokens[tokenCount - 1]->origin
+            : fileOrigin(*file)
+          )
+        );
+      }
+    }
+
+    cachedHeader_t::~cachedHeader_t() {
+      freeTokenVector(tokens);
+    }
+
+    void cachedHeader_t::replay(tokenList &outputTokens,
+                                const fileOrigin &includeOrigin) const {
+      // Same as fileOrigin::push, all tokens share the parent origin
+      fileOrigin *up = new fileOrigin(includeOrigin);
+      up->fromInclude = true;
+
+      const int tokenCount = (int) tokens.size();
+      for (int i = 0; i < tokenCount; ++i) {
+        token_t *token = tokens[i]->clone();
+        token->origin.setUp(up);
+        outputTokens.push_back(token);
+      }
+    }
+    //==================================
+
+    //---[ Header Cache ]---------------
+    headerCache_t::headerCache_t() {}
+
+    headerCache_t::~headerCache_t() {
+      headers.clear();
+      for (file_t *file : files) {
+        delete file;
+      }
+      mutex.free();
+    }
+
+    cachedHeaderPtr headerCache_t::get(const std::string &filename) {
+      const std::string content = io::read(filename);
+      const hash_t contentHash = hash(content);
+
+      mutex.lock();
+      headerMap::iterator it = headers.find(filename);
+      if ((it != headers.end()) &&
+          (it->second->contentHash == contentHash)) {
+        cachedHeaderPtr header = it->second;
+        mutex.unlock();
+        return header;
+      }
+      mutex.unlock();
+
+      // Tokenize outside of the lock, worst case two threads tokenize the same header
+      cachedHeaderPtr header = std::make_shared<cachedHeader_t>(filename,
+                                                                content,
+                                                                contentHash);
+
+      mutex.lock();
+      headers[filename] = header;
+      files.push_back(header->file);
+      mutex.unlock();
+
+      return header;
+    }
+
+    size_t headerCache_t::size() {
+      mutex.lock();
+      const size_t headerCount = headers.size();
+      mutex.unlock();
+      return headerCount;
+    }
+    //==================================
+  }
+}
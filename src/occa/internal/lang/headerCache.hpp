@@ -0,0 +1,70 @@
+#ifndef OCCA_INTERNAL_LANG_HEADERCACHE_HEADER
+#define OCCA_INTERNAL_LANG_HEADERCACHE_HEADER
+
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <occa/utils/hash.hpp>
+#include <occa/utils/mutex.hpp>
+#include <occa/internal/lang/file.hpp>
+#include <occa/internal/lang/token.hpp>
+
+namespace occa {
+  namespace lang {
+    typedef std::list<token_t*> tokenList;
+
+    //---[ Cached Header ]--------------
+    // Tokenized #include'd header, shared across parsers and threads
+    //
+    // Tokens are stored before preprocessing since including a header
+    //   can change the macro state, so the preprocessor still runs
+    //   on the replayed tokens and only the lexing is skipped
+    class cachedHeader_t {
+    public:
+      file_t *file;
+      hash_t contentHash;
+      tokenVector tokens;
+      // Headers with directives that read directly from the tokenizer
+      //   (#include, #line) or that failed to tokenize are not replayed
+      bool canReplay;
+
+      cachedHeader_t(const std::string &filename,
+                     const std::string &content,
+                     const hash_t &contentHash_);
+      ~cachedHeader_t();
+
+      void replay(tokenList &outputTokens,
+                  const fileOrigin &includeOrigin) const;
+    };
+
+    typedef std::shared_ptr<const cachedHeader_t> cachedHeaderPtr;
+    //==================================
+
+    //---[ Header Cache ]---------------
+    class headerCache_t {
+    private:
+      typedef std::map<std::string, cachedHeaderPtr> headerMap;
+
+      mutex_t mutex;
+      headerMap headers;
+      // Tokens in flight can still point to files from replaced headers
+      std::vector<file_t*> files;
+
+    public:
+      headerCache_t();
+      ~headerCache_t();
+
+      // Returns the cached header, re-tokenizing it if its contents changed
+      cachedHeaderPtr get(const std::string &filename);
+
+      size_t size();
+    };
+
+    extern headerCache_t headerCache;
+    //==================================
+  }
+}
+
+#endif
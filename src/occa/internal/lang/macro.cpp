@@ -795,7 +795,23 @@ namespace occa {
       tokens.erase(tokens.begin());
 
       macro_t &macro = *(new macro_t(pp_, macroToken));
-      macro.setDefinition(tokens);
+
+      // Function-like defines (e.g. NAME(ARGS)) also need the (
+      //   directly after the macro name
+      const bool isFunctionLike = (
+        tokens.size()
+        && (tokens[0]->getOpType() & operatorType::parenthesesStart)
+        && (macroToken.origin.distanceTo(tokens[0]->origin) == 0)
+      );
+      if (isFunctionLike) {
+        delete tokens[0];
+        tokens.erase(tokens.begin());
+
+        macro.isFunctionLike = true;
+        macro.loadFunctionLikeDefinition(tokens);
+      } else {
+        macro.setDefinition(tokens);
+      }
       freeTokenVector(tokens);
 
       // Macro clones the token
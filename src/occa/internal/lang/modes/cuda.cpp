@@ -60,6 +60,12 @@ namespace occa {
         return name;
       }
 
+      std::string cudaParser::getInnerSize(const int loopIndex) {
+        std::string name = "blockDim.";
+        name += 'x' + (char) loopIndex;
+        return name;
+      }
+
       std::string cudaParser::launchBoundsAttribute(const int innerDims[3]) {
         const int innerTotal{innerDims[0]*innerDims[1]*innerDims[2]};
         const std::string lbAttr = "__launch_bounds__(" + std::to_string(innerTotal) + ")";
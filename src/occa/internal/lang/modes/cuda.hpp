@@ -27,6 +27,8 @@ namespace occa {
 
         virtual std::string getInnerIterator(const int loopIndex) override;
 
+        virtual std::string getInnerSize(const int loopIndex) override;
+
         virtual std::string launchBoundsAttribute(const int innerDims[3]) override;
 
         void updateConstToConstant();
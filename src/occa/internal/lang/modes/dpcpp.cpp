@@ -77,6 +77,11 @@ namespace occa
         return "item_.get_local_id(" + occa::toString(dpcppDimensionOrder(loopIndex)) + ")";
       }
 
+      std::string dpcppParser::getInnerSize(const int loopIndex)
+      {
+        return "item_.get_local_range(" + occa::toString(dpcppDimensionOrder(loopIndex)) + ")";
+      }
+
       std::string dpcppParser::launchBoundsAttribute(const int innerDims[3])
       {
         std::stringstream ss; 
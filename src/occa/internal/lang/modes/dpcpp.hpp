@@ -31,6 +31,7 @@ namespace occa
 
         virtual std::string getOuterIterator(const int loopIndex) override;
         virtual std::string getInnerIterator(const int loopIndex) override;
+        virtual std::string getInnerSize(const int loopIndex) override;
         virtual std::string launchBoundsAttribute(const int innerDims[3]) override;
 
         void addExtensions();
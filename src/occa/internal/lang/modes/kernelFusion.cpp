@@ -0,0 +1,633 @@
+#include <algorithm>
+#include <set>
+
+#include <occa/internal/lang/expr.hpp>
+#include <occa/internal/lang/statement.hpp>
+#include <occa/internal/lang/variable.hpp>
+#include <occa/internal/lang/builtins/types.hpp>
+#include <occa/internal/lang/modes/kernelFusion.hpp>
+#include <occa/internal/lang/modes/okl.hpp>
+#include <occa/internal/lang/modes/oklForStatement.hpp>
+#include <occa/internal/lang/modes/sharedMemoryAccesses.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace okl {
+      kernelFusion::kernelFusion(blockStatement &root_) :
+        root(root_) {}
+
+      kernelFusion::~kernelFusion() {
+        // Loop clones are only left behind if fusing failed
+        for (stage_t &stage : stages) {
+          if (stage.loops.size()) {
+            delete stage.loops[0];
+          }
+        }
+      }
+
+      bool kernelFusion::setup(const json &fusion) {
+        if (!fusion.isObject()
+            || !fusion["name"].isString()
+            || !fusion["stages"].isArray()
+            || !fusion["stages"].array().size()) {
+          occa::printError("[okl/fusion] must be an object with a kernel [name] and its [stages]");
+          return false;
+        }
+
+        name = (std::string) fusion["name"];
+        if (root.hasDirectlyInScope(name)) {
+          occa::printError("[okl/fusion] kernel name [" + name + "] is already used");
+          return false;
+        }
+
+        if (fusion.has("intermediates")) {
+          intermediates = fusion["intermediates"].toVector<std::string>();
+        }
+
+        for (const json &stageInfo : fusion["stages"].array()) {
+          if (!stageInfo.isObject() || !stageInfo["kernel"].isString()) {
+            occa::printError("[okl/fusion] stages must be objects with a [kernel] name");
+            return false;
+          }
+          const std::string kernelName = stageInfo["kernel"];
+
+          stage_t stage;
+          stage.kernelSmnt = NULL;
+          root.children
+            .forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
+              if (kernelSmnt.function().name() == kernelName) {
+                stage.kernelSmnt = &kernelSmnt;
+              }
+            });
+          if (!stage.kernelSmnt) {
+            occa::printError("[okl/fusion] kernel [" + kernelName + "] not found");
+            return false;
+          }
+
+          if (stageInfo.has("arguments")) {
+            const json &arguments = stageInfo["arguments"];
+            if (!arguments.isObject()) {
+              occa::printError("[okl/fusion] stage [arguments] must be an object of"
+                               " { argument: fusedArgument }");
+              return false;
+            }
+            for (const auto &it : arguments.object()) {
+              if (!it.second.isString()) {
+                occa::printError("[okl/fusion] stage [arguments] must be an object of"
+                                 " { argument: fusedArgument }");
+                return false;
+              }
+              stage.argumentNames[it.first] = (std::string) it.second;
+            }
+          }
+
+          std::vector<forStatement*> loops;
+          if (!getLoopNest(*stage.kernelSmnt, loops)) {
+            stage.kernelSmnt->printError("Fused kernels must be a single nest of [@outer]"
+                                         " and [@inner] loops");
+            return false;
+          }
+
+          // Fuse clones, keeping the original kernels intact
+          forStatement &loopClone = (forStatement&) loops[0]->clone();
+          getLoopNest(loopClone, stage.loops);
+          stages.push_back(stage);
+        }
+
+        for (const std::string &intermediate : intermediates) {
+          bool isUsed = false;
+          for (stage_t &stage : stages) {
+            for (variable_t *arg : stage.kernelSmnt->function().args) {
+              isUsed |= (arg && (getFusedArgumentName(stage, *arg) == intermediate));
+            }
+          }
+          if (!isUsed) {
+            occa::printError("[okl/fusion] intermediate [" + intermediate
+                             + "] is not a stage argument");
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      bool kernelFusion::fuse() {
+        function_t *fusedFunction = setupFusedFunction();
+        if (!fusedFunction) {
+          return false;
+        }
+
+        std::map<std::string, variable_t*> intermediateVariables;
+        const auto freeFusedVariables = [&]() {
+          fusedFunction->free();
+          delete fusedFunction;
+          for (auto &it : intermediateVariables) {
+            delete it.second;
+          }
+        };
+
+        for (stage_t &stage : stages) {
+          if (!replaceStageVariables(stage, *fusedFunction, intermediateVariables)) {
+            freeFusedVariables();
+            return false;
+          }
+        }
+
+        for (stage_t &stage : stages) {
+          std::string varName;
+          if (hasHiddenVariables(*(stage.loops[0]), varName)) {
+            stage.kernelSmnt->printError("Fused argument or iterator [" + varName + "] is hidden"
+                                         " by a variable with the same name");
+            freeFusedVariables();
+            return false;
+          }
+        }
+
+        stage_t &firstStage = stages[0];
+        for (stage_t &stage : stages) {
+          if (!haveSameLoopNests(firstStage, stage)) {
+            stage.kernelSmnt->printError(
+              "Fused kernels must have the same [@outer] and [@inner] loops as ["
+              + firstStage.kernelSmnt->function().name() + "]"
+            );
+            freeFusedVariables();
+            return false;
+          }
+        }
+
+        // The first stage's loops become the fused kernel's loops
+        forStatement &fusedForSmnt = *(firstStage.loops[0]);
+        forStatement &fusedInnerSmnt = *(firstStage.loops.back());
+
+        std::vector<variable_t*> iterators, innerIterators;
+        for (forStatement *forSmnt : firstStage.loops) {
+          variable_t *iterator = oklForStatement(*forSmnt, "", false).iterator;
+          iterators.push_back(iterator);
+          if (forSmnt->hasAttribute("inner")) {
+            innerIterators.push_back(iterator);
+          }
+        }
+
+        // Each stage's body gets its own scope to avoid name clashes
+        for (stage_t &stage : stages) {
+          moveLoopBody(*(stage.loops.back()), fusedInnerSmnt);
+        }
+        for (stage_t &stage : stages) {
+          if (&stage != &firstStage) {
+            delete stage.loops[0];
+          }
+          stage.loops.clear();
+        }
+
+        for (auto &it : intermediateVariables) {
+          if (!hasPrivateIntermediateAccesses(fusedForSmnt, iterators, innerIterators, *(it.second))) {
+            fusedForSmnt.printError("Intermediate [" + it.first + "] must be accessed with the same"
+                                    " index by every stage, using each [@inner] iterator"
+                                    " and no other variables");
+            delete &fusedForSmnt;
+            freeFusedVariables();
+            return false;
+          }
+        }
+
+        const int dependentStage = getDependentStage(fusedInnerSmnt, intermediateVariables);
+        if (dependentStage >= 0) {
+          stages[dependentStage].kernelSmnt->printError(
+            "Fused kernel stages can only use results from their own thread in earlier stages"
+          );
+          delete &fusedForSmnt;
+          freeFusedVariables();
+          return false;
+        }
+
+        for (auto &it : intermediateVariables) {
+          variable_t &var = *(it.second);
+          replaceIntermediateAccesses(fusedForSmnt, var);
+
+          declarationStatement &declSmnt = *(new declarationStatement(&fusedInnerSmnt,
+                                                                      var.source));
+          fusedInnerSmnt.addFirst(declSmnt);
+          declSmnt.addDeclaration(var);
+        }
+
+        functionDeclStatement &fusedKernelSmnt = *(
+          new functionDeclStatement(&root,
+                                    *fusedFunction)
+        );
+        fusedKernelSmnt.attributes = firstStage.kernelSmnt->attributes;
+        fusedKernelSmnt.set(fusedForSmnt);
+        root.add(fusedKernelSmnt);
+
+        return true;
+      }
+
+      bool kernelFusion::getLoopNest(functionDeclStatement &kernelSmnt,
+                                     std::vector<forStatement*> &loops) {
+        if ((kernelSmnt.size() != 1)
+            || !(kernelSmnt[0]->type() & statementType::for_)
+            || !kernelSmnt[0]->hasAttribute("outer")) {
+          return false;
+        }
+        return getLoopNest((forStatement&) *kernelSmnt[0], loops);
+      }
+
+      bool kernelFusion::getLoopNest(forStatement &forSmnt,
+                                     std::vector<forStatement*> &loops) {
+        forStatement *loopSmnt = &forSmnt;
+        loops.push_back(loopSmnt);
+        while ((loopSmnt->size() == 1) && isOklForLoop((*loopSmnt)[0])) {
+          loopSmnt = (forStatement*) (*loopSmnt)[0];
+          loops.push_back(loopSmnt);
+        }
+        return loopSmnt->hasAttribute("inner");
+      }
+
+      std::string kernelFusion::getAttributesSignature(statement_t &smnt) {
+        std::string signature;
+        for (auto &it : smnt.attributes) {
+          signature += '@' + it.first + '(';
+          for (attributeArg_t &arg : it.second.args) {
+            if (arg.expr) {
+              signature += arg.expr->toString();
+            }
+            for (auto &argIt : arg.attributes) {
+              signature += '@' + argIt.first;
+            }
+            signature += ',';
+          }
+          signature += ')';
+        }
+        return signature;
+      }
+
+      bool kernelFusion::isIntermediate(const std::string &argName) const {
+        for (const std::string &intermediate : intermediates) {
+          if (intermediate == argName) {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      std::string kernelFusion::getFusedArgumentName(stage_t &stage,
+                                                     variable_t &arg) const {
+        std::map<std::string, std::string>::const_iterator it = (
+          stage.argumentNames.find(arg.name())
+        );
+        if (it != stage.argumentNames.end()) {
+          return it->second;
+        }
+        return arg.name();
+      }
+
+      bool kernelFusion::haveSameArgumentTypes(variable_t &arg,
+                                               variable_t &otherArg) {
+        // Only differing by const is fine, such as an input of one stage
+        //   being the output of another
+        vartype_t vartype = arg.vartype;
+        vartype_t otherVartype = otherArg.vartype;
+        vartype -= const_;
+        otherVartype -= const_;
+        return vartype == otherVartype;
+      }
+
+      function_t* kernelFusion::setupFusedFunction() {
+        function_t &fusedFunction = (function_t&) stages[0].kernelSmnt->function().clone();
+        fusedFunction.source->value = name;
+        fusedFunction.free();
+
+        for (stage_t &stage : stages) {
+          for (variable_t *arg : stage.kernelSmnt->function().args) {
+            if (!arg) {
+              continue;
+            }
+            const std::string fusedName = getFusedArgumentName(stage, *arg);
+            if (isIntermediate(fusedName)) {
+              continue;
+            }
+
+            variable_t *fusedArg = NULL;
+            for (variable_t *existingArg : fusedFunction.args) {
+              if (existingArg->name() == fusedName) {
+                fusedArg = existingArg;
+              }
+            }
+
+            if (!fusedArg) {
+              fusedFunction.addArgument(*arg);
+              fusedFunction.args.back()->setName(fusedName);
+              continue;
+            }
+
+            if (!haveSameArgumentTypes(*arg, *fusedArg)) {
+              arg->printError("Argument type doesn't match the fused argument ["
+                              + fusedName + "]");
+              fusedFunction.free();
+              delete &fusedFunction;
+              return NULL;
+            }
+            if (!arg->vartype.has(const_)) {
+              fusedArg->vartype -= const_;
+            }
+          }
+        }
+
+        return &fusedFunction;
+      }
+
+      bool kernelFusion::replaceStageVariables(stage_t &stage,
+                                               function_t &fusedFunction,
+                                               std::map<std::string, variable_t*> &intermediateVariables) {
+        forStatement &loopSmnt = *(stage.loops[0]);
+
+        for (variable_t *arg : stage.kernelSmnt->function().args) {
+          if (!arg) {
+            continue;
+          }
+          const std::string fusedName = getFusedArgumentName(stage, *arg);
+
+          if (!isIntermediate(fusedName)) {
+            for (variable_t *fusedArg : fusedFunction.args) {
+              if (fusedArg->name() == fusedName) {
+                loopSmnt.replaceVariable(*arg, *fusedArg);
+              }
+            }
+            continue;
+          }
+
+          // Intermediates become a value of the pointed type
+          //   T *tmp -> T _occa_fused_tmp
+          if ((arg->vartype.pointers.size() != 1) || arg->vartype.arrays.size()) {
+            arg->printError("Intermediate arguments must be pointers");
+            return false;
+          }
+
+          vartype_t vartype = arg->vartype;
+          vartype.pointers.clear();
+          vartype -= const_;
+
+          variable_t *&var = intermediateVariables[fusedName];
+          if (!var) {
+            identifierToken varSource(arg->source->origin,
+                                      "_occa_fused_" + fusedName);
+            var = new variable_t(vartype, &varSource);
+          } else if (!(vartype == var->vartype)) {
+            arg->printError("Argument type doesn't match the intermediate ["
+                            + fusedName + "]");
+            return false;
+          }
+          loopSmnt.replaceVariable(*arg, *var);
+        }
+
+        // Iterators are shared with the first stage's loops
+        stage_t &firstStage = stages[0];
+        if (&stage != &firstStage) {
+          const int loopCount = (int) std::min(stage.loops.size(), firstStage.loops.size());
+          for (int i = 0; i < loopCount; ++i) {
+            oklForStatement oklForSmnt(*(stage.loops[i]), "", false);
+            oklForStatement fusedOklForSmnt(*(firstStage.loops[i]), "", false);
+            if (!oklForSmnt.isValid() || !fusedOklForSmnt.isValid()) {
+              return false;
+            }
+            loopSmnt.replaceVariable(*oklForSmnt.iterator,
+                                     *fusedOklForSmnt.iterator);
+          }
+        }
+
+        return true;
+      }
+
+      bool kernelFusion::hasHiddenVariables(forStatement &forSmnt,
+                                            std::string &varName) {
+        // Renamed arguments and shared iterators can be hidden by a stage's
+        //   own variables, such as an iterator [b] and an argument renamed to [b]
+        std::map<std::string, variable_t*> declaredVariables;
+        statementArray::from(forSmnt)
+          .nestedForEachDeclaration([&](variableDeclaration &decl) {
+            declaredVariables[decl.variable().name()] = &(decl.variable());
+          });
+
+        bool hasHiddenVariable = false;
+        statementArray::from(forSmnt)
+          .flatFilterByExprType(exprNodeType::variable)
+          .forEach([&](smntExprNode smntExpr) {
+            variable_t &var = ((variableNode*) smntExpr.node)->value;
+            auto it = declaredVariables.find(var.name());
+            if ((it != declaredVariables.end()) && (it->second != &var)) {
+              hasHiddenVariable = true;
+              varName = var.name();
+            }
+          });
+        return hasHiddenVariable;
+      }
+
+      bool kernelFusion::haveSameLoopNests(stage_t &stage,
+                                           stage_t &otherStage) {
+        if (stage.loops.size() != otherStage.loops.size()) {
+          return false;
+        }
+
+        const int loopCount = (int) stage.loops.size();
+        for (int i = 0; i < loopCount; ++i) {
+          forStatement &forSmnt = *(stage.loops[i]);
+          forStatement &otherForSmnt = *(otherStage.loops[i]);
+          if ((getAttributesSignature(forSmnt) != getAttributesSignature(otherForSmnt))
+              || !oklForStatement::haveSameIterationSpace(forSmnt, otherForSmnt)) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      void kernelFusion::moveLoopBody(forStatement &forSmnt,
+                                      forStatement &fusedForSmnt) {
+        blockStatement &blockSmnt = *(new blockStatement(&fusedForSmnt,
+                                                         forSmnt.source));
+
+        // Move the body declarations, the iterator is freed with its loop
+        for (statement_t *smnt : forSmnt.children) {
+          if (smnt->type() & statementType::declaration) {
+            for (variableDeclaration &decl : ((declarationStatement*) smnt)->declarations) {
+              const std::string varName = decl.variable().name();
+              keywordMapIterator it = forSmnt.scope.keywords.find(varName);
+              if (it != forSmnt.scope.keywords.end()) {
+                blockSmnt.scope.keywords[varName] = it->second;
+                forSmnt.scope.keywords.erase(it);
+              }
+            }
+          }
+          blockSmnt.add(*smnt);
+        }
+        forSmnt.children.clear();
+
+        fusedForSmnt.add(blockSmnt);
+      }
+
+      int kernelFusion::getDependentStage(forStatement &fusedInnerSmnt,
+                                          const std::map<std::string, variable_t*> &intermediateVariables) {
+        // Same check as fusing @inner loops, comparing each stage's
+        //   body with the stages before it
+        functionDeclStatement &kernelSmnt = *(stages[0].kernelSmnt);
+
+        // Intermediates were already checked to be thread-private
+        std::set<variable_t*> intermediateSet;
+        for (auto &it : intermediateVariables) {
+          intermediateSet.insert(it.second);
+        }
+
+        sharedMemoryAccesses previousAccesses(kernelSmnt, true);
+        const int stageCount = fusedInnerSmnt.size();
+        for (int i = 0; i < stageCount; ++i) {
+          sharedMemoryAccesses stageAccesses(kernelSmnt, true);
+          stageAccesses.add(*fusedInnerSmnt[i]);
+
+          std::vector<sharedMemoryAccesses::access_t> &accesses = stageAccesses.accesses;
+          accesses.erase(
+            std::remove_if(accesses.begin(), accesses.end(),
+                           [&](const sharedMemoryAccesses::access_t &access) {
+                             return (intermediateSet.count(access.variable)
+                                     || intermediateSet.count(access.arrayVariable));
+                           }),
+            accesses.end()
+          );
+
+          if (stageAccesses.conflictsWith(previousAccesses)) {
+            return i;
+          }
+
+          previousAccesses.accesses.insert(previousAccesses.accesses.end(),
+                                           accesses.begin(),
+                                           accesses.end());
+          previousAccesses.hasUnknownAccesses |= stageAccesses.hasUnknownAccesses;
+        }
+        return -1;
+      }
+
+      bool kernelFusion::isIntermediateAccess(exprNode &expr,
+                                              variable_t &var) {
+        if (!(expr.type() & exprNodeType::subscript)) {
+          return false;
+        }
+        exprNode &value = *(((subscriptNode&) expr).value);
+        return (
+          (value.type() & exprNodeType::variable)
+          && (&(((variableNode&) value).value) == &var)
+        );
+      }
+
+      bool kernelFusion::getIteratorIndexSignature(exprNode &index,
+                                                   const std::vector<variable_t*> &iterators,
+                                                   std::string &signature) {
+        // Other variables can hold different values between accesses,
+        //   even when they have the same name in every stage
+        exprNodeVector nodes = index.getNestedChildren();
+        nodes.push_back(&index);
+
+        signature = index.toString();
+        for (exprNode *node : nodes) {
+          const udim_t nodeType = node->type();
+          if (nodeType & exprNodeType::variable) {
+            variable_t *var = &(((variableNode*) node)->value);
+            std::vector<variable_t*>::const_iterator it = (
+              std::find(iterators.begin(), iterators.end(), var)
+            );
+            if (it == iterators.end()) {
+              return false;
+            }
+            // Compare iterators by identity rather than by name
+            signature += ':' + std::to_string(it - iterators.begin());
+          } else if (nodeType & (exprNodeType::leftUnary
+                                 | exprNodeType::rightUnary
+                                 | exprNodeType::binary)) {
+            const opType_t opType = ((exprOpNode*) node)->opType();
+            if (!(opType & (operatorType::arithmetic
+                            | operatorType::bitOp
+                            | operatorType::positive
+                            | operatorType::negative))) {
+              return false;
+            }
+          } else if (!(nodeType & (exprNodeType::primitive
+                                   | exprNodeType::parentheses))) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      bool kernelFusion::hasPrivateIntermediateAccesses(forStatement &fusedForSmnt,
+                                                        const std::vector<variable_t*> &iterators,
+                                                        const std::vector<variable_t*> &innerIterators,
+                                                        variable_t &var) {
+        int useCount = 0;
+        statementArray::from(fusedForSmnt)
+          .flatFilterByExprType(exprNodeType::variable)
+          .forEach([&](smntExprNode smntExpr) {
+            useCount += (&(((variableNode*) smntExpr.node)->value) == &var);
+          });
+
+        // Every use needs to be a thread-private entry with the same index
+        int accessCount = 0;
+        bool isPrivate = true;
+        std::set<std::string> indices;
+        statementArray::from(fusedForSmnt)
+          .flatFilterByExprType(exprNodeType::subscript)
+          .forEach([&](smntExprNode smntExpr) {
+            if (!isIntermediateAccess(*smntExpr.node, var)) {
+              return;
+            }
+            exprNode &index = *(((subscriptNode*) smntExpr.node)->index);
+            ++accessCount;
+
+            std::string signature;
+            isPrivate &= getIteratorIndexSignature(index, iterators, signature);
+            indices.insert(signature);
+
+            exprNodeVector indexNodes = index.getNestedChildren();
+            indexNodes.push_back(&index);
+
+            std::set<variable_t*> indexVariables;
+            for (exprNode *node : indexNodes) {
+              if (node->type() & exprNodeType::variable) {
+                indexVariables.insert(&(((variableNode*) node)->value));
+              }
+            }
+            for (variable_t *iterator : innerIterators) {
+              isPrivate &= (bool) indexVariables.count(iterator);
+            }
+          });
+
+        return (
+          isPrivate
+          && (useCount == accessCount)
+          && (indices.size() == 1)
+        );
+      }
+
+      void kernelFusion::replaceIntermediateAccesses(forStatement &fusedForSmnt,
+                                                     variable_t &var) {
+        // tmp[i] -> _occa_fused_tmp
+        statementArray::from(fusedForSmnt)
+          .flatFilterByExprType(exprNodeType::subscript)
+          .inplaceMap([&](smntExprNode smntExpr) -> exprNode* {
+            if (!isIntermediateAccess(*smntExpr.node, var)) {
+              return smntExpr.node;
+            }
+            return new variableNode(var.source, var);
+          });
+      }
+
+      bool fuseKernels(blockStatement &root,
+                       const json &fusion) {
+        if (!fusion.isInitialized()) {
+          return true;
+        }
+
+        kernelFusion fuser(root);
+        return (
+          fuser.setup(fusion)
+          && fuser.fuse()
+        );
+      }
+    }
+  }
+}
@@ -0,0 +1,119 @@
+#ifndef OCCA_INTERNAL_LANG_MODES_KERNELFUSION_HEADER
+#define OCCA_INTERNAL_LANG_MODES_KERNELFUSION_HEADER
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <occa/internal/lang/statement.hpp>
+#include <occa/types/json.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace okl {
+      //---[ Kernel Fusion ]------------
+      // Builds one kernel running the loop bodies of several kernels
+      //   with the same @outer/@inner loops, one after the other:
+      //
+      //   {
+      //     name: 'scaleAxpy',
+      //     stages: [
+      //       { kernel: 'scale', arguments: { y: 'tmp' } },
+      //       { kernel: 'axpy', arguments: { x: 'tmp' } },
+      //     ],
+      //     intermediates: ['tmp'],
+      //   }
+      //
+      // Stage arguments are renamed through [arguments] and arguments
+      //   with the same fused name are shared. Fused arguments are
+      //   ordered by their first appearance across stages.
+      //
+      // Intermediates are arrays only passed between stages. They are
+      //   replaced by a value in the fused @inner loop, which requires
+      //   every stage to access them with the same index, only made of
+      //   the loop iterators, and the first stage using them to write
+      //   them before reading them
+      //
+      // Each thread runs every stage back-to-back, so stages can only
+      //   depend on results their own thread computed in earlier stages
+      class kernelFusion {
+      public:
+        struct stage_t {
+          functionDeclStatement *kernelSmnt;
+          std::map<std::string, std::string> argumentNames;
+          // Clone of the kernel's @outer loop, one loop per nest level
+          std::vector<forStatement*> loops;
+        };
+
+        blockStatement &root;
+        std::string name;
+        std::vector<stage_t> stages;
+        strVector intermediates;
+
+        kernelFusion(blockStatement &root_);
+        ~kernelFusion();
+
+        bool setup(const json &fusion);
+
+        bool fuse();
+
+        static bool getLoopNest(functionDeclStatement &kernelSmnt,
+                                std::vector<forStatement*> &loops);
+
+        static bool getLoopNest(forStatement &forSmnt,
+                                std::vector<forStatement*> &loops);
+
+        static std::string getAttributesSignature(statement_t &smnt);
+
+      private:
+        bool isIntermediate(const std::string &argName) const;
+
+        std::string getFusedArgumentName(stage_t &stage,
+                                         variable_t &arg) const;
+
+        static bool haveSameArgumentTypes(variable_t &arg,
+                                          variable_t &otherArg);
+
+        function_t* setupFusedFunction();
+
+        bool replaceStageVariables(stage_t &stage,
+                                   function_t &fusedFunction,
+                                   std::map<std::string, variable_t*> &intermediateVariables);
+
+        static bool hasHiddenVariables(forStatement &forSmnt,
+                                       std::string &varName);
+
+        static bool haveSameLoopNests(stage_t &stage,
+                                      stage_t &otherStage);
+
+        static void moveLoopBody(forStatement &forSmnt,
+                                 forStatement &fusedForSmnt);
+
+        int getDependentStage(forStatement &fusedInnerSmnt,
+                              const std::map<std::string, variable_t*> &intermediateVariables);
+
+        static bool isIntermediateAccess(exprNode &expr,
+                                         variable_t &var);
+
+        static bool getIteratorIndexSignature(exprNode &index,
+                                              const std::vector<variable_t*> &iterators,
+                                              std::string &signature);
+
+        static bool hasPrivateIntermediateAccesses(forStatement &fusedForSmnt,
+                                                   const std::vector<variable_t*> &iterators,
+                                                   const std::vector<variable_t*> &innerIterators,
+                                                   variable_t &var);
+
+        static void replaceIntermediateAccesses(forStatement &fusedForSmnt,
+                                                variable_t &var);
+      };
+
+      // Fuses kernels described by [fusion] into a new kernel in [root]
+      bool fuseKernels(blockStatement &root,
+                       const json &fusion);
+      //================================
+    }
+  }
+}
+
+#endif
@@ -54,6 +54,13 @@ namespace occa {
         return name;
       }
 
+      std::string metalParser::getInnerSize(const int loopIndex) {
+        // [0, 1, 2] -> ['x', 'y', 'z']
+        std::string name = "_occa_threads_per_group.";
+        name += ('x' + (char) loopIndex);
+        return name;
+      }
+
       // Needs to be implemented: do nothing for now.
       std::string metalParser::launchBoundsAttribute(const int innerDims[3]) {
         return "";
@@ -118,17 +125,20 @@ namespace occa {
             )
             .forEach([&](statement_t *smnt) {
                 function_t *function;
+                bool usesThreadsPerGroup = false;
 
                 if (smnt->type() & statementType::functionDecl) {
                   function = &(((functionDeclStatement*) smnt)->function());
 
                   migrateLocalDecls((functionDeclStatement&) *smnt);
                   if (!success) return;
+
+                  usesThreadsPerGroup = hasThreadsPerGroup((functionDeclStatement&) *smnt);
                 } else {
                   function = &(((functionStatement*) smnt)->function());
                 }
 
-                setKernelQualifiers(*function);
+                setKernelQualifiers(*function, usesThreadsPerGroup);
             });
       }
 
@@ -143,7 +153,22 @@ namespace occa {
               });
       }
 
-      void metalParser::setKernelQualifiers(function_t &function) {
+      bool metalParser::hasThreadsPerGroup(functionDeclStatement &kernelSmnt) {
+        // Only @reduction trees read the thread count, through raw source
+        bool usesThreadsPerGroup = false;
+        statementArray::from(kernelSmnt)
+            .flatFilterByStatementType(statementType::sourceCode)
+            .forEach([&](statement_t *smnt) {
+                const std::string &sourceCode = ((sourceCodeStatement*) smnt)->sourceCode;
+                if (sourceCode.find("_occa_threads_per_group") != std::string::npos) {
+                  usesThreadsPerGroup = true;
+                }
+              });
+        return usesThreadsPerGroup;
+      }
+
+      void metalParser::setKernelQualifiers(function_t &function,
+                                            const bool usesThreadsPerGroup) {
         function.returnType.add(0, kernel_q);
 
         int argCount = (int) function.args.size();
@@ -167,6 +192,7 @@ namespace occa {
 
         variable_t occaGroupPositionArg(uint3, "_occa_group_position");
         variable_t occaThreadPositionArg(uint3, "_occa_thread_position");
+        variable_t occaThreadsPerGroupArg(uint3, "_occa_threads_per_group");
 
         occaGroupPositionArg.vartype.customSuffix = (
           "[[threadgroup_position_in_grid]]"
@@ -174,16 +200,24 @@ namespace occa {
         occaThreadPositionArg.vartype.customSuffix = (
           "[[thread_position_in_threadgroup]]"
         );
+        occaThreadsPerGroupArg.vartype.customSuffix = (
+          "[[threads_per_threadgroup]]"
+        );
 
         attribute_t &implicitArgAttr = *(getAttribute("implicitArg"));
         attributeToken_t groupAttr(implicitArgAttr, *(occaGroupPositionArg.source));
         attributeToken_t threadAttr(implicitArgAttr, *(occaThreadPositionArg.source));
+        attributeToken_t threadsPerGroupAttr(implicitArgAttr, *(occaThreadsPerGroupArg.source));
 
         occaGroupPositionArg.addAttribute(groupAttr);
         occaThreadPositionArg.addAttribute(threadAttr);
+        occaThreadsPerGroupArg.addAttribute(threadsPerGroupAttr);
 
         function.addArgument(occaGroupPositionArg);
         function.addArgument(occaThreadPositionArg);
+        if (usesThreadsPerGroup) {
+          function.addArgument(occaThreadsPerGroupArg);
+        }
       }
     }
   }
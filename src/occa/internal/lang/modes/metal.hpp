@@ -26,6 +26,8 @@ namespace occa {
 
         virtual std::string getInnerIterator(const int loopIndex) override;
 
+        virtual std::string getInnerSize(const int loopIndex) override;
+
         virtual std::string launchBoundsAttribute(const int innerDims[3]) override;
 
         void setSharedQualifiers();
@@ -37,7 +39,10 @@ namespace occa {
 
         void migrateLocalDecls(functionDeclStatement &kernelSmnt);
 
-        void setKernelQualifiers(function_t &function);
+        static bool hasThreadsPerGroup(functionDeclStatement &kernelSmnt);
+
+        void setKernelQualifiers(function_t &function,
+                                 const bool usesThreadsPerGroup);
       };
     }
   }
@@ -36,6 +36,7 @@ namespace occa {
           && kernelHasValidOklLoops(kernelSmnt)
           && kernelHasValidSharedAndExclusiveDeclarations(kernelSmnt)
           && kernelHasValidLoopBreakAndContinue(kernelSmnt)
+          && kernelHasValidReductions(kernelSmnt)
         );
       }
 
@@ -343,6 +344,22 @@ namespace occa {
         );
       }
 
+      bool kernelHasValidReductions(functionDeclStatement &kernelSmnt) {
+        // @reduction is only for @outer/@inner loops
+        return (
+          statementArray::from(kernelSmnt)
+          .flatFilterByStatementType(statementType::for_, "reduction")
+          .filter([&](statement_t *smnt) {
+              if (isOklForLoop(smnt)) {
+                return false;
+              }
+              smnt->printError("[@reduction] can only be used on [@outer] or [@inner] loops");
+              return true;
+            })
+          .isEmpty()
+        );
+      }
+
       //---[ Helper Methods ]-----------
       bool isOklForLoop(statement_t *smnt) {
         std::string oklAttr;
@@ -389,9 +406,11 @@ namespace occa {
         parser.addAttribute<attributes::inner>();
         parser.addAttribute<attributes::kernel>();
         parser.addAttribute<attributes::outer>();
+        parser.addAttribute<attributes::reduction>();
         parser.addAttribute<attributes::shared>();
         parser.addAttribute<attributes::maxInnerDims>();
         parser.addAttribute<attributes::noBarrier>();
+        parser.addAttribute<attributes::unroll>();
       }
 
       void setOklLoopIndices(functionDeclStatement &kernelSmnt) {
@@ -413,6 +432,109 @@ namespace occa {
 
         forOklForLoopStatements(kernelSmnt, func);
       }
+
+      bool specializeKernelArguments(blockStatement &root,
+                                     const json &specializations) {
+        if (!specializations.isInitialized()) {
+          return true;
+        }
+        if (!specializations.isObject()) {
+          occa::printError("[okl/specialize] must be an object of { argument: value }");
+          return false;
+        }
+
+        const jsonObject &values = specializations.object();
+
+        bool success = true;
+        root.children
+            .forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
+                for (variable_t *arg : kernelSmnt.function().args) {
+                  if (!arg) {
+                    continue;
+                  }
+                  jsonObject::const_iterator it = values.find(arg->name());
+                  if (it != values.end()) {
+                    success &= specializeKernelArgument(kernelSmnt, *arg, it->second);
+                  }
+                }
+              });
+        return success;
+      }
+
+      bool specializeKernelArgument(functionDeclStatement &kernelSmnt,
+                                    variable_t &arg,
+                                    const json &value) {
+        vartype_t &vartype = arg.vartype;
+        const type_t *type = vartype.type;
+
+        const bool isFloat = type && ((*type == float_) || (*type == double_));
+        const bool isInteger = type && (
+          (*type == char_) || (*type == short_) || (*type == int_)
+          || (*type == size_t_) || (*type == ptrdiff_t_)
+        );
+        const bool isBool = type && (*type == bool_);
+
+        if (!(isFloat || isInteger || isBool)
+            || !vartype.has(const_)
+            || vartype.isPointerType()
+            || vartype.isReference()
+            || vartype.arrays.size()) {
+          arg.printError("Only const scalar kernel arguments can be specialized");
+          return false;
+        }
+        // JSON booleans are stored as numbers, only bool arguments take them
+        const bool matchesType = (
+          value.isNumber()
+          && (isBool || !value.isBool())
+          && (!isInteger || value.number().isInteger())
+        );
+        if (!matchesType) {
+          arg.printError("Specialized value for [" + arg.name() + "] does not match its type");
+          return false;
+        }
+
+        // Match the argument type so literals keep their precision
+        const primitive &number = value.number();
+        const bool isUnsigned = vartype.has(unsigned_) || (*type == size_t_);
+        const bool is64Bit = (
+          vartype.has(long_) || vartype.has(longlong_)
+          || (*type == size_t_) || (*type == ptrdiff_t_)
+        );
+
+        primitive specializedValue;
+        if (isBool) {
+          specializedValue = number.to<bool>();
+        } else if (*type == float_) {
+          specializedValue = number.to<float>();
+        } else if (*type == double_) {
+          specializedValue = number.to<double>();
+        } else if (is64Bit) {
+          specializedValue = (
+            isUnsigned
+            ? primitive(number.to<uint64_t>())
+            : primitive(number.to<int64_t>())
+          );
+        } else {
+          specializedValue = (
+            isUnsigned
+            ? primitive(number.to<uint32_t>())
+            : primitive(number.to<int32_t>())
+          );
+        }
+
+        statementArray::from(kernelSmnt)
+            .flatFilterByExprType(exprNodeType::variable)
+            .inplaceMap([&](smntExprNode smntExpr) -> exprNode* {
+                variableNode *varNode = (variableNode*) smntExpr.node;
+                if (&(varNode->value) != &arg) {
+                  return varNode;
+                }
+
+                return new primitiveNode(varNode->token, specializedValue);
+              });
+
+        return true;
+      }
       //================================
     }
   }
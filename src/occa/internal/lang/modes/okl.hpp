@@ -5,6 +5,7 @@
 #include <vector>
 
 #include <occa/internal/lang/statement.hpp>
+#include <occa/types/json.hpp>
 
 namespace occa {
   namespace lang {
@@ -40,6 +41,8 @@ namespace occa {
 
       bool kernelHasValidLoopBreakAndContinue(functionDeclStatement &kernelSmnt);
 
+      bool kernelHasValidReductions(functionDeclStatement &kernelSmnt);
+
       //---[ Helper Methods ]-----------
       bool isOklForLoop(statement_t *smnt);
 
@@ -52,6 +55,15 @@ namespace occa {
       void addOklAttributes(parser_t &parser);
 
       void setOklLoopIndices(functionDeclStatement &kernelSmnt);
+
+      // Replaces uses of const scalar kernel arguments listed in
+      //   [specializations] ({ name: value }) with their values
+      bool specializeKernelArguments(blockStatement &root,
+                                     const json &specializations);
+
+      bool specializeKernelArgument(functionDeclStatement &kernelSmnt,
+                                    variable_t &arg,
+                                    const json &value);
       //================================
     }
   }
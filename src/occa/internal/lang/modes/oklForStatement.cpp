@@ -470,6 +470,30 @@ namespace occa {
         return oklParentPath;
       }
 
+      bool oklForStatement::haveSameIterationSpace(forStatement &forSmnt_,
+                                                   forStatement &otherForSmnt) {
+        oklForStatement oklForSmnt(forSmnt_, "", false);
+        oklForStatement otherOklForSmnt(otherForSmnt, "", false);
+        if (!oklForSmnt.isValid() || !otherOklForSmnt.isValid()) {
+          return false;
+        }
+
+        const auto getSource = [&](exprNode *expr) -> std::string {
+          return expr ? expr->toString() : "";
+        };
+
+        return (
+          (oklForSmnt.oklLoopIndex() == otherOklForSmnt.oklLoopIndex())
+          && (oklForSmnt.iterator->vartype == otherOklForSmnt.iterator->vartype)
+          && (getSource(oklForSmnt.initValue) == getSource(otherOklForSmnt.initValue))
+          && (getSource(oklForSmnt.checkValue) == getSource(otherOklForSmnt.checkValue))
+          && (oklForSmnt.checkOp->opType() == otherOklForSmnt.checkOp->opType())
+          && (oklForSmnt.checkValueOnRight == otherOklForSmnt.checkValueOnRight)
+          && (getSource(oklForSmnt.updateValue) == getSource(otherOklForSmnt.updateValue))
+          && (oklForSmnt.positiveUpdate == otherOklForSmnt.positiveUpdate)
+        );
+      }
+
       std::string oklForStatement::sourceStr() {
         if (source.size()) {
           return ("[" + source + "] ");
@@ -76,6 +76,10 @@ namespace occa {
 
         static statementArray getOklLoopPath(forStatement &forSmnt);
 
+        // Compares loop bounds by their source, ignoring iterator names
+        static bool haveSameIterationSpace(forStatement &forSmnt_,
+                                           forStatement &otherForSmnt);
+
         std::string sourceStr();
 
         void printWarning(const std::string &message);
@@ -74,6 +74,13 @@ namespace occa {
         return name;
       }
 
+      std::string openclParser::getInnerSize(const int loopIndex) {
+        std::string name = "get_local_size(";
+        name += occa::toString(loopIndex);
+        name += ')';
+        return name;
+      }
+
       std::string openclParser::launchBoundsAttribute(const int innerDims[3]) {
         std::stringstream ss; 
         ss << "__attribute__((reqd_work_group_size("
@@ -26,6 +26,8 @@ namespace occa {
 
         virtual std::string getInnerIterator(const int loopIndex) override;
 
+        virtual std::string getInnerSize(const int loopIndex) override;
+
         virtual std::string launchBoundsAttribute(const int innerDims[3]) override;
 
         void addExtensions();
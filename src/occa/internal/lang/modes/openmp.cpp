@@ -1,10 +1,14 @@
 #include <occa/internal/lang/modes/openmp.hpp>
-#include <occa/internal/lang/expr/expr.hpp>
+#include <occa/internal/lang/expr.hpp>
 #include <occa/internal/lang/builtins/attributes/atomic.hpp>
+#include <occa/internal/lang/builtins/attributes/reduction.hpp>
 
 namespace occa {
   namespace lang {
     namespace okl {
+      const std::string openmpParser::atomicLockName = "_occa_atomic_lock";
+      const std::string openmpParser::atomicPtrName = "_occa_atomic_ptr";
+
       openmpParser::openmpParser(const occa::json &settings_) :
         serialParser(settings_) {}
 
@@ -13,9 +17,6 @@ namespace occa {
 
         if (!success) return;
         setupOmpPragmas();
-
-        if (!success) return;
-        setupAtomics();
       }
 
       void openmpParser::setupOmpPragmas() {
@@ -48,19 +49,49 @@ namespace occa {
             outerSmnt.printError("Unable to add [#pragma omp]");
             return;
           }
+          std::string pragmaSource = "omp parallel for";
+          if (!getReductionClauses(outerSmnt, pragmaSource)) {
+            success = false;
+            return;
+          }
+
           // Add OpenMP Pragma
           blockStatement &outerBlock  = (blockStatement&) outerSmnt;
           blockStatement &parentBlock = *((blockStatement*) parent);
           pragmaStatement *pragmaSmnt = (
             new pragmaStatement((blockStatement*) parent,
                                 pragmaToken(outerBlock.source->origin,
-                                            "omp parallel for"))
+                                            pragmaSource))
           );
           parentBlock.addBefore(outerSmnt,
                                 *pragmaSmnt);
         }
       }
 
+      bool openmpParser::getReductionClauses(statement_t &outerSmnt,
+                                             std::string &pragmaSource) {
+        // Reductions on other @outer/@inner loops run inside a single
+        //   thread, making them plain accumulators like in serial mode
+        if (!outerSmnt.hasAttribute("reduction")) {
+          return true;
+        }
+
+        attributes::reduction::reductionVarVector reductions;
+        if (!attributes::reduction::getReductions(outerSmnt.attributes["reduction"],
+                                                  reductions)) {
+          return false;
+        }
+
+        for (auto &reductionVar : reductions) {
+          pragmaSource += " reduction(";
+          pragmaSource += reductionVar.op;
+          pragmaSource += ':';
+          pragmaSource += reductionVar.variable->name();
+          pragmaSource += ')';
+        }
+        return true;
+      }
+
       bool openmpParser::isOuterForLoop(statement_t *smnt) {
         return (
           (smnt->type() & statementType::for_)
@@ -77,6 +108,55 @@ namespace occa {
       }
 
       bool openmpParser::transformBlockStatement(blockStatement &blockSmnt) {
+        if (blockSmnt.size() == 1
+            && (blockSmnt[0]->type() & statementType::expression)) {
+          expressionStatement &exprSmnt = (expressionStatement&) *blockSmnt[0];
+          const opType_t &opType = expr(exprSmnt.expr).opType();
+
+          // Compound updates [omp atomic] supports past the basic ones
+          if (isOmpAtomicExpression(exprSmnt)) {
+            blockSmnt.remove(exprSmnt);
+            blockSmnt.replaceWith(exprSmnt);
+            delete &blockSmnt;
+
+            return transformBasicExpressionStatement(exprSmnt);
+          }
+
+          std::string functionName;
+          exprNode *argument = NULL;
+          if (attributes::atomic::isMinMaxExpression(exprSmnt, functionName, argument)) {
+            return transformMinMaxBlockStatement(blockSmnt, functionName, *argument);
+          }
+
+          // Assignments only need to lock the updated address
+          if (opType & operatorType::assignment) {
+            binaryOpNode &binaryNode = (binaryOpNode&) *exprSmnt.expr;
+            token_t *source = binaryNode.leftValue->token;
+
+            // Bind the address once, the lock and the update would
+            //   otherwise both evaluate the left value (e.g. a[k++])
+            printer pout;
+            pout << "auto *" << atomicPtrName
+                 << " = &" << expr::parens(binaryNode.leftValue) << ";\n"
+                 << "occa::atomics::stripeLock " << atomicLockName
+                 << "(" << atomicPtrName << ");";
+
+            identifierNode ptrNode(source, atomicPtrName);
+            exprNode *leftValue = new leftUnaryOpNode(source,
+                                                      op::dereference,
+                                                      ptrNode);
+            delete binaryNode.leftValue;
+            binaryNode.leftValue = leftValue;
+
+            blockSmnt.addFirst(
+              *(new sourceCodeStatement(&blockSmnt,
+                                        exprSmnt.source,
+                                        pout.str()))
+            );
+            return true;
+          }
+        }
+
         blockStatement &parent = *(blockSmnt.up);
 
         pragmaStatement &atomicPragmaSmnt = *(
@@ -90,6 +170,34 @@ namespace occa {
         return true;
       }
 
+      bool openmpParser::transformMinMaxBlockStatement(blockStatement &blockSmnt,
+                                                       const std::string &functionName,
+                                                       exprNode &argument) {
+        expressionStatement &exprSmnt = (expressionStatement&) *blockSmnt[0];
+        binaryOpNode &assignNode = (binaryOpNode&) *exprSmnt.expr;
+
+        // Cases:
+        //   @atomic i = min(i, value);
+        //   @atomic i = max(i, value);
+        printer pout;
+        pout << "occa::atomics::" << functionName
+             << "(&" << expr::parens(assignNode.leftValue)
+             << ", " << expr(&argument) << ");";
+
+        statement_t &atomicSmnt = (
+          *(new sourceCodeStatement(
+              blockSmnt.up,
+              exprSmnt.source,
+              pout.str()
+            ))
+        );
+
+        blockSmnt.replaceWith(atomicSmnt);
+        delete &blockSmnt;
+
+        return true;
+      }
+
       bool openmpParser::transformBasicExpressionStatement(expressionStatement &exprSmnt) {
         blockStatement &parent = *(exprSmnt.up);
 
@@ -103,6 +211,19 @@ namespace occa {
 
         return true;
       }
+
+      bool openmpParser::isOmpAtomicExpression(expressionStatement &exprSmnt) {
+        const opType_t &opType = expr(exprSmnt.expr).opType();
+        return opType & (
+          operatorType::multEq
+          | operatorType::divEq
+          | operatorType::andEq
+          | operatorType::orEq
+          | operatorType::xorEq
+          | operatorType::leftShiftEq
+          | operatorType::rightShiftEq
+        );
+      }
     }
   }
 }
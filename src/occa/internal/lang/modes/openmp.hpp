@@ -8,19 +8,31 @@ namespace occa {
     namespace okl {
       class openmpParser : public serialParser {
        public:
+        static const std::string atomicLockName;
+        static const std::string atomicPtrName;
+
         openmpParser(const occa::json &settings_ = occa::json());
 
         virtual void afterParsing();
 
         void setupOmpPragmas();
 
+        bool getReductionClauses(statement_t &outerSmnt,
+                                 std::string &pragmaSource);
+
         bool isOuterForLoop(statement_t *smnt);
 
-        void setupAtomics();
+        virtual void setupAtomics();
 
         static bool transformBlockStatement(blockStatement &blockSmnt);
 
+        static bool transformMinMaxBlockStatement(blockStatement &blockSmnt,
+                                                  const std::string &functionName,
+                                                  exprNode &argument);
+
         static bool transformBasicExpressionStatement(expressionStatement &exprSmnt);
+
+        static bool isOmpAtomicExpression(expressionStatement &exprSmnt);
       };
     }
   }
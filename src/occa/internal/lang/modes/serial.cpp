@@ -1,9 +1,15 @@
+#include <algorithm>
 #include <set>
 
+#include <occa/internal/utils/string.hpp>
 #include <occa/internal/lang/modes/serial.hpp>
 #include <occa/internal/lang/modes/okl.hpp>
+#include <occa/internal/lang/modes/kernelFusion.hpp>
 #include <occa/internal/lang/modes/oklForStatement.hpp>
+#include <occa/internal/lang/modes/sharedMemoryAccesses.hpp>
 #include <occa/internal/lang/builtins/types.hpp>
+#include <occa/internal/lang/builtins/attributes/atomic.hpp>
+#include <occa/internal/lang/builtins/attributes/unroll.hpp>
 #include <occa/internal/lang/expr.hpp>
 
 namespace occa {
@@ -20,16 +26,633 @@ namespace occa {
       void serialParser::onClear() {}
 
       void serialParser::afterParsing() {
+        if (!success) return;
+        setupKernelFusion();
+
+        if (!success) return;
+        setupSpecializations();
+
         if (!success) return;
         if (settings.get("okl/validate", true)) {
           success = kernelsAreValid(root);
         }
 
+        if (!success) return;
+        setupUnrolls();
+
+        if (!success) return;
+        setupSharedHoisting();
+
+        if (!success) return;
+        setupInnerLoopFusion();
+
+        if (!success) return;
+        setupExclusiveDemotions();
+
         if (!success) return;
         setupKernels();
 
         if (!success) return;
         setupExclusives();
+
+        if (!success) return;
+        setupAtomics();
+      }
+
+      void serialParser::setupKernelFusion() {
+        success = fuseKernels(root,
+                              settings.getPathValue("okl/fusion"));
+      }
+
+      void serialParser::setupSpecializations() {
+        success = specializeKernelArguments(root,
+                                            settings.getPathValue("okl/specialize"));
+      }
+
+      void serialParser::setupUnrolls() {
+        success = attributes::unroll::applyCodeTransformations(root,
+                                                               getUnrollPragmaSource);
+      }
+
+      std::string serialParser::getUnrollPragmaSource(const int count) {
+        // GCC and Clang need an explicit factor, capped by GCC at 65534
+        if (!count) {
+          return "";
+        }
+        return "GCC unroll " + occa::toString(std::min(count, 65534));
+      }
+
+      void serialParser::setupSharedHoisting() {
+        if (!settings.get("serial/hoist_shared", true)) {
+          return;
+        }
+
+        // @shared tables filled from the same data in every @outer iteration
+        //   only need to be filled once before the @outer loops:
+        //
+        //   for (b; @outer) { @shared float s[16]; for (i; @inner) { s[i] = w[i]; } ... }
+        //   -> float s[16]; if (...) { for (i) { s[i] = w[i]; } } for (b; @outer) { ... }
+        root.children
+          .forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
+            sharedMemoryAccesses kernelAccesses(kernelSmnt, true);
+            kernelAccesses.add(kernelSmnt);
+
+            std::vector<std::pair<forStatement*, forStatement*>> fillLoops;
+            statementArray::from(kernelSmnt)
+              .flatFilterByStatementType(statementType::for_, "outer")
+              .forEach([&](statement_t *smnt) {
+                forStatement &outerSmnt = (forStatement&) *smnt;
+                for (statement_t *childSmnt : outerSmnt.children) {
+                  if ((childSmnt->type() & statementType::for_)
+                      && childSmnt->hasAttribute("inner")) {
+                    fillLoops.push_back({&outerSmnt, (forStatement*) childSmnt});
+                  }
+                }
+              });
+
+            for (auto &it : fillLoops) {
+              hoistSharedFill(kernelSmnt, kernelAccesses, *it.first, *it.second);
+            }
+          });
+      }
+
+      bool serialParser::hoistSharedFill(functionDeclStatement &kernelSmnt,
+                                         const sharedMemoryAccesses &kernelAccesses,
+                                         forStatement &outerSmnt,
+                                         forStatement &fillSmnt) {
+        for (auto &it : fillSmnt.attributes) {
+          if ((it.first != "inner") && (it.first != "nobarrier")) {
+            return false;
+          }
+        }
+
+        const bool hasJumps = !(
+          statementArray::from(fillSmnt)
+          .flatFilterByStatementType(statementType::return_ |
+                                     statementType::goto_)
+          .isEmpty()
+        );
+        if (hasJumps) {
+          return false;
+        }
+
+        // The loop can only write @shared memory and read everything else
+        sharedMemoryAccesses fillAccesses(kernelSmnt, true);
+        fillAccesses.add(fillSmnt);
+        if (fillAccesses.hasUnknownAccesses) {
+          return false;
+        }
+
+        std::set<variable_t*> sharedVariables;
+        bool readsMemory = false;
+        for (const sharedMemoryAccesses::access_t &access : fillAccesses.accesses) {
+          if (access.variable && access.variable->hasAttribute("shared")) {
+            if (access.isRead) {
+              return false;
+            }
+            sharedVariables.insert(access.variable);
+          } else if (access.isWrite) {
+            return false;
+          } else {
+            readsMemory |= !access.variable;
+          }
+        }
+        if (sharedVariables.empty()) {
+          return false;
+        }
+
+        // Memory written by the kernel could alias what the loop reads,
+        //   unless arguments are marked as @restrict
+        bool kernelWritesMemory = kernelAccesses.hasUnknownAccesses;
+        for (const sharedMemoryAccesses::access_t &access : kernelAccesses.accesses) {
+          kernelWritesMemory |= (!access.variable && access.isWrite);
+        }
+
+        std::set<variable_t*> fillVariables;
+        statementArray::from(fillSmnt)
+          .nestedForEachDeclaration([&](variableDeclaration &decl) {
+            fillVariables.insert(&(decl.variable()));
+          });
+
+        bool isInvariant = true;
+        statementArray::from(fillSmnt)
+          .flatFilterByExprType(exprNodeType::variable)
+          .forEach([&](smntExprNode smntExpr) {
+            variable_t &var = ((variableNode*) smntExpr.node)->value;
+            if (sharedVariables.count(&var) || fillVariables.count(&var)) {
+              return;
+            }
+            if (!isUnmodifiedArgument(kernelSmnt, kernelAccesses, var)) {
+              isInvariant = false;
+              return;
+            }
+            if (readsMemory
+                && kernelWritesMemory
+                && var.vartype.isPointerType()
+                && !(var.hasAttribute("restrict") && var.vartype.has(const_))) {
+              isInvariant = false;
+            }
+          });
+        if (!isInvariant) {
+          return false;
+        }
+
+        // Find the @shared declarations and make sure no other statement
+        //   writes them or reads them before the loop
+        std::vector<declarationStatement*> declSmnts;
+        for (variable_t *var : sharedVariables) {
+          declarationStatement *declSmnt = NULL;
+          for (statement_t *smnt : outerSmnt.children) {
+            if (smnt == &fillSmnt) {
+              break;
+            }
+            if (!(smnt->type() & statementType::declaration)) {
+              continue;
+            }
+            declarationStatement &smntDecl = (declarationStatement&) *smnt;
+            if ((smntDecl.declarations.size() == 1)
+                && (&(smntDecl.declarations[0].variable()) == var)
+                && !smntDecl.declarations[0].value) {
+              declSmnt = &smntDecl;
+            }
+          }
+          if (!declSmnt) {
+            return false;
+          }
+          declSmnts.push_back(declSmnt);
+
+          // Moving the declaration can't change what names refer to
+          bool hasNameClash = false;
+          for (variable_t *arg : kernelSmnt.function().args) {
+            hasNameClash |= (arg && (arg->name() == var->name()));
+          }
+          statementArray::from(kernelSmnt)
+            .nestedForEachDeclaration([&](variableDeclaration &decl) {
+              hasNameClash |= (
+                (&(decl.variable()) != var)
+                && (decl.variable().name() == var->name())
+              );
+            });
+          if (hasNameClash) {
+            return false;
+          }
+        }
+
+        bool isBeforeFill = true;
+        for (statement_t *smnt : outerSmnt.children) {
+          if (smnt == &fillSmnt) {
+            isBeforeFill = false;
+            continue;
+          }
+          if (std::find(declSmnts.begin(), declSmnts.end(), smnt) != declSmnts.end()) {
+            continue;
+          }
+
+          sharedMemoryAccesses smntAccesses(kernelSmnt);
+          smntAccesses.add(*smnt);
+          if (smntAccesses.hasUnknownAccesses) {
+            return false;
+          }
+          for (const sharedMemoryAccesses::access_t &access : smntAccesses.accesses) {
+            if (sharedVariables.count(access.variable)
+                && (access.isWrite || isBeforeFill)) {
+              return false;
+            }
+          }
+        }
+
+        // The loop still only runs if the @outer loops run
+        statement_t *topOuterSmnt = NULL;
+        exprNode *guard = getOuterLoopsGuard(kernelSmnt, kernelAccesses, outerSmnt, topOuterSmnt);
+        if (!guard) {
+          return false;
+        }
+
+        for (declarationStatement *declSmnt : declSmnts) {
+          const std::string varName = declSmnt->declarations[0].variable().name();
+          keywordMapIterator it = outerSmnt.scope.keywords.find(varName);
+          if (it != outerSmnt.scope.keywords.end()) {
+            kernelSmnt.scope.keywords[varName] = it->second;
+            outerSmnt.scope.keywords.erase(it);
+          }
+          outerSmnt.remove(*declSmnt);
+          kernelSmnt.addBefore(*topOuterSmnt, *declSmnt);
+        }
+
+        // The loops run once, outside of any @outer loop
+        outerSmnt.remove(fillSmnt);
+        statementArray::from(fillSmnt)
+          .flatFilterByStatementType(statementType::for_, "inner")
+          .forEach([&](statement_t *smnt) {
+            smnt->attributes.erase("inner");
+            smnt->attributes.erase("nobarrier");
+          });
+
+        ifStatement &guardSmnt = *(new ifStatement(&kernelSmnt, fillSmnt.source));
+        guardSmnt.setCondition(new expressionStatement(&guardSmnt, *guard, false));
+        guardSmnt.add(fillSmnt);
+        kernelSmnt.addBefore(*topOuterSmnt, guardSmnt);
+
+        return true;
+      }
+
+      exprNode* serialParser::getOuterLoopsGuard(functionDeclStatement &kernelSmnt,
+                                                 const sharedMemoryAccesses &kernelAccesses,
+                                                 forStatement &outerSmnt,
+                                                 statement_t *&topOuterSmnt) {
+        // Every enclosing @outer loop needs to have a first iteration:
+        //   for (b = 0; b < N; ...) -> (0) < (N)
+        exprNode *guard = NULL;
+        for (statement_t *smnt = &outerSmnt; smnt != &kernelSmnt; smnt = smnt->up) {
+          if (!smnt
+              || !(smnt->type() & statementType::for_)
+              || !smnt->hasAttribute("outer")) {
+            delete guard;
+            return NULL;
+          }
+          topOuterSmnt = smnt;
+
+          oklForStatement oklForSmnt((forStatement&) *smnt, "", false);
+          if (!oklForSmnt.isValid()) {
+            delete guard;
+            return NULL;
+          }
+
+          bool isInvariant = true;
+          for (exprNode *expr : {oklForSmnt.initValue, oklForSmnt.checkValue}) {
+            exprNodeVector nodes = expr->getNestedChildren();
+            nodes.push_back(expr);
+            for (exprNode *node : nodes) {
+              if (node->type() & exprNodeType::variable) {
+                isInvariant &= isUnmodifiedArgument(kernelSmnt,
+                                                    kernelAccesses,
+                                                    ((variableNode*) node)->value);
+              }
+            }
+          }
+          if (!isInvariant) {
+            delete guard;
+            return NULL;
+          }
+
+          const binaryOperator_t &checkOp = (const binaryOperator_t&) oklForSmnt.checkOp->op;
+          exprNode *initValue = oklForSmnt.initValue->wrapInParentheses();
+          exprNode *checkValue = oklForSmnt.checkValue->wrapInParentheses();
+          exprNode *check = (
+            oklForSmnt.checkValueOnRight
+            ? new binaryOpNode(smnt->source, checkOp, *initValue, *checkValue)
+            : new binaryOpNode(smnt->source, checkOp, *checkValue, *initValue)
+          );
+          delete initValue;
+          delete checkValue;
+
+          if (guard) {
+            exprNode *checks = new binaryOpNode(smnt->source, op::and_, *check, *guard);
+            delete check;
+            delete guard;
+            guard = checks;
+          } else {
+            guard = check;
+          }
+        }
+        return guard;
+      }
+
+      bool serialParser::isUnmodifiedArgument(functionDeclStatement &kernelSmnt,
+                                              const sharedMemoryAccesses &kernelAccesses,
+                                              variable_t &var) {
+        bool isArgument = false;
+        for (variable_t *arg : kernelSmnt.function().args) {
+          isArgument |= (arg == &var);
+        }
+        if (!isArgument) {
+          return false;
+        }
+
+        const vartype_t &vartype = var.vartype;
+        if (vartype.has(const_)
+            && !vartype.isPointerType()
+            && !vartype.arrays.size()) {
+          return true;
+        }
+
+        if (kernelAccesses.hasUnknownAccesses) {
+          return false;
+        }
+        for (const sharedMemoryAccesses::access_t &access : kernelAccesses.accesses) {
+          if ((access.variable == &var) && access.isWrite) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      void serialParser::setupInnerLoopFusion() {
+        if (!settings.get("serial/fuse_inner_loops", true)) {
+          return;
+        }
+        root.children
+          .forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
+            fuseInnerLoops(kernelSmnt, kernelSmnt);
+          });
+      }
+
+      void serialParser::fuseInnerLoops(functionDeclStatement &kernelSmnt,
+                                        blockStatement &blockSmnt) {
+        const auto isInnerLoop = [&](statement_t *smnt) {
+          return (
+            smnt
+            && (smnt->type() & statementType::for_)
+            && smnt->hasAttribute("inner")
+          );
+        };
+
+        // Adjacent @inner loops run back-to-back, fuse them while the
+        //   threads don't depend on each other's results:
+        //
+        //   for (i; @inner) { s[i] = x[i]; }
+        //   for (i; @inner) { y[i] = s[i]; }
+        //   -> for (i; @inner) { s[i] = x[i]; y[i] = s[i]; }
+        for (int i = 0; i < blockSmnt.size(); ++i) {
+          if (!isInnerLoop(blockSmnt[i])) {
+            continue;
+          }
+          forStatement &forSmnt = (forStatement&) *blockSmnt[i];
+          while (isInnerLoop(blockSmnt[i + 1])) {
+            forStatement &nextForSmnt = (forStatement&) *blockSmnt[i + 1];
+            if (!canFuseInnerLoops(kernelSmnt, forSmnt, nextForSmnt)) {
+              break;
+            }
+            fuseInnerLoop(forSmnt, nextForSmnt);
+          }
+        }
+
+        // Fuse nested loops after their parents were fused
+        const auto fuseInnerBlockLoops = [&](statement_t *smnt) {
+          if (smnt->is<blockStatement>()) {
+            fuseInnerLoops(kernelSmnt, (blockStatement&) *smnt);
+          }
+        };
+        for (statement_t *smnt : blockSmnt.children) {
+          fuseInnerBlockLoops(smnt);
+          for (statement_t *innerSmnt : smnt->getInnerStatements()) {
+            fuseInnerBlockLoops(innerSmnt);
+          }
+        }
+      }
+
+      bool serialParser::canFuseInnerLoops(functionDeclStatement &kernelSmnt,
+                                           forStatement &forSmnt,
+                                           forStatement &nextForSmnt) {
+        for (forStatement *smnt : {&forSmnt, &nextForSmnt}) {
+          for (auto &it : smnt->attributes) {
+            if ((it.first != "inner") && (it.first != "nobarrier")) {
+              return false;
+            }
+          }
+
+          // Jumps would skip the other loop's body
+          const bool hasJumps = !(
+            statementArray::from(*smnt)
+            .flatFilterByStatementType(statementType::continue_ |
+                                       statementType::break_ |
+                                       statementType::return_ |
+                                       statementType::goto_)
+            .isEmpty()
+          );
+          if (hasJumps) {
+            return false;
+          }
+
+          // Nested @inner loops each step the @exclusive index
+          const int innerLoopCount = (
+            statementArray::from(*smnt)
+            .flatFilterByStatementType(statementType::for_, "inner")
+            .length()
+          );
+          const bool usesExclusives = !(
+            statementArray::from(*smnt)
+            .flatFilterByExprType(exprNodeType::variable, "exclusive")
+            .isEmpty()
+          );
+          if ((innerLoopCount > 1) && usesExclusives) {
+            return false;
+          }
+        }
+
+        if (!oklForStatement::haveSameIterationSpace(forSmnt, nextForSmnt)) {
+          return false;
+        }
+
+        // Names in the fused body can't clash or capture each other
+        oklForStatement oklForSmnt(forSmnt, "", false);
+        oklForStatement nextOklForSmnt(nextForSmnt, "", false);
+        const std::string &iteratorName = oklForSmnt.iterator->name();
+        const std::string &nextIteratorName = nextOklForSmnt.iterator->name();
+
+        std::set<variable_t*> nextVariables;
+        bool hasNameConflicts = false;
+        statementArray::from(nextForSmnt)
+          .nestedForEachDeclaration([&](variableDeclaration &decl) {
+            variable_t &var = decl.variable();
+            nextVariables.insert(&var);
+            // Would shadow the renamed iterator
+            hasNameConflicts |= (
+              (&var != nextOklForSmnt.iterator)
+              && (var.name() == iteratorName)
+            );
+          });
+        for (auto &it : nextForSmnt.scope.keywords) {
+          hasNameConflicts |= (
+            (it.first != nextIteratorName)
+            && forSmnt.hasDirectlyInScope(it.first)
+          );
+        }
+        statementArray::from(nextForSmnt)
+          .flatFilterByExprType(exprNodeType::variable)
+          .forEach([&](smntExprNode smntExpr) {
+            variable_t &var = ((variableNode*) smntExpr.node)->value;
+            hasNameConflicts |= (
+              !nextVariables.count(&var)
+              && forSmnt.hasDirectlyInScope(var.name())
+            );
+          });
+        if (hasNameConflicts) {
+          return false;
+        }
+
+        // Each thread needs to only depend on its own results
+        sharedMemoryAccesses accesses(kernelSmnt, true);
+        accesses.add(forSmnt);
+
+        sharedMemoryAccesses nextAccesses(kernelSmnt, true);
+        nextAccesses.add(nextForSmnt);
+
+        return !accesses.conflictsWith(nextAccesses);
+      }
+
+      void serialParser::fuseInnerLoop(forStatement &forSmnt,
+                                       forStatement &nextForSmnt) {
+        oklForStatement oklForSmnt(forSmnt, "", false);
+        oklForStatement nextOklForSmnt(nextForSmnt, "", false);
+        variable_t &iterator = *(oklForSmnt.iterator);
+        variable_t &nextIterator = *(nextOklForSmnt.iterator);
+
+        // Move the body declarations, the iterator is freed with its loop
+        keywordMap &nextKeywords = nextForSmnt.scope.keywords;
+        keywordMapIterator it = nextKeywords.begin();
+        while (it != nextKeywords.end()) {
+          if (it->first == nextIterator.name()) {
+            ++it;
+            continue;
+          }
+          forSmnt.scope.keywords[it->first] = it->second;
+          it = nextKeywords.erase(it);
+        }
+
+        for (statement_t *smnt : nextForSmnt.children) {
+          forSmnt.add(*smnt);
+          smnt->replaceVariable(nextIterator, iterator);
+        }
+        nextForSmnt.children.clear();
+
+        forSmnt.up->remove(nextForSmnt);
+        delete &nextForSmnt;
+      }
+
+      void serialParser::setupExclusiveDemotions() {
+        if (!settings.get("serial/demote_exclusives", true)) {
+          return;
+        }
+
+        // @exclusive values only used by one thread at a time can live
+        //   in the thread's loop body rather than in a per-thread array:
+        //
+        //   @exclusive float value = 0;
+        //   for (i; @inner) { value += x[i]; y[i] = value; }
+        //   -> for (i; @inner) { float value = 0; value += x[i]; y[i] = value; }
+        root.children
+          .forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
+            std::vector<declarationStatement*> exclusiveDeclarations;
+            statementArray::from(kernelSmnt)
+              .nestedForEachDeclaration([&](variableDeclaration &decl, declarationStatement &declSmnt) {
+                if (decl.variable().hasAttribute("exclusive")) {
+                  exclusiveDeclarations.push_back(&declSmnt);
+                }
+              });
+
+            for (declarationStatement *declSmnt : exclusiveDeclarations) {
+              forStatement *loopSmnt = getExclusiveDemotionLoop(kernelSmnt, *declSmnt);
+              if (!loopSmnt) {
+                continue;
+              }
+
+              declSmnt->up->remove(*declSmnt);
+              loopSmnt->addFirst(*declSmnt);
+              declSmnt->declarations[0].variable().attributes.erase("exclusive");
+            }
+          });
+      }
+
+      forStatement* serialParser::getExclusiveDemotionLoop(functionDeclStatement &kernelSmnt,
+                                                           declarationStatement &declSmnt) {
+        if (declSmnt.declarations.size() != 1) {
+          return NULL;
+        }
+
+        // Values computed before the loops would change if evaluated later
+        variableDeclaration &decl = declSmnt.declarations[0];
+        if (decl.value && !decl.value->canEvaluate()) {
+          return NULL;
+        }
+
+        // All uses need to be inside the same inner-most @inner loop
+        variable_t &var = decl.variable();
+        forStatement *loopSmnt = NULL;
+        bool isValid = true;
+        statementArray::from(kernelSmnt)
+          .flatFilterByExprType(exprNodeType::variable)
+          .forEach([&](smntExprNode smntExpr) {
+            if ((&(((variableNode*) smntExpr.node)->value) != &var)
+                || (smntExpr.smnt == &declSmnt)) {
+              return;
+            }
+
+            statement_t *smnt = smntExpr.smnt;
+            while (smnt
+                   && !((smnt->type() & statementType::for_)
+                        && smnt->hasAttribute("inner"))) {
+              smnt = smnt->up;
+            }
+
+            if (!smnt || (loopSmnt && (smnt != loopSmnt))) {
+              isValid = false;
+              return;
+            }
+            loopSmnt = (forStatement*) smnt;
+          });
+
+        if (!isValid || !loopSmnt) {
+          return NULL;
+        }
+
+        const int innerLoopCount = (
+          statementArray::from(*loopSmnt)
+          .flatFilterByStatementType(statementType::for_, "inner")
+          .length()
+        );
+        if (innerLoopCount > 1) {
+          return NULL;
+        }
+
+        // Enclosing loops would need the value to persist across iterations
+        for (statement_t *smnt = loopSmnt->up; smnt != declSmnt.up; smnt = smnt->up) {
+          if (!smnt || (smnt->type() & (statementType::for_ | statementType::while_))) {
+            return NULL;
+          }
+        }
+
+        return loopSmnt;
       }
 
       void serialParser::setupHeaders() {
@@ -104,6 +727,23 @@ namespace occa {
         }
       }
 
+      void serialParser::setupAtomics() {
+        success &= attributes::atomic::applyCodeTransformation(
+          root,
+          dropAtomicBlockStatement,
+          dropAtomicExpressionStatement
+        );
+      }
+
+      bool serialParser::dropAtomicBlockStatement(blockStatement &blockSmnt) {
+        // Kernels run single-threaded, the block runs as-is
+        return true;
+      }
+
+      bool serialParser::dropAtomicExpressionStatement(expressionStatement &exprSmnt) {
+        return true;
+      }
+
       void serialParser::setupExclusives() {
         // Get @exclusive declarations
         bool hasExclusiveVariables = false;
@@ -265,47 +905,111 @@ namespace occa {
         }
       }
 
-      int serialParser::getInnerLoopLevel(forStatement &forSmnt) {
-        statement_t *smnt = forSmnt.up;
-        int level = 0;
-        while (smnt) {
-          if ((smnt->type() & statementType::for_)
-              && smnt->hasAttribute("inner")) {
-            ++level;
+      bool serialParser::getInnerLoopNestSize(functionDeclStatement &kernelSmnt,
+                                              blockStatement &scopeSmnt,
+                                              forStatement &innerMostInnerLoop,
+                                              int &size,
+                                              std::string &runtimeSize) {
+        // Returns true if the size is known at compile time, otherwise
+        //   [runtimeSize] is set if it only depends on const kernel arguments
+        bool isKnown = true;
+        bool isRuntimeKnown = true;
+        size = 1;
+        runtimeSize = "";
+
+        statementArray path = oklForStatement::getOklLoopPath(innerMostInnerLoop);
+        const int pathCount = (int) path.length();
+        for (int i = 0; i < pathCount; ++i) {
+          forStatement &pathSmnt = *((forStatement*) path[i]);
+          if (!pathSmnt.hasAttribute("inner")) {
+            continue;
           }
-          smnt = smnt->up;
+
+          oklForStatement oklForSmnt(pathSmnt);
+          exprNode *count = oklForSmnt.getIterationCount();
+          if (!count) {
+            return false;
+          }
+
+          std::string dimSize;
+          if (count->canEvaluate()) {
+            const int dim = (int) count->evaluate();
+            size *= dim;
+            dimSize = occa::toString(dim);
+          } else {
+            const std::string s = count->toString();
+            if (s.find("_occa_tiled_") != std::string::npos) {
+              size_t tile_size = s.find_first_of("123456789");
+              OCCA_ERROR("@tile size is undefined!",tile_size != std::string::npos);
+              const int dim = std::stoi(s.substr(tile_size));
+              size *= dim;
+              dimSize = occa::toString(dim);
+            } else {
+              // Loop bounds are unknown at compile time
+              isKnown = false;
+              isRuntimeKnown &= isKernelInvariant(kernelSmnt, scopeSmnt, *count);
+              dimSize = "(" + s + ")";
+            }
+          }
+          delete count;
+
+          runtimeSize += (runtimeSize.size() ? " * " : "") + dimSize;
+        }
+
+        if (isKnown || !isRuntimeKnown) {
+          runtimeSize = "";
         }
-        return level;
+        return isKnown;
       }
 
-      forStatement* serialParser::getInnerMostInnerLoop(forStatement &forSmnt) {
-        int maxLevel = -1;
-        forStatement *innerMostInnerLoop = NULL;
+      bool serialParser::isKernelInvariant(functionDeclStatement &kernelSmnt,
+                                           blockStatement &scopeSmnt,
+                                           exprNode &expr) {
+        // Only const scalar kernel arguments are known before the @outer loops
+        for (exprNode *node : expr.getNestedChildren()) {
+          if (!(node->type() & exprNodeType::variable)) {
+            continue;
+          }
+          variable_t &var = ((variableNode*) node)->value;
 
-        statementArray::from(forSmnt)
-          .flatFilterByAttribute("inner")
-          .filterByStatementType(statementType::for_)
-          .forEach([&](statement_t *smnt) {
-            forStatement &innerSmnt = (forStatement&) *smnt;
-            const int level = getInnerLoopLevel(innerSmnt);
-            if (level > maxLevel) {
-              maxLevel = level;
-              innerMostInnerLoop = &innerSmnt;
-            }
-          });
+          const vartype_t &vartype = var.vartype;
+          if (!vartype.has(const_)
+              || vartype.isPointerType()
+              || vartype.arrays.size()) {
+            return false;
+          }
+
+          bool isArgument = false;
+          for (variable_t *arg : kernelSmnt.function().args) {
+            isArgument |= (arg == &var);
+          }
+          if (!isArgument) {
+            return false;
+          }
 
-        return innerMostInnerLoop;
+          // Make sure the name isn't shadowed where the storage is allocated
+          keyword_t &keyword = scopeSmnt.getScopeKeyword(var.name());
+          if ((keyword.type() != keywordType::variable)
+              || (&(((variableKeyword&) keyword).variable) != &var)) {
+            return false;
+          }
+        }
+        return true;
       }
 
       void serialParser::defineExclusiveVariableAsArray(declarationStatement &declSmnt,
                                                         variable_t &var) {
-        // Find outer-most outer loop
+        // Find outer-most outer loop and the kernel
         statement_t *smnt = declSmnt.up;
         forStatement *outerMostOuterLoop = NULL;
+        functionDeclStatement *kernelSmnt = NULL;
         while (smnt) {
           if (smnt->hasAttribute("outer")) {
             outerMostOuterLoop = (forStatement*) smnt;
           }
+          if (smnt->type() & statementType::functionDecl) {
+            kernelSmnt = (functionDeclStatement*) smnt;
+          }
           smnt = smnt->up;
         }
 
@@ -323,39 +1027,50 @@ namespace occa {
           }
         }
 
-        //Check if inner dimensions are known at compile time
+        // Check if inner dimensions are known at compile time, sizing for
+        //   the largest @inner loop nest since the exclusive index restarts
+        //   at 0 for each of them
         bool innerDimsKnown{true};
-        int knownInnerDims[3] = {1,1,1};
-        forStatement *innerSmnt = getInnerMostInnerLoop(*outerMostOuterLoop);
-        statementArray path = oklForStatement::getOklLoopPath(*innerSmnt);
+        int knownInnerDim = 1;
+        bool hasKnownNests{false};
+        std::set<std::string> runtimeInnerDims;
 
-        int innerIndex;
-        const int pathCount = (int) path.length();
-        for (int i = 0; i < pathCount; ++i) {
-          forStatement &pathSmnt = *((forStatement*) path[i]);
-          oklForStatement oklForSmnt(pathSmnt);
+        statementArray::from(*outerMostOuterLoop)
+          .flatFilterByAttribute("inner")
+          .filterByStatementType(statementType::for_)
+          .forEach([&](statement_t *innerSmnt) {
+            const bool hasNestedInnerLoops = (
+              statementArray::from(*innerSmnt)
+              .flatFilterByAttribute("inner")
+              .filterByStatementType(statementType::for_)
+              .length() > 1
+            );
+            if (hasNestedInnerLoops) {
+              return;
+            }
 
-          if(pathSmnt.hasAttribute("inner")) {
-            innerIndex = oklForSmnt.oklLoopIndex();
-            if(oklForSmnt.getIterationCount()->canEvaluate()) {
-              knownInnerDims[innerIndex] = (int) oklForSmnt.getIterationCount()->evaluate();
+            int nestSize;
+            std::string nestRuntimeSize;
+            if (getInnerLoopNestSize(*kernelSmnt,
+                                     *declSmnt.up,
+                                     (forStatement&) *innerSmnt,
+                                     nestSize,
+                                     nestRuntimeSize)) {
+              knownInnerDim = std::max(knownInnerDim, nestSize);
+              hasKnownNests = true;
             } else {
-              std::string s = oklForSmnt.getIterationCount()->toString();
-              if(s.find("_occa_tiled_") != std::string::npos) {
-                size_t tile_size = s.find_first_of("123456789");
-                OCCA_ERROR("@tile size is undefined!",tile_size != std::string::npos);
-                knownInnerDims[innerIndex] = std::stoi(s.substr(tile_size));
-              } else {
-                //loop bounds are unknown at compile time
-                innerDimsKnown=false;
-                break;
-              }
+              innerDimsKnown = false;
+              runtimeInnerDims.insert(nestRuntimeSize);
             }
-          }
-        }
-        const int knownInnerDim =  knownInnerDims[0]
-                                 * knownInnerDims[1]
-                                 * knownInnerDims[2];
+          });
+
+        // Runtime sizes are only used when every nest has the same one
+        const bool runtimeInnerDimKnown = (
+          !hasKnownNests
+          && (runtimeInnerDims.size() == 1)
+          && runtimeInnerDims.begin()->size()
+        );
+
         const int maxInnerDim =  maxInnerDims[0]
                                * maxInnerDims[1]
                                * maxInnerDims[2];
@@ -368,6 +1083,13 @@ namespace occa {
           }
         }
 
+        if (!innerDimsKnown
+            && !maxInnerDimsKnown
+            && runtimeInnerDimKnown
+            && defineExclusiveVariableStorage(declSmnt, var, *runtimeInnerDims.begin())) {
+          return;
+        }
+
         // Determine how long the exclusive array should be
         int exclusiveArraySize = 1024;
         if (maxInnerDimsKnown) {
@@ -376,6 +1098,10 @@ namespace occa {
         if (innerDimsKnown) {
           exclusiveArraySize = knownInnerDim;
         }
+        if (!innerDimsKnown && !maxInnerDimsKnown) {
+          var.printWarning("Unable to size [@exclusive] storage from the [@inner] loop bounds,"
+                           " defaulting to 1024 entries per thread. Use [@max_inner_dims] to size it");
+        }
 
         // Make exclusive variable declaration into an array
         // For example:
@@ -395,6 +1121,58 @@ namespace occa {
         );
       }
 
+      bool serialParser::defineExclusiveVariableStorage(declarationStatement &declSmnt,
+                                                        variable_t &var,
+                                                        const std::string &size) {
+        // Runtime-sized storage is kept per thread and reused across
+        //   @outer loop iterations, growing only when the size does
+        // For example:
+        //    float x;
+        // -> static thread_local std::vector<float> _occa_exclusive_x;
+        //    _occa_exclusive_x.resize(N);
+        //    float *x = _occa_exclusive_x.data();
+        variableDeclaration *decl = NULL;
+        for (variableDeclaration &declaration : declSmnt.declarations) {
+          if (&(declaration.variable()) == &var) {
+            decl = &declaration;
+          }
+        }
+
+        // Initializers and arrays keep using fixed-size arrays
+        vartype_t &vartype = var.vartype;
+        if (!decl
+            || decl->value
+            || vartype.has(const_)
+            || vartype.isReference()
+            || vartype.arrays.size()) {
+          return false;
+        }
+
+        const std::string storageName = "_occa_exclusive_" + var.name();
+        blockStatement &blockSmnt = *(declSmnt.up);
+
+        printer pout;
+        pout << "static thread_local std::vector<" << vartype << "> " << storageName << ';';
+        blockSmnt.addBefore(
+          declSmnt,
+          *(new sourceCodeStatement(&blockSmnt,
+                                    declSmnt.source,
+                                    pout.str()))
+        );
+        blockSmnt.addBefore(
+          declSmnt,
+          *(new sourceCodeStatement(&blockSmnt,
+                                    declSmnt.source,
+                                    storageName + ".resize(" + size + ");"))
+        );
+
+        vartype.pointers.push_back(pointer_t());
+        decl->value = new identifierNode(var.source,
+                                         storageName + ".data()");
+
+        return true;
+      }
+
       exprNode* serialParser::addExclusiveVariableArrayAccessor(statement_t &smnt,
                                                                 exprNode &expr,
                                                                 variable_t &var) {
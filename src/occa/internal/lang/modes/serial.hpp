@@ -6,6 +6,8 @@
 namespace occa {
   namespace lang {
     namespace okl {
+      class sharedMemoryAccesses;
+
       class serialParser : public parser_t {
        public:
         static const std::string exclusiveIndexName;
@@ -16,23 +18,79 @@ namespace occa {
 
         virtual void afterParsing();
 
+        void setupKernelFusion();
+
+        void setupSpecializations();
+
+        void setupUnrolls();
+
+        static std::string getUnrollPragmaSource(const int count);
+
+        void setupSharedHoisting();
+
+        static bool hoistSharedFill(functionDeclStatement &kernelSmnt,
+                                    const sharedMemoryAccesses &kernelAccesses,
+                                    forStatement &outerSmnt,
+                                    forStatement &fillSmnt);
+
+        static exprNode* getOuterLoopsGuard(functionDeclStatement &kernelSmnt,
+                                            const sharedMemoryAccesses &kernelAccesses,
+                                            forStatement &outerSmnt,
+                                            statement_t *&topOuterSmnt);
+
+        static bool isUnmodifiedArgument(functionDeclStatement &kernelSmnt,
+                                         const sharedMemoryAccesses &kernelAccesses,
+                                         variable_t &var);
+
+        void setupInnerLoopFusion();
+
+        void fuseInnerLoops(functionDeclStatement &kernelSmnt,
+                            blockStatement &blockSmnt);
+
+        static bool canFuseInnerLoops(functionDeclStatement &kernelSmnt,
+                                      forStatement &forSmnt,
+                                      forStatement &nextForSmnt);
+
+        static void fuseInnerLoop(forStatement &forSmnt,
+                                  forStatement &nextForSmnt);
+
+        void setupExclusiveDemotions();
+
+        static forStatement* getExclusiveDemotionLoop(functionDeclStatement &kernelSmnt,
+                                                      declarationStatement &declSmnt);
+
         void setupHeaders();
 
         void setupKernels();
 
         static void setupKernel(functionDeclStatement &kernelSmnt);
 
+        virtual void setupAtomics();
+
+        static bool dropAtomicBlockStatement(blockStatement &blockSmnt);
+        static bool dropAtomicExpressionStatement(expressionStatement &exprSmnt);
+
         void setupExclusives();
         void setupExclusiveDeclaration(declarationStatement &declSmnt);
         void setupExclusiveIndices();
 
-        int getInnerLoopLevel(forStatement &forSmnt);
+        static bool getInnerLoopNestSize(functionDeclStatement &kernelSmnt,
+                                         blockStatement &scopeSmnt,
+                                         forStatement &innerMostInnerLoop,
+                                         int &size,
+                                         std::string &runtimeSize);
 
-        forStatement* getInnerMostInnerLoop(forStatement &forSmnt);
+        static bool isKernelInvariant(functionDeclStatement &kernelSmnt,
+                                      blockStatement &scopeSmnt,
+                                      exprNode &expr);
 
         void defineExclusiveVariableAsArray(declarationStatement &declSmnt,
                                             variable_t &var);
 
+        static bool defineExclusiveVariableStorage(declarationStatement &declSmnt,
+                                                   variable_t &var,
+                                                   const std::string &size);
+
         exprNode* addExclusiveVariableArrayAccessor(statement_t &smnt,
                                                     exprNode &expr,
                                                     variable_t &var);
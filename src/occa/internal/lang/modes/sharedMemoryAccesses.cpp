@@ -0,0 +1,497 @@
+#include <algorithm>
+
+#include <occa/internal/lang/expr.hpp>
+#include <occa/internal/lang/statement.hpp>
+#include <occa/internal/lang/variable.hpp>
+#include <occa/internal/lang/modes/oklForStatement.hpp>
+#include <occa/internal/lang/modes/sharedMemoryAccesses.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace okl {
+      sharedMemoryAccesses::sharedMemoryAccesses(functionDeclStatement &kernelSmnt,
+                                                 const bool includeNonShared_) :
+        innerDimCount(getInnerDimCount(kernelSmnt)),
+        includeNonShared(includeNonShared_),
+        hasUnknownAccesses(false) {}
+
+      void sharedMemoryAccesses::add(statement_t &smnt) {
+        statementArray::from(smnt)
+          .nestedForEach([&](statement_t *innerSmnt) {
+            addStatement(*innerSmnt);
+          });
+      }
+
+      bool sharedMemoryAccesses::isEmpty() const {
+        return accesses.empty() && !hasUnknownAccesses;
+      }
+
+      bool sharedMemoryAccesses::conflictsWith(const sharedMemoryAccesses &other) const {
+        if (isEmpty() || other.isEmpty()) {
+          return false;
+        }
+        if (hasUnknownAccesses || other.hasUnknownAccesses) {
+          return true;
+        }
+
+        for (const access_t &access : accesses) {
+          for (const access_t &otherAccess : other.accesses) {
+            if (accessesConflict(access, otherAccess)) {
+              return true;
+            }
+          }
+        }
+        return false;
+      }
+
+      bool sharedMemoryAccesses::accessesConflict(const access_t &a,
+                                                  const access_t &b) {
+        if ((a.variable != b.variable)
+            || !(a.isWrite || b.isWrite)) {
+          return false;
+        }
+        // Entries of different non-@shared arrays can't be matched by thread
+        if (a.arrayVariable != b.arrayVariable) {
+          return mayAlias(a.arrayVariable, b.arrayVariable);
+        }
+        // Threads only touching their own entry don't need to synchronize
+        const bool isSameThread = (
+          a.threadSignature.size()
+          && (a.threadSignature == b.threadSignature)
+        );
+        return !isSameThread;
+      }
+
+      bool sharedMemoryAccesses::mayAlias(variable_t *a,
+                                          variable_t *b) {
+        if (!a || !b) {
+          return true;
+        }
+        // Arrays are their own memory
+        if (!a->vartype.pointers.size() && !b->vartype.pointers.size()) {
+          return false;
+        }
+        return !(a->hasAttribute("restrict") || b->hasAttribute("restrict"));
+      }
+
+      int sharedMemoryAccesses::getInnerDimCount(functionDeclStatement &kernelSmnt) {
+        int dimCount = 0;
+        statementArray::from(kernelSmnt)
+          .flatFilterByStatementType(statementType::for_, "inner")
+          .forEach([&](statement_t *smnt) {
+            const int loopIndex = oklForStatement::getOklLoopIndex(*((forStatement*) smnt),
+                                                                   "inner");
+            dimCount = std::max(dimCount, loopIndex + 1);
+          });
+        return dimCount;
+      }
+
+      std::string sharedMemoryAccesses::getInnerLoopSignature(forStatement &forSmnt,
+                                                              const bool allowSymbolic) {
+        oklForStatement oklForSmnt(forSmnt, "", false);
+        if (!oklForSmnt.isValid()) {
+          return "";
+        }
+
+        // Threads get the same iterator value only if the loops start
+        //   and step the same way
+        exprNode *initValue = oklForSmnt.initValue;
+        exprNode *updateValue = oklForSmnt.updateValue;
+        const bool canEvaluate = (
+          initValue->canEvaluate()
+          && (!updateValue || updateValue->canEvaluate())
+        );
+        if (!canEvaluate && !allowSymbolic) {
+          return "";
+        }
+
+        std::string signature = occa::toString(oklForSmnt.oklLoopIndex()) + ':';
+        if (canEvaluate) {
+          signature += initValue->evaluate().toString();
+        } else {
+          signature += initValue->toString();
+        }
+        signature += ':';
+        signature += (oklForSmnt.positiveUpdate ? '+' : '-');
+        if (!updateValue) {
+          signature += '1';
+        } else if (canEvaluate) {
+          signature += updateValue->evaluate().toString();
+        } else {
+          signature += updateValue->toString();
+        }
+        return signature;
+      }
+
+      bool sharedMemoryAccesses::isTracked(variable_t &var) const {
+        if (var.hasAttribute("shared")) {
+          return true;
+        }
+        return (
+          includeNonShared
+          && !var.hasAttribute("exclusive")
+          && !localVariables.count(&var)
+        );
+      }
+
+      void sharedMemoryAccesses::addStatement(statement_t &smnt) {
+        const int smntType = smnt.type();
+
+        // Can't see what raw source or jumps do
+        if (smntType & (statementType::sourceCode |
+                        statementType::goto_ |
+                        statementType::gotoLabel)) {
+          hasUnknownAccesses = true;
+          return;
+        }
+
+        if (!(smntType & statementType::declaration)) {
+          for (smntExprNode smntExpr : smnt.getDirectExprNodes()) {
+            addExpr(smnt, smntExpr.node, true, false);
+          }
+          return;
+        }
+
+        // Skip the declared variables, such as the @shared arrays themselves
+        declarationStatement &declSmnt = (declarationStatement&) smnt;
+        for (variableDeclaration &decl : declSmnt.declarations) {
+          if (decl.hasVariable()) {
+            localVariables.insert(&decl.variable());
+          }
+
+          const size_t accessCount = accesses.size();
+          addExpr(smnt, decl.value, true, false);
+
+          // Pointers and references would alias @shared memory
+          if (!decl.hasVariable() || (accesses.size() == accessCount)) {
+            continue;
+          }
+          const vartype_t &vartype = decl.variable().vartype;
+          if (vartype.isPointerType() || vartype.isReference()) {
+            hasUnknownAccesses = true;
+          }
+        }
+      }
+
+      void sharedMemoryAccesses::addExpr(statement_t &smnt,
+                                         exprNode *expr,
+                                         const bool isRead,
+                                         const bool isWrite) {
+        if (!expr) {
+          return;
+        }
+
+        const udim_t exprType = expr->type();
+
+        if (exprType & exprNodeType::variable) {
+          variable_t &var = ((variableNode*) expr)->value;
+          if (!isTracked(var)) {
+            return;
+          }
+          // Arrays and pointers used without indices can't be followed
+          if (var.vartype.arrays.size() || var.vartype.pointers.size()) {
+            hasUnknownAccesses = true;
+          }
+          addAccess(&var, isRead, isWrite);
+          return;
+        }
+
+        if (exprType & exprNodeType::subscript) {
+          // Unwrap a[i][j] into the array and its indices
+          exprNodeVector indices;
+          exprNode *value = expr;
+          while (value->type() & exprNodeType::subscript) {
+            subscriptNode &subscript = (subscriptNode&) *value;
+            indices.insert(indices.begin(), subscript.index);
+            value = subscript.value;
+          }
+          while (value->type() & exprNodeType::parentheses) {
+            value = ((parenthesesNode*) value)->value;
+          }
+
+          for (exprNode *index : indices) {
+            addExpr(smnt, index, true, false);
+          }
+
+          if (value->type() & exprNodeType::variable) {
+            variable_t &var = ((variableNode*) value)->value;
+            const vartype_t &vartype = var.vartype;
+            const size_t dimCount = vartype.arrays.size() + vartype.pointers.size();
+            if (isTracked(var) && (indices.size() == dimCount)) {
+              addArrayAccess(smnt,
+                             var,
+                             indices,
+                             isRead,
+                             isWrite);
+              return;
+            }
+          }
+
+          addExpr(smnt, value, isRead, isWrite);
+          return;
+        }
+
+        if (exprType & exprNodeType::binary) {
+          binaryOpNode &opNode = (binaryOpNode&) *expr;
+          const opType_t opType = opNode.opType();
+
+          if (opType & operatorType::assignment) {
+            // Compound assignments also read the updated value
+            addExpr(smnt, opNode.leftValue, !(opType & operatorType::assign), true);
+            addExpr(smnt, opNode.rightValue, true, false);
+            return;
+          }
+
+          // Operators such as member access keep how their value is used
+          addExpr(smnt, opNode.leftValue, isRead, isWrite);
+          addExpr(smnt, opNode.rightValue, isRead, isWrite);
+          return;
+        }
+
+        if (exprType & (exprNodeType::leftUnary | exprNodeType::rightUnary)) {
+          const opType_t opType = ((exprOpNode*) expr)->opType();
+          exprNode *value = (
+            (exprType & exprNodeType::leftUnary)
+            ? ((leftUnaryOpNode*) expr)->value
+            : ((rightUnaryOpNode*) expr)->value
+          );
+
+          if (opType & operatorType::address) {
+            // Pointers to @shared memory can't be followed
+            const size_t accessCount = accesses.size();
+            addExpr(smnt, value, true, true);
+            if (accesses.size() > accessCount) {
+              hasUnknownAccesses = true;
+            }
+            return;
+          }
+
+          const bool isUpdate = (opType & (operatorType::increment |
+                                           operatorType::decrement));
+          addExpr(smnt, value, isRead || isUpdate, isWrite || isUpdate);
+          return;
+        }
+
+        if (exprType & exprNodeType::call) {
+          callNode &call = (callNode&) *expr;
+          addExpr(smnt, call.value, true, false);
+          // Arguments could be passed by reference
+          for (exprNode *arg : call.args) {
+            addExpr(smnt, arg, true, true);
+          }
+          return;
+        }
+
+        exprNodeVector children;
+        expr->pushChildNodes(children);
+        for (exprNode *child : children) {
+          addExpr(smnt, child, isRead, isWrite);
+        }
+      }
+
+      void sharedMemoryAccesses::addArrayAccess(statement_t &smnt,
+                                                variable_t &var,
+                                                const exprNodeVector &indices,
+                                                const bool isRead,
+                                                const bool isWrite) {
+        const bool isShared = var.hasAttribute("shared");
+        addAccess(isShared ? &var : NULL,
+                  isRead,
+                  isWrite,
+                  getThreadSignature(smnt, indices),
+                  isShared ? NULL : &var);
+      }
+
+      void sharedMemoryAccesses::addAccess(variable_t *var,
+                                           const bool isRead,
+                                           const bool isWrite,
+                                           const std::string &threadSignature,
+                                           variable_t *arrayVariable) {
+        access_t access;
+        access.variable = var;
+        access.arrayVariable = arrayVariable;
+        access.isRead = isRead;
+        access.isWrite = isWrite;
+        access.threadSignature = threadSignature;
+        accesses.push_back(access);
+      }
+
+      std::string sharedMemoryAccesses::getThreadSignature(statement_t &smnt,
+                                                           const exprNodeVector &indices) {
+        std::vector<forStatement*> innerLoops;
+        for (statement_t *up = &smnt; up; up = up->up) {
+          if ((up->type() & statementType::for_)
+              && up->hasAttribute("inner")) {
+            innerLoops.push_back((forStatement*) up);
+          }
+        }
+
+        // Every thread dimension needs to show up in the indices,
+        //   otherwise threads would share entries
+        const int loopCount = (int) innerLoops.size();
+        if (!loopCount
+            || (loopCount != innerDimCount)
+            || (loopCount != (int) indices.size())) {
+          return "";
+        }
+
+        std::vector<variable_t*> iterators;
+        for (forStatement *loopSmnt : innerLoops) {
+          oklForStatement oklForSmnt(*loopSmnt, "", false);
+          if (!oklForSmnt.isValid()) {
+            return "";
+          }
+          iterators.push_back(oklForSmnt.iterator);
+        }
+
+        std::vector<bool> usedLoops(loopCount, false);
+        std::string signature;
+        for (exprNode *index : indices) {
+          int loopIndex = -1;
+          std::string indexSignature;
+          if (!getIndexSignature(*index, innerLoops, iterators, loopIndex, indexSignature)
+              || usedLoops[loopIndex]) {
+            return "";
+          }
+          usedLoops[loopIndex] = true;
+
+          signature += indexSignature;
+          signature += ';';
+        }
+
+        return signature;
+      }
+
+      bool sharedMemoryAccesses::getIndexSignature(exprNode &expr,
+                                                   const std::vector<forStatement*> &innerLoops,
+                                                   const std::vector<variable_t*> &iterators,
+                                                   int &loopIndex,
+                                                   std::string &signature) {
+        const udim_t exprType = expr.type();
+
+        if (exprType & exprNodeType::parentheses) {
+          return getIndexSignature(*(((parenthesesNode&) expr).value),
+                                   innerLoops,
+                                   iterators,
+                                   loopIndex,
+                                   signature);
+        }
+
+        if (exprType & exprNodeType::variable) {
+          variable_t *var = &(((variableNode&) expr).value);
+          const int loopCount = (int) iterators.size();
+          for (int i = 0; i < loopCount; ++i) {
+            if (iterators[i] != var) {
+              continue;
+            }
+            const std::string loopSignature = getInnerLoopSignature(*innerLoops[i],
+                                                                    includeNonShared);
+            if (loopSignature.empty()) {
+              return false;
+            }
+            loopIndex = i;
+            signature = '{' + loopSignature + '}';
+            return true;
+          }
+          return false;
+        }
+
+        if (!(exprType & exprNodeType::binary)) {
+          return false;
+        }
+
+        // Only keep index expressions where each thread gets its own entry:
+        //   iterator +/- (same for all threads)
+        //   iterator * (non-zero integer)
+        binaryOpNode &opNode = (binaryOpNode&) expr;
+        const opType_t opType = opNode.opType();
+        exprNode &leftValue = *(opNode.leftValue);
+        exprNode &rightValue = *(opNode.rightValue);
+
+        std::string leftSignature, rightSignature;
+        bool isValid = false;
+        if (opType & (operatorType::add | operatorType::sub)) {
+          isValid = (
+            (getIndexSignature(leftValue, innerLoops, iterators, loopIndex, leftSignature)
+             && getInvariantSignature(rightValue, iterators, rightSignature))
+            || (getInvariantSignature(leftValue, iterators, leftSignature)
+                && getIndexSignature(rightValue, innerLoops, iterators, loopIndex, rightSignature))
+          );
+        } else if (opType & operatorType::mult) {
+          const auto isScale = [&](exprNode &value) {
+            if (!value.canEvaluate()) {
+              return false;
+            }
+            const primitive scale = value.evaluate();
+            return scale.isInteger() && ((int64_t) scale != 0);
+          };
+          isValid = (
+            (isScale(rightValue)
+             && getIndexSignature(leftValue, innerLoops, iterators, loopIndex, leftSignature)
+             && getInvariantSignature(rightValue, iterators, rightSignature))
+            || (isScale(leftValue)
+                && getInvariantSignature(leftValue, iterators, leftSignature)
+                && getIndexSignature(rightValue, innerLoops, iterators, loopIndex, rightSignature))
+          );
+        }
+
+        if (isValid) {
+          signature = '(' + leftSignature + opNode.op.str + rightSignature + ')';
+        }
+        return isValid;
+      }
+
+      bool sharedMemoryAccesses::getInvariantSignature(exprNode &expr,
+                                                       const std::vector<variable_t*> &iterators,
+                                                       std::string &signature) {
+        if (expr.canEvaluate()) {
+          signature = expr.evaluate().toString();
+          return true;
+        }
+
+        const udim_t exprType = expr.type();
+
+        if (exprType & exprNodeType::parentheses) {
+          return getInvariantSignature(*(((parenthesesNode&) expr).value),
+                                       iterators,
+                                       signature);
+        }
+
+        if (exprType & exprNodeType::variable) {
+          // Variables could change between loops unless they are tracked
+          variable_t &var = ((variableNode&) expr).value;
+          const bool isInvariant = (
+            includeNonShared
+            && isTracked(var)
+            && !var.hasAttribute("shared")
+            && !var.vartype.arrays.size()
+            && !var.vartype.pointers.size()
+            && (std::find(iterators.begin(), iterators.end(), &var) == iterators.end())
+          );
+          if (isInvariant) {
+            // Keep shadowed variables with the same name apart
+            signature = var.name() + '@' + occa::toString((void*) &var);
+          }
+          return isInvariant;
+        }
+
+        if (exprType & exprNodeType::binary) {
+          binaryOpNode &opNode = (binaryOpNode&) expr;
+          std::string leftSignature, rightSignature;
+          const bool isInvariant = (
+            (opNode.opType() & (operatorType::arithmetic |
+                                operatorType::bitOp))
+            && getInvariantSignature(*(opNode.leftValue), iterators, leftSignature)
+            && getInvariantSignature(*(opNode.rightValue), iterators, rightSignature)
+          );
+          if (isInvariant) {
+            signature = '(' + leftSignature + opNode.op.str + rightSignature + ')';
+          }
+          return isInvariant;
+        }
+
+        return false;
+      }
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#ifndef OCCA_INTERNAL_LANG_MODES_SHAREDMEMORYACCESSES_HEADER
+#define OCCA_INTERNAL_LANG_MODES_SHAREDMEMORYACCESSES_HEADER
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <occa/internal/lang/expr/exprNode.hpp>
+#include <occa/internal/lang/statement.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace okl {
+      //---[ Shared Memory Accesses ]---
+      // Conservative summary of the @shared reads and writes in a set of
+      //   statements, used to find barriers that don't order any of them.
+      //
+      // An access is thread-private when each index maps a different
+      //   @inner loop iterator to its own entry, such as s[j][i + 1]
+      //   inside @inner loops over j and i:
+      //
+      //   for (...; @inner) { s[i] = x[i]; }
+      //   for (...; @inner) { y[i] = s[i]; }  <- Same thread, no barrier needed
+      //
+      // Accesses that can't be tracked, such as taking the address of
+      //   @shared memory or raw source code, conflict with everything
+      //
+      // With [includeNonShared], variables declared outside the added
+      //   statements are tracked as well, except @exclusive ones.
+      //   All pointer and array memory is treated as a single object
+      //   since kernel arguments could alias
+      class sharedMemoryAccesses {
+      public:
+        struct access_t {
+          // NULL for non-@shared pointer or array memory
+          variable_t *variable;
+          // Pointer or array indexed by non-@shared accesses
+          variable_t *arrayVariable;
+          bool isRead;
+          bool isWrite;
+          // Empty unless the access is thread-private, in which case it
+          //   identifies the thread-to-entry mapping
+          std::string threadSignature;
+        };
+
+        const int innerDimCount;
+        const bool includeNonShared;
+        std::vector<access_t> accesses;
+        bool hasUnknownAccesses;
+
+        sharedMemoryAccesses(functionDeclStatement &kernelSmnt,
+                             const bool includeNonShared_ = false);
+
+        // Adds accesses from [smnt] and all of its inner statements
+        void add(statement_t &smnt);
+
+        bool isEmpty() const;
+
+        bool conflictsWith(const sharedMemoryAccesses &other) const;
+
+        static bool accessesConflict(const access_t &a,
+                                     const access_t &b);
+
+        // Distinct pointers could still point to overlapping memory
+        //   unless one of them is @restrict
+        static bool mayAlias(variable_t *a,
+                             variable_t *b);
+
+        static int getInnerDimCount(functionDeclStatement &kernelSmnt);
+
+        // Loop bounds are compared by their source when [allowSymbolic] is set,
+        //   which is only safe if variables used by them are tracked too
+        static std::string getInnerLoopSignature(forStatement &forSmnt,
+                                                 const bool allowSymbolic = false);
+
+      private:
+        std::set<variable_t*> localVariables;
+
+        bool isTracked(variable_t &var) const;
+
+        void addStatement(statement_t &smnt);
+
+        void addExpr(statement_t &smnt,
+                     exprNode *expr,
+                     const bool isRead,
+                     const bool isWrite);
+
+        void addArrayAccess(statement_t &smnt,
+                            variable_t &var,
+                            const exprNodeVector &indices,
+                            const bool isRead,
+                            const bool isWrite);
+
+        void addAccess(variable_t *var,
+                       const bool isRead,
+                       const bool isWrite,
+                       const std::string &threadSignature = "",
+                       variable_t *arrayVariable = NULL);
+
+        std::string getThreadSignature(statement_t &smnt,
+                                       const exprNodeVector &indices);
+
+        bool getIndexSignature(exprNode &expr,
+                               const std::vector<forStatement*> &innerLoops,
+                               const std::vector<variable_t*> &iterators,
+                               int &loopIndex,
+                               std::string &signature);
+
+        bool getInvariantSignature(exprNode &expr,
+                                   const std::vector<variable_t*> &iterators,
+                                   std::string &signature);
+      };
+      //================================
+    }
+  }
+}
+
+#endif
@@ -1,6 +1,9 @@
+#include <algorithm>
+
 #include <occa/internal/utils/string.hpp>
 #include <occa/internal/lang/modes/withLauncher.hpp>
 #include <occa/internal/lang/modes/okl.hpp>
+#include <occa/internal/lang/modes/kernelFusion.hpp>
 #include <occa/internal/lang/modes/oklForStatement.hpp>
 #include <occa/internal/lang/builtins/attributes.hpp>
 #include <occa/internal/lang/builtins/types.hpp>
@@ -38,9 +41,16 @@ namespace occa {
 
       void withLauncher::launcherClear() {
         launcherParser.clear();
+        removedBarriers.clear();
       }
 
       void withLauncher::afterParsing() {
+        if (!success) return;
+        setupKernelFusion();
+
+        if (!success) return;
+        setupSpecializations();
+
         if (!success) return;
         if (settings.get("okl/validate", true)) {
           success = kernelsAreValid(root);
@@ -49,6 +59,12 @@ namespace occa {
         if (!success) return;
         setOklLoopIndices();
 
+        if (!success) return;
+        setupUnrolls();
+
+        if (!success) return;
+        setupReductions();
+
         if (!success) return;
         setupLauncherParser();
 
@@ -82,6 +98,29 @@ namespace occa {
           .forEachKernelStatement(okl::setOklLoopIndices);
       }
 
+      void withLauncher::setupKernelFusion() {
+        success = fuseKernels(root,
+                              settings.getPathValue("okl/fusion"));
+      }
+
+      void withLauncher::setupSpecializations() {
+        success = specializeKernelArguments(root,
+                                            settings.getPathValue("okl/specialize"));
+      }
+
+      void withLauncher::setupUnrolls() {
+        success = attributes::unroll::applyCodeTransformations(root,
+                                                               getUnrollPragmaSource);
+      }
+
+      std::string withLauncher::getUnrollPragmaSource(const int count) {
+        // Device compilers fully unroll when no factor is given
+        if (!count) {
+          return "unroll";
+        }
+        return "unroll " + occa::toString(count);
+      }
+
       void withLauncher::setupLauncherParser() {
         // Clone source
         blockStatement &rootClone = (blockStatement&) root.clone();
@@ -524,7 +563,7 @@ namespace occa {
               if (isOuterMostInnerLoop(innerSmnt)
                   && (!isLastInnerLoop(innerSmnt) || isInsideLoop(innerSmnt))
                   && !(innerSmnt.hasAttribute("nobarrier"))
-                 ) addBarriersAfterInnerLoop(innerSmnt);
+                 ) addBarriersAfterInnerLoop(kernelSmnt, innerSmnt);
             });
         }
 
@@ -537,16 +576,28 @@ namespace occa {
           });
       }
 
-      void withLauncher::addBarriersAfterInnerLoop(forStatement &forSmnt) {
-        const bool noSharedWrites = (
-          statementArray::from(forSmnt)
-          .flatFilter([&](smntExprNode smntExpr) {
-            return writesToShared(*smntExpr.node);
-          })
-          .isEmpty()
-        );
+      void withLauncher::addBarriersAfterInnerLoop(functionDeclStatement &kernelSmnt,
+                                                   forStatement &forSmnt) {
+        sharedMemoryAccesses loopAccesses(kernelSmnt);
+        loopAccesses.add(forSmnt);
 
-        if (noSharedWrites) {
+        if (loopAccesses.isEmpty()) {
+          return;
+        }
+
+        if (settings.get("okl/analyze_barriers", true)
+            && !needsBarrierAfterInnerLoop(kernelSmnt, forSmnt, loopAccesses)) {
+          const fileOrigin &origin = forSmnt.source->origin;
+          const std::string location = (
+            (origin.file ? origin.file->filename : std::string("(source)"))
+            + ':' + occa::toString(origin.position.line)
+          );
+          removedBarriers.push_back(location);
+
+          if (settings.get("verbose", false)) {
+            io::stdout << "Removed barrier after [@inner] loop in kernel ["
+                       << kernelSmnt.function().name() << "] at " << location << '\n';
+          }
           return;
         }
 
@@ -567,19 +618,35 @@ namespace occa {
                              barrierSmnt);
       }
 
-      bool withLauncher::writesToShared(exprNode &expr) {
-        // TODO 1.1: Propertly check read<-->write or write<-->write ordering
-        // exprOpNode &opNode = (exprOpNode&) expr;
-        // if (!(opNode.opType() & (operatorType::increment |
-        //                          operatorType::decrement |
-        //                          operatorType::assignment))) {
-        //   return false;
-        // }
+      bool withLauncher::needsBarrierAfterInnerLoop(functionDeclStatement &kernelSmnt,
+                                                    forStatement &forSmnt,
+                                                    const sharedMemoryAccesses &loopAccesses) {
+        // Aliased @shared memory could be accessed anywhere
+        sharedMemoryAccesses kernelAccesses(kernelSmnt);
+        kernelAccesses.add(kernelSmnt);
+        if (kernelAccesses.hasUnknownAccesses) {
+          return true;
+        }
 
-        // Get updated variable
-        variable_t *var = expr.getVariable();
-        return (var &&
-                var->hasAttribute("shared"));
+        // Collect what could run after the loop before the launch ends:
+        //   - Later statements in each enclosing block
+        //   - Entire enclosing loops, since their next iteration reruns the loop
+        sharedMemoryAccesses laterAccesses(kernelSmnt);
+        statement_t *smnt = &forSmnt;
+        while (smnt->up
+               && !(smnt->up->type() & statementType::functionDecl)) {
+          blockStatement &parent = *(smnt->up);
+          if (parent.type() & (statementType::for_ | statementType::while_)) {
+            laterAccesses.add(parent);
+          } else {
+            for (int i = smnt->childIndex() + 1; i < parent.size(); ++i) {
+              laterAccesses.add(*parent[i]);
+            }
+          }
+          smnt = &parent;
+        }
+
+        return loopAccesses.conflictsWith(laterAccesses);
       }
 
       void withLauncher::replaceOccaFor(forStatement &forSmnt) {
@@ -622,6 +689,229 @@ namespace occa {
         delete &forSmnt;
       }
 
+      void withLauncher::setupReductions() {
+        statementArray::from(root)
+          .flatFilterByStatementType(statementType::for_, "reduction")
+          .forEach([&](statement_t *smnt) {
+            if (!success) {
+              return;
+            }
+
+            forStatement &forSmnt = (forStatement&) *smnt;
+            if (forSmnt.hasAttribute("outer")) {
+              forSmnt.printError("[@reduction] on [@outer] loops is only supported"
+                                 " in Serial and OpenMP modes");
+              success = false;
+              return;
+            }
+            if (!isOuterMostInnerLoop(forSmnt)) {
+              forSmnt.printError("[@reduction] can only be used on the outer-most [@inner] loop");
+              success = false;
+              return;
+            }
+
+            attributes::reduction::reductionVarVector reductions;
+            if (!attributes::reduction::getReductions(forSmnt.attributes["reduction"],
+                                                      reductions)) {
+              success = false;
+              return;
+            }
+
+            for (auto &reductionVar : reductions) {
+              if (!isDeclaredInOuterLoop(forSmnt, *reductionVar.variable)) {
+                forSmnt.printError("[@reduction] variable [" + reductionVar.variable->name() + "]"
+                                   " must be declared inside an [@outer] loop");
+                success = false;
+                return;
+              }
+            }
+
+            addReductionTree(forSmnt,
+                             reductions,
+                             getInnerThreadCapacity(forSmnt));
+          });
+      }
+
+      bool withLauncher::isDeclaredInOuterLoop(forStatement &forSmnt,
+                                               variable_t &var) {
+        const std::string &name = var.name();
+
+        // Find where the variable is declared and make sure it's inside an @outer loop
+        bool foundDeclaration = false;
+        statement_t *smnt = forSmnt.up;
+        while (smnt) {
+          if (!foundDeclaration
+              && (smnt->type() & statementType::blockStatements)) {
+            foundDeclaration = ((blockStatement*) smnt)->hasDirectlyInScope(name);
+          }
+          if (foundDeclaration
+              && (smnt->type() & statementType::for_)
+              && smnt->hasAttribute("outer")) {
+            return true;
+          }
+          smnt = smnt->up;
+        }
+        return false;
+      }
+
+      int withLauncher::getInnerThreadCapacity(forStatement &forSmnt) {
+        forStatement *outerMostOuterLoop = NULL;
+        for (auto &parentSmnt : forSmnt.getParentPath()) {
+          if ((parentSmnt->type() & statementType::for_)
+              && parentSmnt->hasAttribute("outer")) {
+            outerMostOuterLoop = (forStatement*) parentSmnt;
+            break;
+          }
+        }
+
+        // Use the largest known @inner loop dimensions of the launch
+        bool innerDimsKnown = true;
+        int innerDims[3] = {1, 1, 1};
+        statementArray::from(*outerMostOuterLoop)
+          .flatFilterByAttribute("inner")
+          .filterByStatementType(statementType::for_)
+          .forEach([&](statement_t *smnt) {
+            oklForStatement oklForSmnt(*((forStatement*) smnt));
+            exprNode *iterationCount = oklForSmnt.getIterationCount();
+            if (iterationCount && iterationCount->canEvaluate()) {
+              const int loopIndex = oklForSmnt.oklLoopIndex();
+              const int count = (int) iterationCount->evaluate();
+              innerDims[loopIndex] = std::max(innerDims[loopIndex], count);
+            } else {
+              innerDimsKnown = false;
+            }
+            delete iterationCount;
+          });
+
+        if (innerDimsKnown) {
+          return innerDims[0] * innerDims[1] * innerDims[2];
+        }
+
+        if (outerMostOuterLoop->hasAttribute("max_inner_dims")) {
+          attributeToken_t &attr = outerMostOuterLoop->attributes["max_inner_dims"];
+
+          int capacity = 1;
+          for (auto &arg : attr.args) {
+            capacity *= (int) arg.expr->evaluate();
+          }
+          return capacity;
+        }
+
+        // Largest work-group size supported by the backends
+        return 1024;
+      }
+
+      void withLauncher::addReductionTree(forStatement &forSmnt,
+                                          const attributes::reduction::reductionVarVector &reductions,
+                                          const int capacity) {
+        // Each thread holds partial results which are combined through
+        //   shared-memory trees, leaving the results in every thread:
+        //
+        //   @shared T _occa_reduction_<var>[capacity];
+        //   _occa_reduction_<var>[thread] = var;
+        //   @barrier
+        //   if ((thread + half) < count) { combine(thread, thread + half) }
+        //   @barrier
+        //   ...
+        //   var = _occa_reduction_<var>[0];
+        //   @barrier
+        //
+        // Reductions on the same loop share the barriers
+        const std::string threadName = "_occa_reduction_thread";
+        const std::string countName = "_occa_reduction_count";
+
+        const fileOrigin &origin = forSmnt.source->origin;
+        blockStatement &blockSmnt = *(new blockStatement(forSmnt.up,
+                                                         forSmnt.source));
+        forSmnt.up->addAfter(forSmnt, blockSmnt);
+
+        auto addSource = [&](const std::string &source) {
+          blockSmnt.add(
+            *(new sourceCodeStatement(&blockSmnt, forSmnt.source, source))
+          );
+        };
+        auto addBarrier = [&]() {
+          emptyStatement &barrierSmnt = *(new emptyStatement(&blockSmnt, forSmnt.source));
+          identifierToken barrierSource(origin, "barrier");
+          barrierSmnt.attributes["barrier"] = (
+            attributeToken_t(*(getAttribute("barrier")), barrierSource)
+          );
+          blockSmnt.add(barrierSmnt);
+        };
+        auto getArrayName = [&](const attributes::reduction::reductionVar_t &reductionVar) {
+          return "_occa_reduction_" + reductionVar.variable->name();
+        };
+
+        // @shared T _occa_reduction_<var>[capacity];
+        for (auto &reductionVar : reductions) {
+          identifierToken arraySource(origin, getArrayName(reductionVar));
+          vartype_t arrayType = reductionVar.variable->vartype;
+          arrayType.arrays.push_back(
+            array_t(operatorToken(origin, op::bracketStart),
+                    operatorToken(origin, op::bracketEnd),
+                    new primitiveNode(forSmnt.source, capacity))
+          );
+          variable_t *arrayVar = new variable_t(arrayType, &arraySource);
+
+          identifierToken sharedSource(origin, "shared");
+          attributeToken_t sharedAttr(*(getAttribute("shared")), sharedSource);
+          arrayVar->addAttribute(sharedAttr);
+
+          declarationStatement &declSmnt = *(new declarationStatement(&blockSmnt,
+                                                                      &arraySource));
+          blockSmnt.add(declSmnt);
+          declSmnt.addDeclaration(*arrayVar);
+        }
+
+        // Linearized thread index and count
+        addSource(
+          "int " + threadName + " = "
+          + getInnerIterator(0) + " + (" + getInnerSize(0) + " * ("
+          + getInnerIterator(1) + " + (" + getInnerSize(1) + " * " + getInnerIterator(2) + ")));"
+        );
+        addSource(
+          "int " + countName + " = "
+          + getInnerSize(0) + " * " + getInnerSize(1) + " * " + getInnerSize(2) + ";"
+        );
+
+        for (auto &reductionVar : reductions) {
+          addSource(getArrayName(reductionVar) + "[" + threadName + "] = "
+                    + reductionVar.variable->name() + ";");
+        }
+        addBarrier();
+
+        for (int size = capacity; size > 1; ) {
+          const int half = (size + 1) / 2;
+          const std::string halfStr = occa::toString(half);
+
+          std::string source = "if ((" + threadName + " + " + halfStr + ") < " + countName + ") {";
+          for (auto &reductionVar : reductions) {
+            const std::string arrayName = getArrayName(reductionVar);
+            const std::string threadEntry = arrayName + "[" + threadName + "]";
+            const std::string otherEntry = arrayName + "[" + threadName + " + " + halfStr + "]";
+            source += (
+              " " + threadEntry + " = "
+              + attributes::reduction::getCombineSource(reductionVar.op, threadEntry, otherEntry)
+              + ";"
+            );
+          }
+          source += " }";
+          addSource(source);
+          addSource(
+            "if (" + countName + " > " + halfStr + ") { " + countName + " = " + halfStr + "; }"
+          );
+          addBarrier();
+
+          size = half;
+        }
+
+        for (auto &reductionVar : reductions) {
+          addSource(reductionVar.variable->name() + " = " + getArrayName(reductionVar) + "[0];");
+        }
+        // Keep the next writes from racing with reads of the results
+        addBarrier();
+      }
+
       bool withLauncher::usesBarriers() {
         return add_barriers;
       }
@@ -3,6 +3,8 @@
 
 #include <occa/internal/lang/parser.hpp>
 #include <occa/internal/lang/modes/serial.hpp>
+#include <occa/internal/lang/modes/sharedMemoryAccesses.hpp>
+#include <occa/internal/lang/builtins/attributes/reduction.hpp>
 
 namespace occa {
   namespace lang {
@@ -12,6 +14,9 @@ namespace occa {
         bool add_barriers{true};
        public:
         serialParser launcherParser;
+        // Locations of the [@inner] loops whose barriers were skipped
+        //   since no @shared dependency needed them
+        strVector removedBarriers;
 
         withLauncher(const occa::json &settings_ = occa::json());
 
@@ -33,6 +38,14 @@ namespace occa {
 
         void setOklLoopIndices();
 
+        void setupKernelFusion();
+
+        void setupSpecializations();
+
+        void setupUnrolls();
+
+        static std::string getUnrollPragmaSource(const int count);
+
         void setupLauncherParser();
 
         void removeLauncherOuterLoops(functionDeclStatement &kernelSmnt);
@@ -76,16 +89,31 @@ namespace occa {
 
         void setupOccaFors(functionDeclStatement &kernelSmnt);
 
-        void addBarriersAfterInnerLoop(forStatement &forSmnt);
+        void addBarriersAfterInnerLoop(functionDeclStatement &kernelSmnt,
+                                       forStatement &forSmnt);
 
-        static bool writesToShared(exprNode &expr);
+        bool needsBarrierAfterInnerLoop(functionDeclStatement &kernelSmnt,
+                                        forStatement &forSmnt,
+                                        const sharedMemoryAccesses &loopAccesses);
 
         void replaceOccaFor(forStatement &forSmnt);
 
+        void setupReductions();
+
+        bool isDeclaredInOuterLoop(forStatement &forSmnt,
+                                   variable_t &var);
+
+        int getInnerThreadCapacity(forStatement &forSmnt);
+
+        void addReductionTree(forStatement &forSmnt,
+                              const attributes::reduction::reductionVarVector &reductions,
+                              const int capacity);
+
         virtual bool usesBarriers();
 
         virtual std::string getOuterIterator(const int loopIndex) = 0;
         virtual std::string getInnerIterator(const int loopIndex) = 0;
+        virtual std::string getInnerSize(const int loopIndex) = 0;
         virtual std::string launchBoundsAttribute(const int innerDims[3]) = 0;
       };
     }
@@ -723,5 +723,88 @@ namespace occa {
       operators.add(op::cudaCallStart.str    , &op::cudaCallStart);
       operators.add(op::cudaCallEnd.str      , &op::cudaCallEnd);
     }
+
+    //---[ Operator Matcher ]-----------
+    operatorMatcher_t::operatorMatcher_t() :
+      operators(NULL),
+      columnCount(1) {
+      for (int i = 0; i < 256; ++i) {
+        charColumns[i] = 0;
+      }
+    }
+
+    void operatorMatcher_t::setup(const operatorTrie &operators_) {
+      operators = &operators_;
+
+      const int operatorCount = (int) operators->values.size();
+
+      // Assign a column to each character used by the operators
+      for (int i = 0; i < operatorCount; ++i) {
+        const std::string &str = operators->values[i]->str;
+        for (const char c : str) {
+          unsigned char &column = charColumns[(unsigned char) c];
+          if (!column) {
+            column = (unsigned char) columnCount++;
+          }
+        }
+      }
+
+      transitions.clear();
+      valueIndices.clear();
+      addState();
+
+      for (int i = 0; i < operatorCount; ++i) {
+        const std::string &str = operators->values[i]->str;
+
+        int state = 0;
+        for (const char c : str) {
+          const int index = (state * columnCount) + charColumns[(unsigned char) c];
+          if (transitions[index] < 0) {
+            const int newState = addState();
+            transitions[index] = newState;
+          }
+          state = transitions[index];
+        }
+
+        // Match whichever operator the trie resolves the string to
+        valueIndices[state] = operators->get(str.c_str()).valueIndex;
+      }
+    }
+
+    int operatorMatcher_t::addState() {
+      const int state = (int) valueIndices.size();
+      valueIndices.push_back(-1);
+      transitions.resize(transitions.size() + columnCount, -1);
+      return state;
+    }
+
+    operatorTrie::result_t operatorMatcher_t::getLongest(const char *c) const {
+      int length = 0;
+      int valueIndex = -1;
+
+      int state = 0;
+      for (int i = 0; ; ++i) {
+        // The null terminator never has a column
+        const int column = charColumns[(unsigned char) c[i]];
+        if (!column) {
+          break;
+        }
+        state = transitions[(state * columnCount) + column];
+        if (state < 0) {
+          break;
+        }
+        if (0 <= valueIndices[state]) {
+          length = i + 1;
+          valueIndex = valueIndices[state];
+        }
+      }
+
+      return operatorTrie::result_t(operators, length, valueIndex);
+    }
+
+    bool operatorMatcher_t::has(const std::string &str) const {
+      return ((size_t) getLongest(str.c_str()).length == str.size());
+    }
+    //==================================
   }
 }
@@ -1,6 +1,8 @@
 #ifndef OCCA_INTERNAL_LANG_OPERATOR_HEADER
 #define OCCA_INTERNAL_LANG_OPERATOR_HEADER
 
+#include <vector>
+
 #include <occa/types.hpp>
 #include <occa/internal/utils/trie.hpp>
 #include <occa/types/primitive.hpp>
@@ -396,6 +398,36 @@ namespace occa {
     }
 
     void getOperators(operatorTrie &operators);
+
+    //---[ Operator Matcher ]-----------
+    // DFA built from a frozen operator trie with a dense transition
+    //   table, matching the longest operator with one table lookup
+    //   per character instead of a binary search per trie level
+    class operatorMatcher_t {
+    private:
+      const operatorTrie *operators;
+
+      // Characters that don't show up in any operator map to column 0
+      unsigned char charColumns[256];
+      int columnCount;
+
+      // [state * columnCount + column] -> next state (-1 if there is none)
+      std::vector<int> transitions;
+      // Trie value index for states that finish an operator, -1 otherwise
+      std::vector<int> valueIndices;
+
+    public:
+      operatorMatcher_t();
+
+      void setup(const operatorTrie &operators_);
+
+      operatorTrie::result_t getLongest(const char *c) const;
+      bool has(const std::string &str) const;
+
+    private:
+      int addState();
+    };
+    //==================================
   }
 }
 
@@ -68,7 +68,7 @@ namespace occa {
     }
 
     parser_t::~parser_t() {
-      clear();
+      clear_();
 
       keywords.free();
       delete restrictQualifier;
@@ -144,6 +144,15 @@ namespace occa {
 
     //---[ Setup ]----------------------
     void parser_t::clear() {
+      clear_();
+
+      preprocessor.init();
+      addSettingDefines();
+
+      success = true;
+    }
+
+    void parser_t::clear_() {
       tokenizer.clear();
 
       root.clear();
@@ -154,8 +163,8 @@ namespace occa {
       smntContext.clear();
       smntPeeker.clear();
 
-      preprocessor.clear();
-      addSettingDefines();
+      stream.clearCache();
+      preprocessor.clear_();
 
       loadingStatementType = 0;
       checkSemicolon = true;
@@ -164,8 +173,6 @@ namespace occa {
       clearAttributes();
 
       onClear();
-
-      success = true;
     }
 
     void parser_t::clearAttributes() {
@@ -199,6 +206,11 @@ namespace occa {
       }
     }
 
+    void parser_t::setSettings(const occa::json &settings_) {
+      settings = settings_;
+      preprocessor.setSettings(settings_);
+    }
+
     void parser_t::parseSource(const std::string &source) {
       setSource(source, false);
       if (success) {
@@ -238,6 +250,22 @@ namespace occa {
     void parser_t::setupLoadTokens() {
       beforePreprocessing();
 
+      // Reused parsers drop the @restrict qualifier from the previous parse
+      if (restrictQualifier) {
+        keywordMap::iterator it = keywords.keywords.find(restrictQualifier->name);
+        qualifierKeyword *keyword = (
+          (it != keywords.keywords.end())
+          ? dynamic_cast<qualifierKeyword*>(it->second)
+          : NULL
+        );
+        if (keyword && (&(keyword->qualifier) == restrictQualifier)) {
+          delete keyword;
+          keywords.keywords.erase(it);
+        }
+        delete restrictQualifier;
+        restrictQualifier = NULL;
+      }
+
       // Setup @restrict
       const std::string restrictStr = (
         settings.get<std::string>("okl/restrict",
@@ -942,6 +970,9 @@ namespace occa {
 
       // Duplicate function declared
       if (smntContext.up->hasDirectlyInScope(func.name())) {
+        const std::string &name = func.name();
+        func.printError("[" + name + "] is already defined");
+        smntContext.up->scope.get(name).printError("[" + name + "] was first defined here");
         success = false;
         delete &func;
         return NULL;
@@ -90,11 +90,18 @@ namespace occa {
 
       //---[ Setup ]--------------------
       void clear();
+      // Frees the last parse without setting up the next one, which
+      //   tokenizes builtin defines and can't run at static destruction
+      void clear_();
       void clearAttributes();
       void clearAttributes(attributeTokenMap &attrs);
 
       void addSettingDefines();
 
+      // Swap settings so the parser (and its registered attributes)
+      //   can be reused for other kernels
+      void setSettings(const occa::json &settings_);
+
       void parseSource(const std::string &source);
       void parseFile(const std::string &filename);
 
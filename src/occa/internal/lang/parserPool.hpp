@@ -0,0 +1,62 @@
+#ifndef OCCA_INTERNAL_LANG_PARSERPOOL_HEADER
+#define OCCA_INTERNAL_LANG_PARSERPOOL_HEADER
+
+#include <vector>
+
+#include <occa/types/json.hpp>
+#include <occa/utils/mutex.hpp>
+
+namespace occa {
+  namespace lang {
+    //---[ Parser Pool ]----------------
+    // Keeps idle parsers around so building a kernel doesn't need to
+    //   re-register keywords and OKL attributes for every translation
+    //
+    // A parser is only used by one thread at a time, the pool itself
+    //   can be shared across threads
+    template <class parserType>
+    class parserPool_t {
+    private:
+      mutable mutex_t mutex;
+      std::vector<parserType*> idleParsers;
+
+    public:
+      parserPool_t();
+      ~parserPool_t();
+
+      parserPool_t(const parserPool_t &other) = delete;
+      parserPool_t& operator = (const parserPool_t &other) = delete;
+
+      parserType* acquire(const occa::json &settings);
+      void release(parserType *parser);
+
+      int idleCount() const;
+    };
+    //==================================
+
+    //---[ Pooled Parser ]--------------
+    // Returns the parser to its pool when going out of scope
+    template <class parserType>
+    class pooledParser_t {
+    private:
+      parserPool_t<parserType> &pool;
+      parserType *parser;
+
+    public:
+      pooledParser_t(parserPool_t<parserType> &pool_,
+                     const occa::json &settings);
+      ~pooledParser_t();
+
+      pooledParser_t(const pooledParser_t &other) = delete;
+      pooledParser_t& operator = (const pooledParser_t &other) = delete;
+
+      parserType& operator * ();
+      parserType* operator -> ();
+    };
+    //==================================
+  }
+}
+
+#include "parserPool.tpp"
+
+#endif
@@ -0,0 +1,80 @@
+namespace occa {
+  namespace lang {
+    //---[ Parser Pool ]----------------
+    template <class parserType>
+    parserPool_t<parserType>::parserPool_t() {}
+
+    template <class parserType>
+    parserPool_t<parserType>::~parserPool_t() {
+      for (parserType *parser : idleParsers) {
+        delete parser;
+      }
+      idleParsers.clear();
+      mutex.free();
+    }
+
+    template <class parserType>
+    parserType* parserPool_t<parserType>::acquire(const occa::json &settings) {
+      parserType *parser = NULL;
+
+      mutex.lock();
+      if (idleParsers.size()) {
+        parser = idleParsers.back();
+        idleParsers.pop_back();
+      }
+      mutex.unlock();
+
+      if (!parser) {
+        return new parserType(settings);
+      }
+      parser->setSettings(settings);
+      return parser;
+    }
+
+    template <class parserType>
+    void parserPool_t<parserType>::release(parserType *parser) {
+      if (!parser) {
+        return;
+      }
+      // Free the AST before the parser goes idle, the preprocessor
+      //   setup is left to the next setSource() which runs it anyway
+      parser->clear_();
+
+      mutex.lock();
+      idleParsers.push_back(parser);
+      mutex.unlock();
+    }
+
+    template <class parserType>
+    int parserPool_t<parserType>::idleCount() const {
+      mutex.lock();
+      const int count = (int) idleParsers.size();
+      mutex.unlock();
+      return count;
+    }
+    //==================================
+
+    //---[ Pooled Parser ]--------------
+    template <class parserType>
+    pooledParser_t<parserType>::pooledParser_t(parserPool_t<parserType> &pool_,
+                                               const occa::json &settings) :
+      pool(pool_),
+      parser(pool_.acquire(settings)) {}
+
+    template <class parserType>
+    pooledParser_t<parserType>::~pooledParser_t() {
+      pool.release(parser);
+    }
+
+    template <class parserType>
+    parserType& pooledParser_t<parserType>::operator * () {
+      return *parser;
+    }
+
+    template <class parserType>
+    parserType* pooledParser_t<parserType>::operator -> () {
+      return parser;
+    }
+    //==================================
+  }
+}
@@ -30,27 +30,6 @@ namespace occa {
       initStandardHeaders();
 
       setSettings(settings_);
-
-      includePaths = env::OCCA_INCLUDE_PATH;
-
-      strictHeaders = settings.get("okl/strict_headers", true);
-
-      json oklIncludePaths = settings["okl/include_paths"];
-      if (oklIncludePaths.isArray()) {
-        jsonArray pathArray = oklIncludePaths.array();
-        const int pathCount = (int) pathArray.size();
-        for (int i = 0; i < pathCount; ++i) {
-          json path = pathArray[i];
-          if (path.isString()) {
-            includePaths.push_back(path);
-          }
-        }
-      }
-
-      const int includePathCount = (int) includePaths.size();
-      for (int i = 0; i < includePathCount; ++i) {
-        io::endWithSlash(includePaths[i]);
-      }
     }
 
     preprocessor_t::preprocessor_t(const preprocessor_t &pp) :
@@ -213,6 +192,27 @@ namespace occa {
 
     void preprocessor_t::setSettings(occa::json settings_) {
       settings = settings_;
+
+      includePaths = env::OCCA_INCLUDE_PATH;
+
+      strictHeaders = settings.get("okl/strict_headers", true);
+
+      json oklIncludePaths = settings.get<json>("okl/include_paths", json());
+      if (oklIncludePaths.isArray()) {
+        jsonArray pathArray = oklIncludePaths.array();
+        const int pathCount = (int) pathArray.size();
+        for (int i = 0; i < pathCount; ++i) {
+          json path = pathArray[i];
+          if (path.isString()) {
+            includePaths.push_back(path);
+          }
+        }
+      }
+
+      const int includePathCount = (int) includePaths.size();
+      for (int i = 0; i < includePathCount; ++i) {
+        io::endWithSlash(includePaths[i]);
+      }
     }
 
     void preprocessor_t::initDirectives() {
@@ -460,9 +460,15 @@ namespace occa {
 
     void preprocessor_t::addSourceDefine(const std::string &name,
                                          const std::string &value) {
-      sourceMacros[name] = macro_t::defineBuiltin(*this,
-                                                  name,
-                                                  value);
+      macro_t *macro = macro_t::defineBuiltin(*this,
+                                              name,
+                                              value);
+      if (!macro) {
+        return;
+      }
+      // Function-like defines are passed as NAME(ARGS) but looked up by NAME
+      removeSourceDefine(macro->name());
+      sourceMacros[macro->name()] = macro;
     }
 
     void preprocessor_t::removeSourceDefine(const std::string &name) {
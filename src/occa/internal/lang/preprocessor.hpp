@@ -6,6 +6,7 @@
 #include <map>
 #include <set>
 #include <stack>
+#include <unordered_map>
 
 #include <occa/defines.hpp>
 #include <occa/types.hpp>
@@ -23,7 +24,7 @@ namespace occa {
     typedef std::stack<token_t*>  tokenStack;
     typedef std::list<token_t*>   tokenList;
 
-    typedef std::map<std::string, macro_t*> macroMap;
+    typedef std::unordered_map<std::string, macro_t*> macroMap;
     typedef std::map<macro_t*, bool>        macroSet;
     typedef std::vector<macro_t*>           macroVector;
     typedef std::map<token_t*, macroVector> macroEndMap;
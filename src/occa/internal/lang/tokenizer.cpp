@@ -1,5 +1,8 @@
+#include <cstring>
+
 #include <occa/internal/utils/lex.hpp>
 #include <occa/internal/utils/string.hpp>
+#include <occa/internal/lang/headerCache.hpp>
 #include <occa/internal/lang/tokenizer.hpp>
 #include <occa/internal/lang/token.hpp>
 
@@ -57,37 +60,102 @@ namespace occa {
       return getEncodingType(str);
     }
 
+    //---[ Tables ]---------------------
+    // Read-only lookup tables shared across tokenizers and threads
+    class tokenizerTables_t {
+    public:
+      operatorTrie operators;
+      operatorMatcher_t operatorMatcher;
+      std::string operatorCharcodes;
+
+      lex::charsetTable_t whitespaceNoNewline;
+      lex::charsetTable_t identifierStart;
+      lex::charsetTable_t identifier;
+      lex::charsetTable_t operatorStart;
+      // Characters that can start a primitive when signs are skipped
+      //   (digits, .01, true, false)
+      lex::charsetTable_t primitiveStart;
+
+      tokenizerTables_t() :
+        whitespaceNoNewline(charcodes::whitespaceNoNewline),
+        identifierStart(charcodes::identifierStart),
+        identifier(charcodes::identifier),
+        primitiveStart("0123456789.tf") {
+        getOperators(operators);
+        operators.freeze();
+        operatorMatcher.setup(operators);
+
+        // Extract the first characters for all operators
+        //   that don't conflict with identifier (e.g. sizeof)
+        //   for the shallowPeek
+        typedef std::map<char, bool> charMap;
+        charMap charcodeMap;
+
+        const int operatorCount = operators.size();
+        for (int i = 0; i < operatorCount; ++i) {
+          const operator_t &op = *(operators.values[i]);
+          const char c = op.str[0];
+          // Only store chars that don't conflict with identifiers
+          // This check is done in the peekForIdentifier method
+          if (!identifierStart.has(c)) {
+            charcodeMap[c] = true;
+          }
+        }
+
+        // Store the unique char codes in operatorCharcodes
+        charMap::iterator it = charcodeMap.begin();
+        while (it != charcodeMap.end()) {
+          operatorCharcodes += (it->first);
+          ++it;
+        }
+        operatorStart.add(operatorCharcodes.c_str());
+      }
+    };
+
+    namespace {
+      const tokenizerTables_t& getTokenizerTables() {
+        static const tokenizerTables_t tokenizerTables;
+        return tokenizerTables;
+      }
+    }
+    //==================================
+
     tokenizer_t::tokenizer_t() :
       origin(originSource::string),
-      fp(origin.position) {
-      setup();
-    }
+      fp(origin.position),
+      tables(getTokenizerTables()),
+      operators(tables.operators),
+      operatorCharcodes(tables.operatorCharcodes) {}
 
     tokenizer_t::tokenizer_t(const char *root) :
       origin(originSource::string,
              filePosition(root)),
-      fp(origin.position) {
-      setup();
-    }
+      fp(origin.position),
+      tables(getTokenizerTables()),
+      operators(tables.operators),
+      operatorCharcodes(tables.operatorCharcodes) {}
 
     tokenizer_t::tokenizer_t(file_t *file_) :
       origin(*file_),
-      fp(origin.position) {
-      setup();
-    }
+      fp(origin.position),
+      tables(getTokenizerTables()),
+      operators(tables.operators),
+      operatorCharcodes(tables.operatorCharcodes) {}
 
     tokenizer_t::tokenizer_t(fileOrigin origin_) :
       origin(origin_),
-      fp(origin.position) {
-      setup();
-    }
+      fp(origin.position),
+      tables(getTokenizerTables()),
+      operators(tables.operators),
+      operatorCharcodes(tables.operatorCharcodes) {}
 
     tokenizer_t::tokenizer_t(const tokenizer_t &stream) :
       origin(stream.origin),
       fp(origin.position),
-      stack(stream.stack) {
-      setup();
-    }
+      stack(stream.stack),
+      tables(stream.tables),
+      operators(tables.operators),
+      operatorCharcodes(tables.operatorCharcodes) {}
 
     tokenizer_t& tokenizer_t::operator = (const tokenizer_t &stream) {
       origin = stream.origin;
@@ -99,36 +167,6 @@ namespace occa {
       clear();
     }
 
-    void tokenizer_t::setup() {
-      getOperators(operators);
-      operators.freeze();
-
-      // Extract the first characters for all operators
-      //   that don't conflict with identifier (e.g. sizeof)
-      //   for the shallowPeek
-      typedef std::map<char, bool> charMap;
-      charMap charcodes;
-
-      const int operatorCount = operators.size();
-      for (int i = 0; i < operatorCount; ++i) {
-        const operator_t &op = *(operators.values[i]);
-        const char c = op.str[0];
-        // Only store chars that don't conflict with identifiers
-        // This check is done in the peekForIdentifier method
-        if (!lex::inCharset(c, charcodes::identifierStart)) {
-          charcodes[c] = true;
-        }
-      }
-
-      // Store the unique char codes in operatorCharcodes
-      operatorCharcodes = "";
-      charMap::iterator it = charcodes.begin();
-      while (it != charcodes.end()) {
-        operatorCharcodes += (it->first);
-        ++it;
-      }
-    }
-
     baseStream<token_t*>& tokenizer_t::clone() const {
       return *(new tokenizer_t(*this));
     }
@@ -221,11 +259,19 @@ namespace occa {
         outputCache.clear();
       }
 
-      // TODO: Use a fileCache
-      file_t *file = new file_t(filename);
+      cachedHeaderPtr header = headerCache.get(filename);
+
+      // Skip lexing by pushing the cached tokens and continue
+      //   tokenizing the current file after they're consumed
+      if (header->canReplay) {
+        header->replay(outputCache, origin);
+        lastTokenType = tokenType::newline;
+        return;
+      }
+
       origin.push(true,
-                  *file,
-                  file->content.c_str());
+                  *(header->file),
+                  header->file->content.c_str());
     }
 
     void tokenizer_t::popSource() {
@@ -310,8 +356,17 @@ namespace occa {
     }
 
     void tokenizer_t::skipTo(const char delimiter) {
-      while (*fp.start != '\0') {
-        if (*fp.start == '\\') {
+      // Comments can be long so jump between the characters we
+      //   need to look at with strcspn, which libc vectorizes
+      const char stopChars[] = { delimiter, '\\', '\n', '\0' };
+      while (true) {
+        fp.start += strcspn(fp.start, stopChars);
+
+        const char c = *fp.start;
+        if (c == '\0') {
+          return;
+        }
+        if (c == '\\') {
           if (fp.start[1] == '\n') {
             fp.lineStart = fp.start + 2;
             ++fp.line;
@@ -319,13 +374,12 @@ namespace occa {
           fp.start += 1 + (fp.start[1] != '\0');
           continue;
         }
-        if (*fp.start == delimiter) {
+        if (c == delimiter) {
           return;
         }
-        if (*fp.start == '\n') {
-          fp.lineStart = fp.start + 1;
-          ++fp.line;
-        }
+        // Newline
+        fp.lineStart = fp.start + 1;
+        ++fp.line;
         ++fp.start;
       }
     }
@@ -372,8 +426,31 @@ namespace occa {
       }
     }
 
+    void tokenizer_t::skipFrom(const lex::charsetTable_t &charset) {
+      while (true) {
+        const char c = *fp.start;
+        if (c == '\\') {
+          if (fp.start[1] == '\n') {
+            fp.lineStart = fp.start + 2;
+            ++fp.line;
+          }
+          fp.start += 1 + (fp.start[1] != '\0');
+          continue;
+        }
+        // The null terminator is never part of a charset
+        if (!charset.has(c)) {
+          break;
+        }
+        if (c == '\n') {
+          fp.lineStart = fp.start + 1;
+          ++fp.line;
+        }
+        ++fp.start;
+      }
+    }
+
     void tokenizer_t::skipWhitespace() {
-      skipFrom(charcodes::whitespaceNoNewline);
+      skipFrom(tables.whitespaceNoNewline);
     }
 
     int tokenizer_t::peek() {
@@ -394,24 +471,25 @@ namespace occa {
         return tokenType::none;
       }
 
-      const char *pos = fp.start;
-      const bool isPrimitive = (
-        primitive::load(pos, false).type != occa::primitiveType::none
-      );
-
       // Primitive must be checked before identifiers and operators since:
       //   - true/false
       //   - Operators can start with a . (for example, .01)
       // However, make sure we aren't parsing an identifier:
       //   - true_var
       //   - false_case
-      if (isPrimitive && !lex::inCharset(*pos, charcodes::identifierStart)) {
-        return tokenType::primitive;
+      if (tables.primitiveStart.has(c)) {
+        const char *pos = fp.start;
+        const bool isPrimitive = (
+          primitive::load(pos, false).type != occa::primitiveType::none
+        );
+        if (isPrimitive && !tables.identifierStart.has(*pos)) {
+          return tokenType::primitive;
+        }
       }
-      if (lex::inCharset(c, charcodes::identifierStart)) {
+      if (tables.identifierStart.has(c)) {
         return tokenType::identifier;
       }
-      if (lex::inCharset(c, operatorCharcodes.c_str())) {
+      if (tables.operatorStart.has(c)) {
         return tokenType::op;
       }
       if (c == '\n') {
@@ -431,7 +509,7 @@ namespace occa {
 
       // Go through the identifier keys
       ++fp.start;
-      skipFrom(charcodes::identifier);
+      skipFrom(tables.identifier);
 
       const std::string identifier = str();
 
@@ -439,7 +517,7 @@ namespace occa {
       popAndRewind();
 
       // sizeof, new, delete, throw
-      if (operators.has(identifier)) {
+      if (tables.operatorMatcher.has(identifier)) {
         return tokenType::op;
       };
 
@@ -463,7 +541,7 @@ namespace occa {
 
     int tokenizer_t::peekForOperator() {
       push();
-      operatorTrie::result_t result = operators.getLongest(fp.start);
+      operatorTrie::result_t result = tables.operatorMatcher.getLongest(fp.start);
       if (!result.success()) {
         printError("Not able to parse operator");
         popAndRewind();
@@ -474,12 +552,12 @@ namespace occa {
     }
 
     void tokenizer_t::getIdentifier(std::string &value) {
-      if (!lex::inCharset(*fp.start, charcodes::identifierStart)) {
+      if (!tables.identifierStart.has(*fp.start)) {
         return;
       }
       push();
       ++fp.start;
-      skipFrom(charcodes::identifier);
+      skipFrom(tables.identifier);
       value = str();
       pop();
     }
@@ -619,7 +697,7 @@ namespace occa {
     }
 
     token_t* tokenizer_t::getIdentifierToken() {
-      if (!lex::inCharset(*fp.start, charcodes::identifierStart)) {
+      if (!tables.identifierStart.has(*fp.start)) {
         printError("Not able to parse identifier");
         return NULL;
       }
@@ -649,7 +727,7 @@ namespace occa {
 
     token_t* tokenizer_t::getOperatorToken() {
       push();
-      operatorTrie::result_t result = operators.getLongest(fp.start);
+      operatorTrie::result_t result = tables.operatorMatcher.getLongest(fp.start);
       if (!result.success()) {
         printError("Not able to parse operator");
         return NULL;
@@ -803,7 +881,7 @@ namespace occa {
       int type = shallowPeek();
       if (type & tokenType::op) {
         push();
-        operatorTrie::result_t result = operators.getLongest(fp.start);
+        operatorTrie::result_t result = tables.operatorMatcher.getLongest(fp.start);
         popAndRewind();
         if (result.success() &&
             (result.value()->opType & operatorType::lessThan)) {
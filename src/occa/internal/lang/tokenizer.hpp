@@ -5,6 +5,7 @@
 #include <vector>
 
 #include <occa/internal/io.hpp>
+#include <occa/internal/utils/lex.hpp>
 #include <occa/internal/utils/trie.hpp>
 #include <occa/internal/lang/file.hpp>
 #include <occa/internal/lang/printer.hpp>
@@ -13,6 +14,7 @@
 namespace occa {
   namespace lang {
     class token_t;
+    class tokenizerTables_t;
 
     typedef std::vector<token_t*>   tokenVector;
     typedef std::list<token_t*>     tokenList;
@@ -32,8 +34,10 @@ namespace occa {
 
       originVector stack;
 
-      operatorTrie operators;
-      std::string operatorCharcodes;
+      // Operators and charset tables are shared across all tokenizers
+      const tokenizerTables_t &tables;
+      const operatorTrie &operators;
+      const std::string &operatorCharcodes;
 
       int lastTokenType;
       int lastNonNewlineTokenType;
@@ -53,8 +57,6 @@ namespace occa {
 
       virtual ~tokenizer_t();
 
-      void setup();
-
       virtual baseStream<token_t*>& clone() const;
 
       virtual void* passMessageToInput(const occa::json &props);
@@ -89,6 +91,7 @@ namespace occa {
       void skipTo(const char delimiter);
       void skipTo(const char *delimiters);
       void skipFrom(const char *delimiters);
+      void skipFrom(const lex::charsetTable_t &charset);
 
       void skipWhitespace();
 
@@ -211,7 +211,7 @@ namespace occa {
       const int otherArrayCount = (int) otherFlat.arrays.size();
 
       if ((pointerCount + arrayCount)
-          != (arrayCount + otherArrayCount)) {
+          != (otherPointerCount + otherArrayCount)) {
         return false;
       }
 
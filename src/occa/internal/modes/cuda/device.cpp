@@ -460,6 +460,20 @@ namespace occa {
       return new cuda::memoryPool(this, props);
     }
 
+    void* device::mallocStagingMemory(const udim_t bytes) {
+      setCudaContext();
+
+      void *ptr = NULL;
+      OCCA_CUDA_ERROR("Device: malloc staging memory",
+                      cuMemAllocHost(&ptr, bytes));
+      return ptr;
+    }
+
+    void device::freeStagingMemory(void *ptr) {
+      OCCA_CUDA_DESTRUCTOR_ERROR("Device: free staging memory",
+                                 cuMemFreeHost(ptr));
+    }
+
     udim_t device::memorySize() const {
       return cuda::getDeviceMemorySize(cuDevice);
     }
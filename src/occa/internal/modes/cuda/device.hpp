@@ -99,6 +99,9 @@ namespace occa {
 
       modeMemoryPool_t* createMemoryPool(const occa::json &props) override;
 
+      void* mallocStagingMemory(const udim_t bytes) override;
+      void freeStagingMemory(void *ptr) override;
+
       udim_t memorySize() const override;
       //================================
 
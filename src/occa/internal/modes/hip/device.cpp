@@ -431,6 +431,21 @@ namespace occa {
       return new hip::memoryPool(this, props);
     }
 
+    void* device::mallocStagingMemory(const udim_t bytes) {
+      OCCA_HIP_ERROR("Device: Setting Device",
+                     hipSetDevice(deviceID));
+
+      void *ptr = NULL;
+      OCCA_HIP_ERROR("Device: malloc staging memory",
+                     hipHostMalloc(&ptr, bytes));
+      return ptr;
+    }
+
+    void device::freeStagingMemory(void *ptr) {
+      OCCA_HIP_ERROR("Device: free staging memory",
+                     hipHostFree(ptr));
+    }
+
     udim_t device::memorySize() const {
       return hip::getDeviceMemorySize(hipDevice);
     }
@@ -1,3 +1,5 @@
+#include <thread>
+
 #include <occa/internal/core/kernel.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io/output.hpp>
@@ -9,7 +11,13 @@
 namespace occa {
   namespace openmp {
     device::device(const occa::json &properties_) :
-      serial::device(properties_) {}
+      serial::device(properties_) {
+      // The device owns all cores, use them for copies too
+      copyEngine.setThreads(
+        properties.get("copy_threads",
+                       (int) std::thread::hardware_concurrency())
+      );
+    }
 
     hash_t device::hash() const {
       return (
@@ -29,11 +37,11 @@ namespace occa {
                            const std::string &outputFile,
                            const occa::json &kernelProps,
                            lang::sourceMetadata_t &metadata) {
-      lang::okl::openmpParser parser(kernelProps);
-      parser.parseFile(filename);
+      lang::pooledParser_t<lang::okl::openmpParser> parser(parserPool, kernelProps);
+      parser->parseFile(filename);
 
       // Verify if parsing succeeded
-      if (!parser.succeeded()) {
+      if (!parser->succeeded()) {
         if (!kernelProps.get("silent", false)) {
           OCCA_FORCE_ERROR("Unable to transform OKL kernel [" << filename << "]");
         }
@@ -44,12 +52,12 @@ namespace occa {
         outputFile,
         true,
         [&](const std::string &tempFilename) -> bool {
-          parser.writeToFile(tempFilename);
+          parser->writeToFile(tempFilename);
           return true;
         }
       );
 
-      parser.setSourceMetadata(metadata);
+      parser->setSourceMetadata(metadata);
 
       return true;
     }
@@ -1,6 +1,7 @@
 #ifndef OCCA_INTERNAL_MODES_OPENMP_DEVICE_HEADER
 #define OCCA_INTERNAL_MODES_OPENMP_DEVICE_HEADER
 
+#include <occa/internal/lang/modes/openmp.hpp>
 #include <occa/internal/modes/serial/device.hpp>
 
 namespace occa {
@@ -12,6 +13,8 @@ namespace occa {
       std::string lastCompiler;
       std::string lastCompilerOpenMPFlag;
 
+      lang::parserPool_t<lang::okl::openmpParser> parserPool;
+
     public:
       device(const occa::json &properties_);
       virtual ~device() = default;
@@ -1,5 +1,6 @@
 #include <cstring>
 #include <occa/internal/modes/serial/buffer.hpp>
+#include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
 #include <occa/internal/utils/sys.hpp>
 #include <occa/internal/core/device.hpp>
@@ -9,11 +10,18 @@ namespace occa {
     buffer::buffer(modeDevice_t *modeDevice_,
                    udim_t size_,
                    const occa::json &properties_) :
-      occa::modeBuffer_t(modeDevice_, size_, properties_) {}
+      occa::modeBuffer_t(modeDevice_, size_, properties_),
+      isMapped(false) {}
 
     buffer::~buffer() {
+      // Async copies could still be using the buffer
+      if (modeDevice) {
+        ((serial::device*) modeDevice)->copyEngine.finish();
+      }
 
-      if (!isWrapped && ptr) {
+      if (isMapped) {
+        sys::munmapFile(ptr, size);
+      } else if (!isWrapped && ptr) {
         if (properties.get("use_host_pointer", false)) {
           if (properties.get("own_host_pointer", false)) {
             sys::free(ptr);
@@ -37,6 +45,14 @@ namespace occa {
       isWrapped = true;
     }
 
+    void buffer::mmapFile(const std::string &filename,
+                          const bool readOnly) {
+      ptr = (char*) sys::mmapFile(filename, readOnly, size);
+      // Mapped pages are backed by the file, not counted as allocated memory
+      isWrapped = true;
+      isMapped = true;
+    }
+
     modeMemory_t* buffer::slice(const dim_t offset,
                                 const udim_t bytes) {
       return new serial::memory(this, bytes, offset);
@@ -46,6 +62,7 @@ namespace occa {
       ptr = NULL;
       size = 0;
       isWrapped = false;
+      isMapped = false;
     }
   }
 }
@@ -9,6 +9,8 @@ namespace occa {
   namespace serial {
     class buffer : public occa::modeBuffer_t {
     public:
+      bool isMapped;
+
       buffer(modeDevice_t *modeDevice_,
              udim_t size_,
              const occa::json &properties_ = occa::json());
@@ -19,6 +21,9 @@ namespace occa {
       void wrapMemory(const void *ptr,
                             const udim_t bytes);
 
+      void mmapFile(const std::string &filename,
+                    const bool readOnly);
+
       modeMemory_t* slice(const dim_t offset,
                           const udim_t bytes) override;
 
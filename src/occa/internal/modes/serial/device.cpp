@@ -1,3 +1,5 @@
+#include <memory>
+
 #include <occa/core/base.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
@@ -14,7 +16,8 @@
 namespace occa {
   namespace serial {
     device::device(const occa::json &properties_) :
-      occa::modeDevice_t(properties_) {}
+      occa::modeDevice_t(properties_),
+      copyEngine(properties.get("copy_threads", 1)) {}
 
     bool device::hasSeparateMemorySpace() const {
       return false;
@@ -52,7 +55,9 @@ namespace occa {
       return new occa::serial::streamTag(this, sys::currentTime());
     }
 
-    void device::waitFor(occa::streamTag tag) {}
+    void device::waitFor(occa::streamTag tag) {
+      copyEngine.finish();
+    }
 
     double device::timeBetween(const occa::streamTag &startTag,
                                const occa::streamTag &endTag) {
@@ -72,11 +77,11 @@ namespace occa {
                            const std::string &outputFile,
                            const occa::json &kernelProps,
                            lang::sourceMetadata_t &metadata) {
-      lang::okl::serialParser parser(kernelProps);
-      parser.parseFile(filename);
+      lang::pooledParser_t<lang::okl::serialParser> parser(parserPool, kernelProps);
+      parser->parseFile(filename);
 
       // Verify if parsing succeeded
-      if (!parser.succeeded()) {
+      if (!parser->succeeded()) {
         OCCA_ERROR("Unable to transform OKL kernel [" << filename << "]",
                    kernelProps.get("silent", false));
         return false;
@@ -86,12 +91,12 @@ namespace occa {
         outputFile,
         true,
         [&](const std::string &tempFilename) -> bool {
-          parser.writeToFile(tempFilename);
+          parser->writeToFile(tempFilename);
           return true;
         }
       );
 
-      parser.setSourceMetadata(metadata);
+      parser->setSourceMetadata(metadata);
 
       return true;
     }
@@ -436,6 +441,25 @@ namespace occa {
       return new serial::memory(buf, bytes, 0);
     }
 
+    modeMemory_t* device::mmapFile(const std::string &filename,
+                                   const occa::json &props) {
+      // Unmaps and frees the buffer if mapping or madvise throws
+      std::unique_ptr<buffer> buf(new serial::buffer(this, 0, props));
+      buf->mmapFile(filename, props.get("read_only", true));
+
+      const std::string advice = props.get<std::string>("access", "normal");
+      if (advice != "normal") {
+        sys::madvise(buf->ptr, buf->size, advice);
+      }
+      // Starts reading the file in the background
+      if (props.get("prefetch", false)) {
+        sys::madvise(buf->ptr, buf->size, "willneed");
+      }
+
+      const udim_t bytes = buf->size;
+      return new serial::memory(buf.release(), bytes, 0);
+    }
+
     modeMemoryPool_t* device::createMemoryPool(const occa::json &props) {
       return new serial::memoryPool(this, props);
     }
@@ -3,13 +3,21 @@
 
 #include <occa/defines.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/lang/modes/serial.hpp>
+#include <occa/internal/lang/parserPool.hpp>
+#include <occa/internal/utils/copyEngine.hpp>
 
 namespace occa {
   namespace serial {
     class device : public occa::modeDevice_t {
       mutable hash_t hash_;
 
+      lang::parserPool_t<lang::okl::serialParser> parserPool;
+
     public:
+      // Used by all host copies on this device
+      copyEngine_t copyEngine;
+
       device(const occa::json &properties_);
       virtual ~device() = default;
 
@@ -69,6 +77,9 @@ namespace occa {
                                const udim_t bytes,
                                const occa::json &props) override;
 
+      modeMemory_t* mmapFile(const std::string &filename,
+                             const occa::json &props) override;
+
       modeMemoryPool_t* createMemoryPool(const occa::json &props) override;
 
       udim_t memorySize() const override;
@@ -1,6 +1,7 @@
 #include <occa/core/base.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
+#include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/kernel.hpp>
 #include <occa/internal/lang/modes/serial.hpp>
 
@@ -46,6 +47,11 @@ namespace occa {
         vArgs.resize(args);
       }
 
+      // Kernels run right away so pending async copies need to finish first
+      if (!isLauncherKernel) {
+        ((serial::device*) modeDevice)->copyEngine.finish();
+      }
+
       // Set arguments
       for (int i = 0; i < args; ++i) {
         vArgs[i] = arguments[i].ptr();
@@ -1,5 +1,6 @@
 #include <cstring>
 #include <occa/internal/modes/serial/buffer.hpp>
+#include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
 #include <occa/internal/utils/sys.hpp>
 #include <occa/internal/core/device.hpp>
@@ -20,6 +21,10 @@ namespace occa {
 
     memory::~memory() {}
 
+    copyEngine_t& memory::getCopyEngine() const {
+      return ((serial::device*) getModeDevice())->copyEngine;
+    }
+
     void* memory::getKernelArgPtr() const {
       return ptr;
     }
@@ -30,7 +35,8 @@ namespace occa {
                         const occa::json &props) const {
       const void *srcPtr = ptr + offset_;
 
-      ::memcpy(dest, srcPtr, bytes);
+      getCopyEngine().copy(dest, srcPtr, bytes,
+                           props.get("async", false));
     }
 
     void memory::copyFrom(const void *src,
@@ -41,7 +47,8 @@ namespace occa {
       void *destPtr      = ptr + offset_;
       const void *srcPtr = src;
 
-      ::memcpy(destPtr, srcPtr, bytes);
+      getCopyEngine().copy(destPtr, srcPtr, bytes,
+                           props.get("async", false));
     }
 
     void memory::copyFrom(const modeMemory_t *src,
@@ -53,11 +60,36 @@ namespace occa {
       void *destPtr      = ptr + destOffset;
       const void *srcPtr = src->ptr + srcOffset;
 
-      ::memcpy(destPtr, srcPtr, bytes);
+      getCopyEngine().copy(destPtr, srcPtr, bytes,
+                           props.get("async", false));
     }
 
     void* memory::unwrap() {
       return static_cast<void*>(&ptr);
     }
+
+    void memory::convertTo(void *dest,
+                           const dtype_t &hostDtype,
+                           dtypeConversion_t conversion,
+                           const udim_t entries,
+                           const udim_t offset_,
+                           const occa::json &props) const {
+      getCopyEngine().convert(dest, ptr + offset_, entries,
+                              hostDtype.bytes(), dtype_->bytes(),
+                              conversion,
+                              props.get("async", false));
+    }
+
+    void memory::convertFrom(const void *src,
+                             const dtype_t &hostDtype,
+                             dtypeConversion_t conversion,
+                             const udim_t entries,
+                             const udim_t offset_,
+                             const occa::json &props) {
+      getCopyEngine().convert(ptr + offset_, src, entries,
+                              dtype_->bytes(), hostDtype.bytes(),
+                              conversion,
+                              props.get("async", false));
+    }
   }
 }
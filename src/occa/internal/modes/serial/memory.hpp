@@ -3,6 +3,7 @@
 
 #include <occa/defines.hpp>
 #include <occa/internal/core/memory.hpp>
+#include <occa/internal/utils/copyEngine.hpp>
 #include <occa/internal/modes/serial/buffer.hpp>
 #include <occa/internal/modes/serial/memoryPool.hpp>
 
@@ -16,6 +17,8 @@ namespace occa {
              udim_t size_, dim_t offset_);
       virtual ~memory();
 
+      copyEngine_t& getCopyEngine() const;
+
       void* getKernelArgPtr() const override;
 
       void copyTo(void *dest,
@@ -35,6 +38,21 @@ namespace occa {
                     const occa::json &props) override;
 
       void* unwrap() override;
+
+      // Host memory is converted in place by the copy engine threads
+      void convertTo(void *dest,
+                     const dtype_t &hostDtype,
+                     dtypeConversion_t conversion,
+                     const udim_t entries,
+                     const udim_t offset,
+                     const occa::json &props) const override;
+
+      void convertFrom(const void *src,
+                       const dtype_t &hostDtype,
+                       dtypeConversion_t conversion,
+                       const udim_t entries,
+                       const udim_t offset,
+                       const occa::json &props) override;
     };
   }
 }
@@ -29,9 +29,9 @@ namespace occa {
     void memoryPool::memcpy(modeBuffer_t* dst, const dim_t dstOffset,
                             modeBuffer_t* src, const dim_t srcOffset,
                             const udim_t bytes) {
-      ::memcpy(dst->ptr + dstOffset,
-               src->ptr + srcOffset,
-               bytes);
+      ((serial::device*) modeDevice)->copyEngine.copy(dst->ptr + dstOffset,
+                                                      src->ptr + srcOffset,
+                                                      bytes);
     }
   }
 }
@@ -1,3 +1,4 @@
+#include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/stream.hpp>
 
 namespace occa {
@@ -7,7 +8,10 @@ namespace occa {
       modeStream_t(modeDevice_, properties_) {}
 
     stream::~stream() {}
-    void stream::finish() {}
+    void stream::finish() {
+      // Copies are the only async work in host modes
+      ((serial::device*) modeDevice)->copyEngine.finish();
+    }
 
     void* stream::unwrap() {
       OCCA_FORCE_ERROR("stream::unwrap is not defined for serial mode");
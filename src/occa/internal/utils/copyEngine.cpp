@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#include <occa/internal/utils/copyEngine.hpp>
+
+namespace occa {
+  const udim_t copyEngine_t::parallelBytes    = (2 * 1024 * 1024);
+  const udim_t copyEngine_t::nonTemporalBytes = (8 * 1024 * 1024);
+  const udim_t copyEngine_t::minChunkBytes    = (256 * 1024);
+
+  copyEngine_t::copyEngine_t(const int threads_) :
+    threads(std::max(1, threads_)),
+    issuedCopies(0),
+    finishedCopies(0),
+    pendingCopies(0),
+    stopping(false) {}
+
+  copyEngine_t::~copyEngine_t() {
+    stopWorkers();
+  }
+
+  void copyEngine_t::setThreads(const int threads_) {
+    stopWorkers();
+    threads = std::max(1, threads_);
+  }
+
+  int copyEngine_t::getThreads() const {
+    return threads;
+  }
+
+  void copyEngine_t::copy(void *dest,
+                          const void *src,
+                          const udim_t bytes,
+                          const bool async) {
+    copy_t copy_;
+    copy_.dest = (char*) dest;
+    copy_.src = (const char*) src;
+    copy_.entries = bytes;
+    copy_.destEntryBytes = 1;
+    copy_.srcEntryBytes = 1;
+    copy_.conversion = NULL;
+    copy_.nonTemporal = (bytes >= nonTemporalBytes);
+    issue(copy_, async);
+  }
+
+  void copyEngine_t::convert(void *dest,
+                             const void *src,
+                             const udim_t entries,
+                             const udim_t destEntryBytes,
+                             const udim_t srcEntryBytes,
+                             dtypeConversion_t conversion,
+                             const bool async) {
+    copy_t copy_;
+    copy_.dest = (char*) dest;
+    copy_.src = (const char*) src;
+    copy_.entries = entries;
+    copy_.destEntryBytes = destEntryBytes;
+    copy_.srcEntryBytes = srcEntryBytes;
+    copy_.conversion = conversion;
+    copy_.nonTemporal = false;
+    issue(copy_, async);
+  }
+
+  void copyEngine_t::issue(copy_t &copy_,
+                           const bool async) {
+    if (!copy_.entries) {
+      return;
+    }
+
+    const udim_t entryBytes = std::max(copy_.destEntryBytes, copy_.srcEntryBytes);
+    const udim_t bytes = copy_.entries * entryBytes;
+
+    if ((threads == 1) || (bytes < parallelBytes)) {
+      // Keep copies in order
+      finish();
+      runEntries(copy_, 0, copy_.entries);
+      return;
+    }
+
+    // Use a few chunks per thread to balance the load
+    const udim_t pageBytes = 4096;
+    udim_t chunkBytes = bytes / (4 * threads);
+    chunkBytes = std::max(minChunkBytes,
+                          (chunkBytes + pageBytes - 1) & ~(pageBytes - 1));
+
+    copy_t *queuedCopy = new copy_t(copy_);
+    queuedCopy->chunkEntries = chunkBytes / entryBytes;
+    queuedCopy->chunks = (
+      (copy_.entries + queuedCopy->chunkEntries - 1) / queuedCopy->chunkEntries
+    );
+    queuedCopy->nextChunk = 0;
+    queuedCopy->finishedChunks = 0;
+
+    udim_t copyCount;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (workers.empty()) {
+        startWorkers();
+      }
+      copies.push_back(queuedCopy);
+      copyCount = ++issuedCopies;
+      ++pendingCopies;
+    }
+    workAvailable.notify_all();
+
+    if (!async) {
+      helpUntilFinished(copyCount);
+    }
+  }
+
+  void copyEngine_t::runEntries(const copy_t &copy_,
+                                const udim_t offset,
+                                const udim_t entries) {
+    char *dest = copy_.dest + (offset * copy_.destEntryBytes);
+    const char *src = copy_.src + (offset * copy_.srcEntryBytes);
+    if (copy_.conversion) {
+      copy_.conversion(dest, src, entries);
+    } else {
+      copyBytes(dest, src, entries, copy_.nonTemporal);
+    }
+  }
+
+  void copyEngine_t::finish() {
+    if (isFinished()) {
+      return;
+    }
+    udim_t copyCount;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      copyCount = issuedCopies;
+    }
+    helpUntilFinished(copyCount);
+  }
+
+  bool copyEngine_t::isFinished() const {
+    return !pendingCopies.load(std::memory_order_acquire);
+  }
+
+  void copyEngine_t::copyBytes(void *dest,
+                               const void *src,
+                               const udim_t bytes,
+                               const bool nonTemporal) {
+#if defined(__SSE2__)
+    if (nonTemporal) {
+      char *destPtr = (char*) dest;
+      const char *srcPtr = (const char*) src;
+      udim_t bytesLeft = bytes;
+
+      // Streaming stores need an aligned destination
+      const udim_t headBytes = std::min(
+        bytesLeft,
+        (udim_t) ((16 - (((std::uintptr_t) destPtr) & 15)) & 15)
+      );
+      ::memcpy(destPtr, srcPtr, headBytes);
+      destPtr += headBytes;
+      srcPtr += headBytes;
+      bytesLeft -= headBytes;
+
+      // Copy a cache line at a time
+      const udim_t lines = bytesLeft / 64;
+      for (udim_t i = 0; i < lines; ++i) {
+        const __m128i v0 = _mm_loadu_si128((const __m128i*) (srcPtr + 0));
+        const __m128i v1 = _mm_loadu_si128((const __m128i*) (srcPtr + 16));
+        const __m128i v2 = _mm_loadu_si128((const __m128i*) (srcPtr + 32));
+        const __m128i v3 = _mm_loadu_si128((const __m128i*) (srcPtr + 48));
+        _mm_stream_si128((__m128i*) (destPtr + 0), v0);
+        _mm_stream_si128((__m128i*) (destPtr + 16), v1);
+        _mm_stream_si128((__m128i*) (destPtr + 32), v2);
+        _mm_stream_si128((__m128i*) (destPtr + 48), v3);
+        destPtr += 64;
+        srcPtr += 64;
+      }
+      // Make the streaming stores visible to other threads
+      _mm_sfence();
+
+      ::memcpy(destPtr, srcPtr, bytesLeft - (64 * lines));
+      return;
+    }
+#endif
+    ::memcpy(dest, src, bytes);
+  }
+
+  void copyEngine_t::startWorkers() {
+    // The calling thread also copies
+    for (int i = 1; i < threads; ++i) {
+      workers.push_back(
+        std::thread(&copyEngine_t::workerLoop, this)
+      );
+    }
+  }
+
+  void copyEngine_t::stopWorkers() {
+    if (workers.empty()) {
+      return;
+    }
+    finish();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+    workers.clear();
+    stopping = false;
+  }
+
+  void copyEngine_t::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+      if (!runChunk(lock)) {
+        workAvailable.wait(lock);
+      }
+    }
+  }
+
+  bool copyEngine_t::runChunk(std::unique_lock<std::mutex> &lock) {
+    // Only the oldest copy is worked on to keep copies in order
+    if (copies.empty()) {
+      return false;
+    }
+    copy_t &copy_ = *(copies.front());
+    if (copy_.nextChunk == copy_.chunks) {
+      return false;
+    }
+
+    const udim_t offset = (copy_.nextChunk++) * copy_.chunkEntries;
+    const udim_t entries = std::min(copy_.chunkEntries, copy_.entries - offset);
+
+    lock.unlock();
+    runEntries(copy_, offset, entries);
+    lock.lock();
+
+    if (++copy_.finishedChunks == copy_.chunks) {
+      copies.pop_front();
+      delete &copy_;
+      ++finishedCopies;
+      --pendingCopies;
+
+      // Wake up threads waiting on this copy or for the next one
+      copyFinished.notify_all();
+      workAvailable.notify_all();
+    }
+    return true;
+  }
+
+  void copyEngine_t::helpUntilFinished(const udim_t copyCount) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (finishedCopies < copyCount) {
+      if (!runChunk(lock)) {
+        copyFinished.wait(lock);
+      }
+    }
+  }
+}
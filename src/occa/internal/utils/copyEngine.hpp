@@ -0,0 +1,123 @@
+#ifndef OCCA_INTERNAL_UTILS_COPYENGINE_HEADER
+#define OCCA_INTERNAL_UTILS_COPYENGINE_HEADER
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <occa/types/typedefs.hpp>
+#include <occa/internal/utils/dtypeConversion.hpp>
+
+namespace occa {
+  //---[ Copy Engine ]------------------
+  // Host memory copies for host-based modes
+  //
+  // Large copies are split into chunks which are copied by worker
+  //   threads and the calling thread.
+  // Copies that don't fit in cache use non-temporal (streaming)
+  //   stores to avoid evicting data the kernels will use.
+  //
+  // The same chunking is used to convert values between dtypes.
+  //
+  // Copies are finished in the order they were issued.
+  // Async copies return right away and are waited on by finish(),
+  //   they are done in place if there are no worker threads.
+  class copyEngine_t {
+  public:
+    // Copies smaller than this aren't worth waking up threads for
+    static const udim_t parallelBytes;
+    // Copies larger than this skip the cache
+    static const udim_t nonTemporalBytes;
+    static const udim_t minChunkBytes;
+
+  private:
+    // Plain copies use 1-byte entries and no conversion
+    struct copy_t {
+      char *dest;
+      const char *src;
+      udim_t entries;
+      udim_t destEntryBytes;
+      udim_t srcEntryBytes;
+      dtypeConversion_t conversion;
+      bool nonTemporal;
+
+      udim_t chunkEntries;
+      udim_t chunks;
+      udim_t nextChunk;
+      udim_t finishedChunks;
+    };
+
+    int threads;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable copyFinished;
+    std::deque<copy_t*> copies;
+    udim_t issuedCopies;
+    udim_t finishedCopies;
+    std::atomic<udim_t> pendingCopies;
+    bool stopping;
+
+  public:
+    copyEngine_t(const int threads_ = 1);
+    ~copyEngine_t();
+
+    copyEngine_t(const copyEngine_t &other) = delete;
+    copyEngine_t& operator = (const copyEngine_t &other) = delete;
+
+    // Number of threads used for a copy, including the calling thread
+    void setThreads(const int threads_);
+    int getThreads() const;
+
+    void copy(void *dest,
+              const void *src,
+              const udim_t bytes,
+              const bool async = false);
+
+    // Convert [entries] values through [conversion]
+    void convert(void *dest,
+                 const void *src,
+                 const udim_t entries,
+                 const udim_t destEntryBytes,
+                 const udim_t srcEntryBytes,
+                 dtypeConversion_t conversion,
+                 const bool async = false);
+
+    // Wait for all issued copies to finish
+    void finish();
+    bool isFinished() const;
+
+    // Single-threaded copy, optionally using streaming stores
+    static void copyBytes(void *dest,
+                          const void *src,
+                          const udim_t bytes,
+                          const bool nonTemporal);
+
+  private:
+    void startWorkers();
+    void stopWorkers();
+
+    void workerLoop();
+
+    void issue(copy_t &copy_,
+               const bool async);
+
+    static void runEntries(const copy_t &copy_,
+                           const udim_t offset,
+                           const udim_t entries);
+
+    // Copies one chunk of the oldest copy (if any is left to claim)
+    // Returns false if there was nothing to claim
+    bool runChunk(std::unique_lock<std::mutex> &lock);
+
+    // Help copying until the first copyCount copies are finished
+    void helpUntilFinished(const udim_t copyCount);
+  };
+  //====================================
+}
+
+#endif
@@ -0,0 +1,168 @@
+#include <cstring>
+
+#include <occa/internal/utils/dtypeConversion.hpp>
+
+namespace occa {
+  namespace {
+    inline uint32_t floatBits(const float value) {
+      uint32_t bits;
+      ::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    inline float bitsToFloat(const uint32_t bits) {
+      float value;
+      ::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    inline uint64_t doubleBits(const double value) {
+      uint64_t bits;
+      ::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    inline double bitsToDouble(const uint64_t bits) {
+      double value;
+      ::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    // half values are stored as their uint16_t bits
+    template <class destT, class srcT>
+    inline destT convertValue(const srcT value) {
+      return (destT) value;
+    }
+
+    template <>
+    inline uint16_t convertValue<uint16_t, float>(const float value) {
+      return floatToHalf(value);
+    }
+
+    template <>
+    inline uint16_t convertValue<uint16_t, double>(const double value) {
+      return doubleToHalf(value);
+    }
+
+    template <>
+    inline float convertValue<float, uint16_t>(const uint16_t value) {
+      return halfToFloat(value);
+    }
+
+    template <>
+    inline double convertValue<double, uint16_t>(const uint16_t value) {
+      return (double) halfToFloat(value);
+    }
+
+    template <class destT, class srcT>
+    void convertValues(void *dest,
+                       const void *src,
+                       const udim_t entries) {
+      destT *destPtr = (destT*) dest;
+      const srcT *srcPtr = (const srcT*) src;
+      for (udim_t i = 0; i < entries; ++i) {
+        destPtr[i] = convertValue<destT, srcT>(srcPtr[i]);
+      }
+    }
+
+    // 0: double, 1: float, 2: half
+    int getConversionIndex(const dtype_t &dtype) {
+      if (dtype == dtype::double_) {
+        return 0;
+      }
+      if (dtype == dtype::float_) {
+        return 1;
+      }
+      if (dtype == dtype::half) {
+        return 2;
+      }
+      return -1;
+    }
+  }
+
+  dtypeConversion_t getDtypeConversion(const dtype_t &destDtype,
+                                       const dtype_t &srcDtype) {
+    static const dtypeConversion_t conversions[3][3] = {
+      {convertValues<double, double>,
+       convertValues<double, float>,
+       convertValues<double, uint16_t>},
+      {convertValues<float, double>,
+       convertValues<float, float>,
+       convertValues<float, uint16_t>},
+      {convertValues<uint16_t, double>,
+       convertValues<uint16_t, float>,
+       convertValues<uint16_t, uint16_t>}
+    };
+
+    const int destIndex = getConversionIndex(destDtype);
+    const int srcIndex = getConversionIndex(srcDtype);
+    if ((destIndex < 0) || (srcIndex < 0)) {
+      return NULL;
+    }
+    return conversions[destIndex][srcIndex];
+  }
+
+  uint16_t floatToHalf(const float value) {
+    const uint32_t bits = floatBits(value);
+    const uint16_t sign = (uint16_t) ((bits >> 16) & 0x8000);
+    uint32_t absBits = bits & 0x7FFFFFFF;
+
+    // Inf, NaN, or too large to fit (rounds to Inf)
+    if (absBits >= (143u << 23)) {
+      return sign | ((absBits > (255u << 23)) ? 0x7E00 : 0x7C00);
+    }
+
+    // Subnormal halfs: let the FPU round the mantissa by adding 0.5
+    if (absBits < (113u << 23)) {
+      const uint32_t denormMagic = (126u << 23);
+      const float rounded = bitsToFloat(absBits) + bitsToFloat(denormMagic);
+      return sign | (uint16_t) (floatBits(rounded) - denormMagic);
+    }
+
+    // Rebias the exponent and round the mantissa to nearest even
+    const uint32_t mantissaIsOdd = (absBits >> 13) & 1;
+    absBits += ((uint32_t) (15 - 127) << 23) + 0xFFF + mantissaIsOdd;
+    return sign | (uint16_t) (absBits >> 13);
+  }
+
+  uint16_t doubleToHalf(const double value) {
+    // Same as floatToHalf but rounding straight from the double bits,
+    //   going through float would round twice
+    const uint64_t bits = doubleBits(value);
+    const uint16_t sign = (uint16_t) ((bits >> 48) & 0x8000);
+    uint64_t absBits = bits & 0x7FFFFFFFFFFFFFFFull;
+
+    // Inf, NaN, or too large to fit (rounds to Inf)
+    if (absBits >= (1039ull << 52)) {
+      return sign | ((absBits > (2047ull << 52)) ? 0x7E00 : 0x7C00);
+    }
+
+    // Subnormal halfs: let the FPU round the mantissa by adding 2^28
+    if (absBits < (1009ull << 52)) {
+      const uint64_t denormMagic = (1051ull << 52);
+      const double rounded = bitsToDouble(absBits) + bitsToDouble(denormMagic);
+      return sign | (uint16_t) (doubleBits(rounded) - denormMagic);
+    }
+
+    // Rebias the exponent and round the mantissa to nearest even
+    const uint64_t mantissaIsOdd = (absBits >> 42) & 1;
+    absBits += ((uint64_t) (15 - 1023) << 52) + 0x1FFFFFFFFFFull + mantissaIsOdd;
+    return sign | (uint16_t) (absBits >> 42);
+  }
+
+  float halfToFloat(const uint16_t value) {
+    const uint32_t sign = ((uint32_t) (value & 0x8000)) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x3FF;
+
+    if (exponent == 0) {
+      // Zero or subnormal (mantissa * 2^-24)
+      const float magnitude = (float) mantissa * bitsToFloat(103u << 23);
+      return bitsToFloat(sign | floatBits(magnitude));
+    }
+    if (exponent == 31) {
+      return bitsToFloat(sign | 0x7F800000 | (mantissa << 13));
+    }
+    return bitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+  }
+}
@@ -0,0 +1,26 @@
+#ifndef OCCA_INTERNAL_UTILS_DTYPECONVERSION_HEADER
+#define OCCA_INTERNAL_UTILS_DTYPECONVERSION_HEADER
+
+#include <cstdint>
+
+#include <occa/dtype.hpp>
+#include <occa/types/typedefs.hpp>
+
+namespace occa {
+  // Converts [entries] values from [src] and stores them in [dest]
+  typedef void (*dtypeConversion_t)(void *dest,
+                                    const void *src,
+                                    const udim_t entries);
+
+  // Returns NULL if there is no conversion from [srcDtype] to [destDtype]
+  // Supported conversions are between double, float, and half
+  dtypeConversion_t getDtypeConversion(const dtype_t &destDtype,
+                                       const dtype_t &srcDtype);
+
+  // IEEE 754 binary16, rounding to nearest even
+  uint16_t floatToHalf(const float value);
+  uint16_t doubleToHalf(const double value);
+  float halfToFloat(const uint16_t value);
+}
+
+#endif
@@ -14,6 +14,28 @@ namespace occa {
       return false;
     }
 
+    //---[ Charset Table ]--------------
+    charsetTable_t::charsetTable_t(const char *charset) {
+      for (int i = 0; i < 256; ++i) {
+        table[i] = false;
+      }
+      add(charset);
+    }
+
+    void charsetTable_t::add(const char c) {
+      // The null terminator is never part of a charset
+      if (c != '\0') {
+        table[(unsigned char) c] = true;
+      }
+    }
+
+    void charsetTable_t::add(const char *charset) {
+      while (*charset != '\0') {
+        add(*(charset++));
+      }
+    }
+    //==================================
+
     //---[ Skip ]-----------------------
     void skipTo(const char *&c, const char delimiter) {
       while (*c != '\0') {
@@ -24,6 +24,25 @@ namespace occa {
 
     bool inCharset(const char c, const char *charset);
 
+    //---[ Charset Table ]--------------
+    // Lookup table for charsets checked in hot loops, where
+    //   scanning the charset string for every character adds up
+    class charsetTable_t {
+    private:
+      bool table[256];
+
+    public:
+      charsetTable_t(const char *charset = "");
+
+      void add(const char c);
+      void add(const char *charset);
+
+      inline bool has(const char c) const {
+        return table[(unsigned char) c];
+      }
+    };
+    //==================================
+
     //---[ Skip ]-----------------------
     void skipTo(const char *&c, const char delimiter);
     void skipTo(const char *&c, const char delimiter, const char escapeChar);
@@ -36,15 +36,10 @@ namespace occa {
              const bool stripRight,
              std::string &output) {
     const char *start = str.c_str();
-    const char *end = start + str.size() - 1;
-
-    if (start >= end) {
-      output = str;
-      return;
-    }
+    const char *end = start + str.size();
 
     if (stripLeft) {
-      while ((*start != '\0') &&
+      while ((start < end) &&
              lex::isWhitespace(*start)) {
         ++start;
       }
@@ -52,10 +47,9 @@ namespace occa {
 
     if (stripRight) {
       while ((start < end) &&
-             lex::isWhitespace(*end)) {
+             lex::isWhitespace(*(end - 1))) {
         --end;
       }
-      ++end;
     }
 
     output = std::string(start, end - start);
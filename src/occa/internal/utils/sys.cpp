@@ -1,5 +1,7 @@
 #include <occa/defines.hpp>
 
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
@@ -10,6 +12,7 @@
 #  include <pthread.h>
 #  include <signal.h>
 #  include <stdio.h>
+#  include <sys/mman.h>
 #  include <sys/types.h>
 #  include <sys/stat.h>
 #  include <sys/syscall.h>
@@ -970,6 +973,76 @@ namespace occa {
       ::free(ptr);
     }
 
+    void* mmapFile(const std::string &filename,
+                   const bool readOnly,
+                   udim_t &bytes) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      const std::string expFilename = io::expandFilename(filename);
+
+      int fileHandle = ::open(expFilename.c_str(),
+                              readOnly ? O_RDONLY : O_RDWR);
+      OCCA_ERROR("Unable to open file [" << filename << "]: " << strerror(errno),
+                 fileHandle != -1);
+
+      struct stat fileInfo;
+      const int status = fstat(fileHandle, &fileInfo);
+      if (status != 0) {
+        ::close(fileHandle);
+        OCCA_FORCE_ERROR("Unable to stat file [" << filename << "]: " << strerror(errno));
+      }
+
+      bytes = fileInfo.st_size;
+      if (!bytes) {
+        ::close(fileHandle);
+        OCCA_FORCE_ERROR("Unable to map empty file [" << filename << "]");
+      }
+
+      void *ptr = ::mmap(NULL, bytes,
+                         readOnly ? PROT_READ : (PROT_READ | PROT_WRITE),
+                         MAP_SHARED,
+                         fileHandle, 0);
+      // The mapping keeps its own reference to the file
+      ::close(fileHandle);
+
+      OCCA_ERROR("Unable to map file [" << filename << "]: " << strerror(errno),
+                 ptr != MAP_FAILED);
+
+      return ptr;
+#else
+      OCCA_FORCE_ERROR("Memory-mapped files are not supported on Windows");
+      return NULL;
+#endif
+    }
+
+    void munmapFile(void *ptr, const udim_t bytes) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      if (ptr) {
+        ::munmap(ptr, bytes);
+      }
+#endif
+    }
+
+    void madvise(void *ptr,
+                 const udim_t bytes,
+                 const std::string &advice) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      int adviceFlag = MADV_NORMAL;
+      if (advice == "sequential") {
+        adviceFlag = MADV_SEQUENTIAL;
+      } else if (advice == "random") {
+        adviceFlag = MADV_RANDOM;
+      } else if (advice == "willneed") {
+        adviceFlag = MADV_WILLNEED;
+      } else {
+        OCCA_ERROR("Unknown madvise advice [" << advice << "],"
+                   << " expected [normal], [sequential], [random], or [willneed]",
+                   advice == "normal");
+      }
+      // Advice is only a hint, failures are ignored
+      ignoreResult( ::madvise(ptr, bytes, adviceFlag) );
+#endif
+    }
+
     void* dlopen(const std::string &filename) {
 
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
@@ -1041,17 +1114,49 @@ namespace occa {
 
     std::string stacktrace(const int frameStart,
                            const std::string indent) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      std::vector<void*> frames;
+      getStackFrames(frames, frameStart);
+      return stacktrace(frames, indent);
+#else
+
+    // auto trace = std::stacktrace::current();
+    // std::stringstream ss;
+    // std::cout << std::to_string(trace) << '\n';
+    // return ss.str();
+
+    return std::string("    TODO: stacktrace\n");   // NBN: <stacktrace> C++ 2023
+#endif
+    }
+
+    void getStackFrames(std::vector<void*> &frames,
+                        const int frameStart) {
+      frames.clear();
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
       static const int maxFrames = 1024;
-      static void *frames[maxFrames];
+      void *allFrames[maxFrames];
 
-      const int frameCount = ::backtrace(frames, maxFrames);
-      char **symbols = ::backtrace_symbols(frames, frameCount);
+      const int frameCount = ::backtrace(allFrames, maxFrames);
+      // Skip this frame
+      for (int i = frameStart + 1; i < frameCount; ++i) {
+        frames.push_back(allFrames[i]);
+      }
+#endif
+    }
+
+    std::string stacktrace(const std::vector<void*> &frames,
+                           const std::string indent) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      const int frameCount = (int) frames.size();
+      if (!frameCount) {
+        return "";
+      }
+      char **symbols = ::backtrace_symbols(&(frames[0]), frameCount);
 
-      const int digits = toString(frameCount - frameStart).size();
+      const int digits = toString(frameCount).size();
 
       std::stringstream ss;
-      for (int i = frameStart; i < frameCount; ++i) {
+      for (int i = 0; i < frameCount; ++i) {
         const std::string localFrame = toString(frameCount - i);
         ss << indent
            << std::string(digits - localFrame.size(), ' ')
@@ -1063,13 +1168,7 @@ namespace occa {
 
       return ss.str();
 #else
-
-    // auto trace = std::stacktrace::current();
-    // std::stringstream ss;
-    // std::cout << std::to_string(trace) << '\n';
-    // return ss.str();
-
-    return std::string("    TODO: stacktrace\n");   // NBN: <stacktrace> C++ 2023
+      return std::string("    TODO: stacktrace\n");
 #endif
     }
 
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include <occa/defines.hpp>
 #include <occa/types.hpp>
@@ -153,6 +154,19 @@ namespace occa {
     void* malloc(udim_t bytes);
     void free(void *ptr);
 
+    // Maps the whole file into memory and sets [bytes] to the file size
+    // Read-write mappings are shared, writing changes back to the file
+    void* mmapFile(const std::string &filename,
+                   const bool readOnly,
+                   udim_t &bytes);
+
+    void munmapFile(void *ptr, const udim_t bytes);
+
+    // [advice] is one of: normal, sequential, random, willneed
+    void madvise(void *ptr,
+                 const udim_t bytes,
+                 const std::string &advice);
+
     void* dlopen(const std::string &filename);
 
     functionPtr_t dlsym(void *dlHandle,
@@ -165,6 +179,13 @@ namespace occa {
     std::string stacktrace(const int frameStart = 0,
                            const std::string indent = "");
 
+    // Collecting frames is cheap, formatting them is not
+    void getStackFrames(std::vector<void*> &frames,
+                        const int frameStart = 0);
+
+    std::string stacktrace(const std::vector<void*> &frames,
+                           const std::string indent = "");
+
     std::string prettyStackSymbol(void *frame, const char *symbol);
     //==================================
   }
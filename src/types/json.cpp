@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cstring>
 
 #include <occa/defines.hpp>
@@ -6,8 +7,84 @@
 #include <occa/internal/utils/lex.hpp>
 
 namespace occa {
+  //---[ Object Data ]------------------
+  // Object entries shared between json copies along with their hash
+  class jsonObjectData_t {
+  public:
+    enum hashState_t {
+      hashNotCached,
+      hashCaching,
+      hashCached
+    };
+
+    jsonObject object;
+    // Only set by the (non-const) owner when it hands out a reference
+    bool isLeaked;
+
+    // Copies can hash the same object from several threads
+    std::atomic<int> hashState;
+    hash_t hash;
+
+    jsonObjectData_t() :
+      isLeaked(false),
+      hashState(hashNotCached) {}
+
+    jsonObjectData_t(const jsonObject &object_) :
+      object(object_),
+      isLeaked(false),
+      hashState(hashNotCached) {}
+
+    bool getHash(hash_t &hash_) const {
+      if (isLeaked
+          || (hashState.load(std::memory_order_acquire) != hashCached)) {
+        return false;
+      }
+      hash_ = hash;
+      return true;
+    }
+
+    void setHash(const hash_t &hash_) {
+      // Leaked objects can change through the references they handed out
+      if (isLeaked) {
+        return;
+      }
+      int expected = hashNotCached;
+      if (hashState.compare_exchange_strong(expected, hashCaching)) {
+        hash = hash_;
+        hashState.store(hashCached, std::memory_order_release);
+      }
+    }
+
+    void invalidateHash() {
+      hashState.store(hashNotCached, std::memory_order_relaxed);
+    }
+  };
+
+  namespace {
+    // Leaked objects are copied since they can still be modified
+    std::shared_ptr<jsonObjectData_t> shareObject(const std::shared_ptr<jsonObjectData_t> &data) {
+      if (data && data->isLeaked) {
+        return std::make_shared<jsonObjectData_t>(data->object);
+      }
+      return data;
+    }
+  }
+  //====================================
+
   const char json::objectKeyEndChars[] = " \t\r\n\v\f:";
 
+  json::json(const json &j) :
+    type(j.type),
+    value_{j.value_.number,
+           j.value_.string,
+           j.value_.array,
+           shareObject(j.value_.object)} {}
+
+  json::json(const jsonObject &value) :
+    type(object_) {
+    value_.object = std::make_shared<jsonObjectData_t>(value);
+  }
+
   json::json(const std::string &name,
              const primitive &value) {
     type = object_;
@@ -27,17 +104,65 @@ namespace occa {
     type = none_;
     value_.string = "";
     value_.number = 0;
-    value_.object.clear();
     value_.array.clear();
+    // Keep leaked objects alive since references to them are still valid
+    if (value_.object && value_.object->isLeaked) {
+      value_.object->object.clear();
+    } else {
+      value_.object.reset();
+    }
     return *this;
   }
 
   json& json::operator = (const json &j) {
     type = j.type;
-    value_ = j.value_;
+    value_.number = j.value_.number;
+    value_.string = j.value_.string;
+    value_.array = j.value_.array;
+    if (value_.object && value_.object->isLeaked) {
+      setObject(j.object());
+    } else {
+      value_.object = shareObject(j.value_.object);
+    }
     return *this;
   }
 
+  const jsonObject& json::emptyObject() {
+    static const jsonObject *emptyObject_ = new jsonObject();
+    return *emptyObject_;
+  }
+
+  const jsonObject& json::object() const {
+    return value_.object ? value_.object->object : emptyObject();
+  }
+
+  jsonObject& json::writeObject() {
+    if (!value_.object) {
+      value_.object = std::make_shared<jsonObjectData_t>();
+    } else if (value_.object.use_count() > 1) {
+      value_.object = std::make_shared<jsonObjectData_t>(value_.object->object);
+    } else {
+      value_.object->invalidateHash();
+    }
+    return value_.object->object;
+  }
+
+  jsonObject& json::leakObject() {
+    jsonObject &obj = writeObject();
+    value_.object->isLeaked = true;
+    return obj;
+  }
+
+  void json::setObject(const jsonObject &obj) {
+    if (value_.object && value_.object->isLeaked) {
+      // Copy through a temporary in case obj lives inside our object
+      jsonObject objCopy = obj;
+      value_.object->object.swap(objCopy);
+    } else {
+      value_.object = std::make_shared<jsonObjectData_t>(obj);
+    }
+  }
+
   bool json::isInitialized() const {
     return (type != none_);
   }
@@ -140,18 +265,19 @@ namespace occa {
       break;
     }
     case object_: {
-      if (!value_.object.size()) {
+      const jsonObject &obj = object();
+      if (!obj.size()) {
         out += "{}";
         break;
       }
-      jsonObject::const_iterator it = value_.object.begin();
+      jsonObject::const_iterator it = obj.begin();
       out += '{';
-      if (it != value_.object.end()) {
+      if (it != obj.end()) {
         std::string newIndent = currentIndent + indent;
         if (indent.size()) {
           out += '\n';
         }
-        while (it != value_.object.end()) {
+        while (it != obj.end()) {
           const std::string &key = it->first;
           const json &value = it->second;
 
@@ -167,7 +293,7 @@ namespace occa {
           }
 
           ++it;
-          if (it != value_.object.end()) {
+          if (it != obj.end()) {
             if (indent.size()) {
               out += ",\n";
             } else {
@@ -322,7 +448,7 @@ namespace occa {
     OCCA_ERROR("Key must be followed by ':'",
                *c == ':');
     ++c;
-    value_.object[key].load(c);
+    writeObject()[key].load(c);
   }
 
   void json::loadArray(const char *&c) {
@@ -421,7 +547,7 @@ namespace occa {
       break;
     }
     case object_: {
-      mergeWithObject(j.value_.object);
+      mergeWithObject(j.object());
       break;
     }}
     return *this;
@@ -437,14 +563,14 @@ namespace occa {
       // If we're merging two json objects, recursively merge them
       if (val.isObject() && has(key)) {
         // Reuse prefetch
-        json &oldVal = value_.object[key];
+        json &oldVal = writeObject()[key];
         if (oldVal.isObject()) {
           oldVal += val;
         } else {
           oldVal = val;
         }
       } else {
-        value_.object[key] = val;
+        writeObject()[key] = val;
       }
     }
   }
@@ -466,8 +592,9 @@ namespace occa {
         ++c;
       }
 
-      jsonObject::const_iterator it = j->value_.object.find(key);
-      if (it == j->value_.object.end()) {
+      const jsonObject &obj = j->object();
+      jsonObject::const_iterator it = obj.find(key);
+      if (it == obj.end()) {
         return false;
       }
       j = &(it->second);
@@ -498,7 +625,7 @@ namespace occa {
         ++c;
       }
 
-      j = &(j->value_.object[key]);
+      j = &(j->leakObject()[key]);
       if (j->type == none_) {
         j->type = object_;
         exists = false;
@@ -525,8 +652,9 @@ namespace occa {
         ++c;
       }
 
-      jsonObject::const_iterator it = j->value_.object.find(key);
-      if (it == j->value_.object.end()) {
+      const jsonObject &obj = j->object();
+      jsonObject::const_iterator it = obj.find(key);
+      if (it == obj.end()) {
         return default_;
       }
       j = &(it->second);
@@ -571,18 +699,19 @@ namespace occa {
       return (int) value_.array.size();
     }
     case object_: {
-      return (int) value_.object.size();
+      return (int) object().size();
     }}
     return 0;
   }
 
-  json json::getPathValue(const char *key) const {
+  const json& json::getPathValue(const char *key) const {
+    static const json default_;
     const json *j = this;
     const char *c = key;
 
     while (*c != '\0') {
       if (j->type != object_) {
-        return json();
+        return default_;
       }
 
       const char *cStart = c;
@@ -592,9 +721,10 @@ namespace occa {
         ++c;
       }
 
-      jsonObject::const_iterator it = j->value_.object.find(nextKey);
-      if (it == j->value_.object.end()) {
-        return json();
+      const jsonObject &obj = j->object();
+      jsonObject::const_iterator it = obj.find(nextKey);
+      if (it == obj.end()) {
+        return default_;
       }
       j = &(it->second);
     }
@@ -616,12 +746,13 @@ namespace occa {
       }
 
       if (*c == '\0') {
-        j->value_.object.erase(key);
+          j->writeObject().erase(key);
         return *this;
       }
 
-      jsonObject::iterator it = j->value_.object.find(key);
-      if (it == j->value_.object.end()) {
+      jsonObject &obj = j->writeObject();
+      jsonObject::iterator it = obj.find(key);
+      if (it == obj.end()) {
         return *this;
       }
       j = &(it->second);
@@ -630,9 +761,88 @@ namespace occa {
   }
 
   hash_t json::hash() const {
-    std::string out;
-    dumpToString(out);
-    return occa::hash(out);
+    // Only objects cache their hash, in the data shared by copies
+    jsonObjectData_t *data = (
+      (type == object_)
+      ? value_.object.get()
+      : NULL
+    );
+
+    hash_t hash_;
+    if (data && data->getHash(hash_)) {
+      return hash_;
+    }
+
+    hasher_t hasher;
+    hashValue(hasher);
+    hash_ = hasher.digest();
+
+    if (data) {
+      data->setHash(hash_);
+    }
+    return hash_;
+  }
+
+  void json::hashValue(hasher_t &hasher) const {
+    const int typeTag = (int) type;
+    hasher.update(&typeTag, sizeof(typeTag));
+
+    switch (type) {
+    case none_: break;
+    case null_: break;
+    case number_: {
+      // Hash numbers by value so the same number stored with
+      //   different integer types hashes the same
+      const primitive &number = value_.number;
+      if (number.isBool()) {
+        const char value = (bool) number;
+        hasher.update(&value, sizeof(value));
+      } else if (number.isFloat()) {
+        const double value = (double) number;
+        hasher.update(&value, sizeof(value));
+      } else {
+        const int64_t value = (int64_t) number;
+        hasher.update(&value, sizeof(value));
+      }
+      break;
+    }
+    case string_: {
+      const udim_t bytes = value_.string.size();
+      hasher.update(&bytes, sizeof(bytes));
+      hasher.update(value_.string);
+      break;
+    }
+    case array_: {
+      const udim_t entries = value_.array.size();
+      hasher.update(&entries, sizeof(entries));
+      for (const json &child : value_.array) {
+        child.hashChild(hasher);
+      }
+      break;
+    }
+    case object_: {
+      const udim_t entries = object().size();
+      hasher.update(&entries, sizeof(entries));
+      for (const auto &it : object()) {
+        const std::string &key = it.first;
+        const udim_t keyBytes = key.size();
+        hasher.update(&keyBytes, sizeof(keyBytes));
+        hasher.update(key);
+        it.second.hashChild(hasher);
+      }
+      break;
+    }}
+  }
+
+  void json::hashChild(hasher_t &hasher) const {
+    // Objects use their cached hash, other values are cheaper to
+    //   hash in place than to digest separately
+    if (type == object_) {
+      const hash_t childHash = hash();
+      hasher.update(childHash.h, sizeof(childHash.h));
+    } else {
+      hashValue(hasher);
+    }
   }
 
   std::string json::toString() const {
@@ -645,7 +855,7 @@ namespace occa {
   strVector json::keys() const {
     strVector vec;
     if (type == object_) {
-      const jsonObject &obj = value_.object;
+      const jsonObject &obj = object();
       jsonObject::const_iterator it = obj.begin();
       while (it != obj.end()) {
         vec.push_back(it->first);
@@ -658,7 +868,7 @@ namespace occa {
   jsonArray json::values() const {
     jsonArray vec;
     if (type == object_) {
-      const jsonObject &obj = value_.object;
+      const jsonObject &obj = object();
       jsonObject::const_iterator it = obj.begin();
       while (it != obj.end()) {
         vec.push_back(it->second);
@@ -29,25 +29,21 @@ namespace occa {
     const char *c0 = c;
     primitive p;
 
-    const int cLength = strlen(c);
+    // strncmp stops at the null terminator so there is no need to
+    //   measure the (possibly very long) rest of the string
+    if (strncmp(c, "true", 4) == 0) {
+      p = true;
+      p.source = "true";
 
-    if(cLength >= 4){
-      if (strncmp(c, "true", 4) == 0) {
-        p = true;
-        p.source = "true";
-
-        c += 4;
-        return p;
-      }
+      c += 4;
+      return p;
     }
-    if(cLength >= 5){
-      if (strncmp(c, "false", 5) == 0) {
-        p = false;
-        p.source = "false";
+    if (strncmp(c, "false", 5) == 0) {
+      p = false;
+      p.source = "false";
 
-        c += 5;
-        return p;
-      }
+      c += 5;
+      return p;
     }
 
     if ((*c == '+') || (*c == '-')) {
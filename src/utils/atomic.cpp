@@ -0,0 +1,39 @@
+#include <atomic>
+#include <cstdint>
+
+#include <occa/utils/atomic.hpp>
+
+namespace occa {
+  namespace atomics {
+    namespace {
+      // 2^10 stripes, each on its own cache line
+      const int stripeBits = 10;
+      const int stripeCount = (1 << stripeBits);
+
+      struct alignas(64) stripe_t {
+        std::atomic<bool> locked;
+      };
+
+      // Zero-initialized as static storage
+      stripe_t stripes[stripeCount];
+    }
+
+    stripeLock::stripeLock(const void *ptr) :
+      stripe(getStripe(ptr)) {
+      std::atomic<bool> &locked = stripes[stripe].locked;
+      while (locked.exchange(true, std::memory_order_acquire)) {
+        while (locked.load(std::memory_order_relaxed)) {}
+      }
+    }
+
+    stripeLock::~stripeLock() {
+      stripes[stripe].locked.store(false, std::memory_order_release);
+    }
+
+    int stripeLock::getStripe(const void *ptr) {
+      // Fibonacci hashing keeps neighboring entries on different stripes
+      const uint64_t address = (uint64_t) (uintptr_t) ptr;
+      return (int) (((address >> 2) * 0x9E3779B97F4A7C15ULL) >> (64 - stripeBits));
+    }
+  }
+}
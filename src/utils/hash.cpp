@@ -1,7 +1,17 @@
+#include <cstring>
 #include <random>
 #include <sstream>
 #include <stdint.h>
 
+#include <occa/defines.hpp>
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 #include <occa/types.hpp>
 #include <occa/utils/hash.hpp>
 #include <occa/internal/utils/env.hpp>
@@ -145,27 +155,136 @@ namespace occa {
     return out;
   }
 
-  hash_t hash(const void *ptr, udim_t bytes) {
-    std::stringstream ss;
-    const char *c = (char*) ptr;
+  //---[ Hasher ]-----------------------
+  namespace {
+    const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t prime3 = 0x165667B19E3779F9ULL;
+    const uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+    const uint64_t prime5 = 0x27D4EB2F165667C5ULL;
 
-    hash_t hash;
-    int *h = hash.h;
+    const int stripeBytes = 32;
 
-    const int p[8] = {
-      102679, 102701, 102761, 102763,
-      102769, 102793, 102797, 102811
-    };
+    inline uint64_t rotateLeft(const uint64_t x, const int bits) {
+      return (x << bits) | (x >> (64 - bits));
+    }
+
+    inline uint64_t loadWord(const unsigned char *c) {
+      uint64_t word;
+      ::memcpy(&word, c, sizeof(word));
+      return word;
+    }
+
+    inline uint64_t mixWord(const uint64_t lane, const uint64_t word) {
+      return rotateLeft(lane + (word * prime2), 31) * prime1;
+    }
+
+    inline uint64_t avalanche(uint64_t x) {
+      x ^= x >> 33;
+      x *= prime2;
+      x ^= x >> 29;
+      x *= prime3;
+      x ^= x >> 32;
+      return x;
+    }
 
-    for (udim_t i = 0; i < bytes; ++i) {
-      for (int j = 0; j < 8; ++j) {
-        h[j] = (h[j] * p[j]) ^ c[i];
+    // Lanes are independent so the compiler can keep all 4 in flight
+    inline void mixStripe(uint64_t *lanes, const unsigned char *c) {
+      lanes[0] = mixWord(lanes[0], loadWord(c));
+      lanes[1] = mixWord(lanes[1], loadWord(c + 8));
+      lanes[2] = mixWord(lanes[2], loadWord(c + 16));
+      lanes[3] = mixWord(lanes[3], loadWord(c + 24));
+    }
+  }
+
+  hasher_t::hasher_t() {
+    clear();
+  }
+
+  void hasher_t::clear() {
+    lanes[0] = prime1 + prime2;
+    lanes[1] = prime2;
+    lanes[2] = 0;
+    lanes[3] = 0 - prime1;
+    bufferBytes = 0;
+    totalBytes = 0;
+  }
+
+  void hasher_t::update(const void *ptr, udim_t bytes) {
+    const unsigned char *c = (const unsigned char*) ptr;
+    totalBytes += bytes;
+
+    // Finish the partial stripe from the last update
+    if (bufferBytes) {
+      const udim_t missingBytes = stripeBytes - bufferBytes;
+      const udim_t copyBytes = (bytes < missingBytes) ? bytes : missingBytes;
+      ::memcpy(buffer + bufferBytes, c, copyBytes);
+      bufferBytes += (int) copyBytes;
+      c += copyBytes;
+      bytes -= copyBytes;
+
+      if (bufferBytes < stripeBytes) {
+        return;
       }
+      mixStripe(lanes, buffer);
+      bufferBytes = 0;
+    }
+
+    for (; bytes >= (udim_t) stripeBytes; bytes -= stripeBytes) {
+      mixStripe(lanes, c);
+      c += stripeBytes;
+    }
+
+    if (bytes) {
+      ::memcpy(buffer, c, bytes);
+      bufferBytes = (int) bytes;
+    }
+  }
+
+  void hasher_t::update(const std::string &str) {
+    update(str.c_str(), str.size());
+  }
+
+  hash_t hasher_t::digest() const {
+    uint64_t finalLanes[4] = {
+      lanes[0], lanes[1], lanes[2], lanes[3]
+    };
+
+    // Zero-pad the last stripe, the total size below tells paddings apart
+    if (bufferBytes) {
+      unsigned char lastStripe[stripeBytes];
+      ::memset(lastStripe, 0, stripeBytes);
+      ::memcpy(lastStripe, buffer, bufferBytes);
+      mixStripe(finalLanes, lastStripe);
+    }
+
+    for (int i = 0; i < 4; ++i) {
+      finalLanes[i] = avalanche(finalLanes[i] ^ (((uint64_t) totalBytes + i) * prime5));
+    }
+
+    // Make every output word depend on every lane
+    hash_t hash;
+    for (int i = 0; i < 4; ++i) {
+      const uint64_t value = avalanche(
+        finalLanes[i]
+        + rotateLeft(finalLanes[(i + 1) % 4], 17) * prime4
+        + rotateLeft(finalLanes[(i + 2) % 4], 41)
+        + finalLanes[(i + 3) % 4]
+      );
+      hash.h[2*i + 0] = (int) (value & 0xFFFFFFFF);
+      hash.h[2*i + 1] = (int) (value >> 32);
     }
     hash.initialized = true;
 
     return hash;
   }
+  //====================================
+
+  hash_t hash(const void *ptr, udim_t bytes) {
+    hasher_t hasher;
+    hasher.update(ptr, bytes);
+    return hasher.digest();
+  }
 
   hash_t hash(const char *c) {
     return hash(c, strlen(c));
@@ -176,9 +295,30 @@ namespace occa {
   }
 
   hash_t hashFile(const std::string &filename) {
-    const char *c = io::c_read(io::expandFilename(filename));
-    hash_t ret = hash(c);
-    delete [] c;
-    return ret;
+    const std::string expFilename = io::expandFilename(filename);
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    // Hash the mapped pages directly instead of copying the file into a buffer
+    const int fd = ::open(expFilename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      struct stat statbuf;
+      void *ptr = MAP_FAILED;
+      udim_t bytes = 0;
+      if (!::fstat(fd, &statbuf) && (statbuf.st_size > 0)) {
+        bytes = (udim_t) statbuf.st_size;
+        ptr = ::mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      ::close(fd);
+
+      if (ptr != MAP_FAILED) {
+        hash_t ret = hash(ptr, bytes);
+        ::munmap(ptr, bytes);
+        return ret;
+      }
+    }
+#endif
+
+    // Empty, pseudo (e.g. /proc) or unmappable files
+    return hash(io::read(expFilename));
   }
 }
@@ -34,8 +34,10 @@ namespace occa {
         return;
       }
 
-      libraryPathMap_t &libraryPaths = getLibraryPathMap();
-      libraryPaths[safeLibrary] = safePath;
+      mutex_t &mutex = getLibraryPathMutex();
+      mutex.lock();
+      getLibraryPathMap()[safeLibrary] = safePath;
+      mutex.unlock();
     }
   }
 }
@@ -1,14 +1,26 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
 #include <occa.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 void testProperties();
 void testWrapMemory();
+void testMmapFile();
+void testStagingBuffers();
+void testAllocationTracking();
 void testUnwrap();
+void testBuildFusedKernel();
 
 int main(const int argc, const char **argv) {
   testProperties();
   testWrapMemory();
+  testMmapFile();
+  testStagingBuffers();
+  testAllocationTracking();
   testUnwrap();
+  testBuildFusedKernel();
 
   return 0;
 }
@@ -125,6 +137,172 @@ void testWrapMemory() {
   ASSERT_EQ((int) mem.length<int>(), 1);
 }
 
+void testMmapFile() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string filename = "occa_test_mmap_file.bin";
+  const int entries = 64;
+
+  float values[entries];
+  for (int i = 0; i < entries; ++i) {
+    values[i] = (float) i;
+  }
+  {
+    std::ofstream out(filename.c_str(), std::ios::binary);
+    out.write((const char*) values, sizeof(values));
+  }
+
+  // Read-only mappings see the file contents without copying them
+  {
+    occa::memory mem = device.mmapFile<float>(filename, {
+      {"access", "sequential"},
+      {"prefetch", true}
+    });
+    ASSERT_EQ((int) mem.length(), entries);
+    ASSERT_EQ(mem.dtype(), occa::dtype::float_);
+    ASSERT_EQ(device.memoryAllocated(), (occa::udim_t) 0);
+
+    float hostValues[entries];
+    mem.copyTo(hostValues);
+    for (int i = 0; i < entries; ++i) {
+      ASSERT_EQ(hostValues[i], values[i]);
+    }
+    ASSERT_EQ(mem.ptr<float>()[entries - 1], values[entries - 1]);
+  }
+
+  // Writes go back to the file
+  {
+    occa::memory mem = device.mmapFile(filename, {
+      {"read_only", false}
+    });
+    ASSERT_EQ(mem.size(), sizeof(values));
+
+    const float value = -1;
+    mem.copyFrom(&value, sizeof(float), 2 * sizeof(float));
+    mem.free();
+
+    float fileValues[entries];
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    in.read((char*) fileValues, sizeof(fileValues));
+    ASSERT_EQ(fileValues[1], values[1]);
+    ASSERT_EQ(fileValues[2], value);
+  }
+
+  ASSERT_THROW(
+    device.mmapFile(filename, {{"access", "backwards"}});
+  );
+  ASSERT_THROW(
+    device.mmapFile(filename, occa::dtype::double3, occa::json());
+  );
+  ASSERT_THROW(
+    device.mmapFile("occa_test_missing_file.bin");
+  );
+
+  std::remove(filename.c_str());
+}
+
+void testStagingBuffers() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const occa::udim_t bytes = 1000;
+
+  char *a = (char*) device.reserveStagingBuffer(bytes);
+  char *b = (char*) device.reserveStagingBuffer(bytes);
+  ASSERT_NEQ(a, b);
+  ASSERT_EQ(((occa::udim_t) a) % 64, (occa::udim_t) 0);
+  ASSERT_EQ(((occa::udim_t) b) % 64, (occa::udim_t) 0);
+  ASSERT_GE(device.stagingBytesReserved(), 2 * bytes);
+
+  // Transfers through staging buffers
+  int *values = (int*) a;
+  for (int i = 0; i < 10; ++i) {
+    values[i] = i;
+  }
+  occa::memory mem = device.malloc<int>(10, values);
+  mem.copyTo(b);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(((int*) b)[i], i);
+  }
+
+  // Space is reused once the oldest buffers are released
+  device.releaseStagingBuffer(b);
+  device.releaseStagingBuffer(a);
+  ASSERT_EQ(device.stagingBytesReserved(), (occa::udim_t) 0);
+  ASSERT_EQ((char*) device.reserveStagingBuffer(bytes), a);
+
+  // Buffers which don't fit in the ring still work
+  char *large = (char*) device.reserveStagingBuffer(4 * 1024 * 1024);
+  large[4 * 1024 * 1024 - 1] = 1;
+  device.releaseStagingBuffer(large);
+  device.releaseStagingBuffer(a);
+  ASSERT_EQ(device.stagingBytesReserved(), (occa::udim_t) 0);
+
+  int unreserved;
+  ASSERT_THROW(
+    device.releaseStagingBuffer(&unreserved);
+  );
+}
+
+void testAllocationTracking() {
+  occa::device untracked({
+    {"mode", "Serial"}
+  });
+  ASSERT_FALSE((bool) untracked.allocationSnapshot()["enabled"]);
+
+  occa::device device({
+    {"mode", "Serial"},
+    {"track_allocations", true},
+    {"track_allocation_backtraces", true}
+  });
+
+  occa::memory a = device.malloc<float>(100, occa::json({{"tag", "a"}}));
+  occa::memory b = device.malloc<char>(10);
+
+  occa::experimental::memoryPool pool = device.createMemoryPool({
+    {"tag", "pool"}
+  });
+  occa::memory c = pool.reserve<char>(50);
+
+  occa::json snapshot = device.allocationSnapshot();
+  ASSERT_TRUE((bool) snapshot["enabled"]);
+  ASSERT_EQ((int) snapshot["allocations"], 3);
+  ASSERT_EQ((int) snapshot["bytes"], 460);
+  ASSERT_EQ((int) snapshot["tags/a/bytes"], 400);
+  ASSERT_EQ((int) snapshot["tags/untagged/bytes"], 10);
+  ASSERT_EQ((int) snapshot["tags/pool/bytes"], 50);
+  ASSERT_EQ((int) snapshot["pool_resizes"].size(), 1);
+
+  // Size classes: 16, 64, 512
+  occa::json &sizeClasses = snapshot["size_classes"];
+  ASSERT_EQ(sizeClasses.size(), 3);
+  ASSERT_EQ((int) sizeClasses[0]["max_bytes"], 16);
+  ASSERT_EQ((int) sizeClasses[2]["max_bytes"], 512);
+  ASSERT_EQ((int) sizeClasses[2]["bytes"], 400);
+
+  occa::json &live = snapshot["live"];
+  ASSERT_EQ(live.size(), 3);
+  ASSERT_EQ((std::string) live[0]["tag"], "a");
+  ASSERT_EQ((std::string) live[2]["kind"], "reserve");
+  ASSERT_TRUE(live[0].has("backtrace"));
+
+  a.free();
+  c.free();
+
+  snapshot = device.allocationSnapshot();
+  ASSERT_EQ((int) snapshot["allocations"], 1);
+  ASSERT_EQ((int) snapshot["bytes"], 10);
+  ASSERT_EQ((int) snapshot["peak_bytes"], 460);
+  ASSERT_EQ((int) snapshot["total_allocations"], 3);
+  ASSERT_EQ((int) snapshot["tags/a/peak_bytes"], 400);
+
+  b.free();
+  ASSERT_EQ((int) device.allocationSnapshot()["allocations"], 0);
+}
+
 void testUnwrap() {
   occa::device device({
     {"mode","Serial"}
@@ -133,3 +311,121 @@ void testUnwrap() {
   // Unwrapping a serial mode device is undefined
   ASSERT_THROW(occa::unwrap(device););
 }
+
+void testBuildFusedKernel() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string filename = (
+    occa::env::OCCA_DIR + "tests/files/scaleAxpy.okl"
+  );
+  occa::kernel scale = device.buildKernel(filename, "scale");
+  occa::kernel axpy = device.buildKernel(filename, "axpy");
+
+  occa::json dataflow({
+    {"name", "scaleAxpy"}
+  });
+  dataflow["arguments"].asArray();
+  dataflow["arguments"] += occa::json({{"y", "tmp"}});
+  dataflow["arguments"] += occa::json({{"x", "tmp"}});
+  dataflow["intermediates"].asArray();
+  dataflow["intermediates"] += "tmp";
+
+  occa::kernel scaleAxpy = device.buildFusedKernel({scale, axpy}, dataflow);
+  ASSERT_TRUE(scaleAxpy.isInitialized());
+  ASSERT_EQ(scaleAxpy.name(), "scaleAxpy");
+
+  // y += alpha * (alpha * x)
+  const int entries = 40;
+  const float alpha = 3;
+  float x[entries], y[entries];
+  for (int i = 0; i < entries; ++i) {
+    x[i] = (float) i;
+    y[i] = 1;
+  }
+  occa::memory o_x = device.malloc<float>(entries, x);
+  occa::memory o_y = device.malloc<float>(entries, y);
+
+  scaleAxpy(entries, alpha, o_x, o_y);
+  o_y.copyTo(y);
+  for (int i = 0; i < entries; ++i) {
+    ASSERT_EQ(y[i], 1 + (alpha * alpha * x[i]));
+  }
+
+  // Building it again loads the cached binary
+  const std::string binaryFilename = scaleAxpy.binaryFilename();
+  const auto binaryTime = std::filesystem::last_write_time(binaryFilename);
+
+  occa::kernel cachedScaleAxpy = device.buildFusedKernel({scale, axpy}, dataflow);
+  ASSERT_EQ(cachedScaleAxpy.hash(), scaleAxpy.hash());
+  ASSERT_EQ(cachedScaleAxpy.binaryFilename(), binaryFilename);
+  ASSERT_TRUE(std::filesystem::last_write_time(binaryFilename) == binaryTime);
+
+  // One [arguments] entry per kernel
+  occa::json badDataflow = dataflow;
+  badDataflow["arguments"] += occa::json({{"x", "tmp"}});
+  ASSERT_THROW(
+    device.buildFusedKernel({scale, axpy}, badDataflow);
+  );
+
+  // Sources are parsed together, so their defines have to agree
+  occa::kernel definedAxpy = device.buildKernel(filename, "axpy", {
+    {"defines/SCALE_AXPY", 1}
+  });
+  ASSERT_THROW(
+    device.buildFusedKernel({scale, definedAxpy}, dataflow);
+  );
+
+  // Helpers and macros from each file end up in the same source
+  const std::string loopSource = (
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = b; i < b + 16; ++i; @inner) {\n"
+    "      if (i < N) {\n"
+    "        y[i] = offset(x[i]);\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  const std::string kernelArgs = (
+    "(const int N, @restrict const float *x, @restrict float *y) {\n"
+  );
+  occa::kernel shift = device.buildKernelFromString(
+    "#define FUSED_OFFSET 1\n"
+    "float offset(float value) {\n"
+    "  return value + FUSED_OFFSET;\n"
+    "}\n"
+    "@kernel void shift" + kernelArgs + loopSource,
+    "shift"
+  );
+
+  dataflow["name"] = "scaleShift";
+  occa::kernel scaleShift = device.buildFusedKernel({scale, shift}, dataflow);
+  scaleShift(entries, alpha, o_x, o_y);
+  o_y.copyTo(y);
+  for (int i = 0; i < entries; ++i) {
+    ASSERT_EQ(y[i], 1 + (alpha * x[i]));
+  }
+
+  occa::kernel shiftTwice = device.buildKernelFromString(
+    "#define FUSED_OFFSET 2\n"
+    "#define offset(value) ((value) + FUSED_OFFSET)\n"
+    "@kernel void shiftTwice" + kernelArgs + loopSource,
+    "shiftTwice"
+  );
+  ASSERT_THROW(
+    device.buildFusedKernel({shift, shiftTwice}, dataflow);
+  );
+
+  occa::kernel shiftBack = device.buildKernelFromString(
+    "float offset(float value) {\n"
+    "  return value - 1;\n"
+    "}\n"
+    "@kernel void shiftBack" + kernelArgs + loopSource,
+    "shiftBack"
+  );
+  ASSERT_THROW(
+    device.buildFusedKernel({shift, shiftBack}, dataflow);
+  );
+}
@@ -2,6 +2,7 @@
 
 #include <occa/internal/io.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/core/kernel.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 occa::kernel addVectors;
@@ -14,7 +15,10 @@ void testInfo();
 void testParsingFailure();
 void testCompilingFailure();
 void testArgumentFailure();
+void testTypeValidation();
 void testRun();
+void testSpecialization();
+void testJitSpecialization();
 
 int main(const int argc, const char **argv) {
   addVectors = occa::buildKernel(addVectorsFile,
@@ -25,7 +29,10 @@ int main(const int argc, const char **argv) {
   testParsingFailure();
   testCompilingFailure();
   testArgumentFailure();
+  testTypeValidation();
   testRun();
+  testSpecialization();
+  testJitSpecialization();
 
   return 0;
 }
@@ -148,6 +155,32 @@ void testArgumentFailure() {
   );
 }
 
+void testTypeValidation() {
+  occa::kernel kernel = occa::buildKernelFromString(
+    "@kernel void foo(int N, float *arg) {"
+    "  for (int i = 0; i < N; ++i; @tile(16, @outer, @inner)) {}"
+    "}",
+    "foo"
+  );
+
+  const int N = 10;
+  occa::memory floatArg = occa::malloc<float>(N);
+  occa::memory float2Arg = occa::malloc(N, occa::dtype::float2);
+  occa::memory intArg = occa::malloc<int>(N);
+
+  kernel(N, floatArg);
+  kernel(N, float2Arg);
+
+  // Validated dtypes are cached but others are still checked
+  ASSERT_THROW(
+    kernel(N, intArg);
+  );
+  kernel(N, floatArg);
+  ASSERT_THROW(
+    kernel(N, intArg);
+  );
+}
+
 void testRun() {
   std::string argKernelFile = (
     occa::env::OCCA_DIR + "tests/files/argKernel.okl"
@@ -182,3 +215,164 @@ void testRun() {
     str.c_str()
   );
 }
+
+void testSpecialization() {
+  const std::string sumSource = (
+    "@kernel void sumIndices(const int N, int *result) {\n"
+    "  for (int b = 0; b < 1; ++b; @outer) {\n"
+    "    for (int i = 0; i < 1; ++i; @inner) {\n"
+    "      int total = 0;\n"
+    "      for (int j = 0; j < N; ++j; @unroll) {\n"
+    "        total += j;\n"
+    "      }\n"
+    "      result[0] = total;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  occa::kernel sum4 = occa::buildKernelFromString(
+    sumSource, "sumIndices", {{"okl/specialize/N", 4}}
+  );
+  occa::kernel sum5 = occa::buildKernelFromString(
+    sumSource, "sumIndices", {{"okl/specialize/N", 5}}
+  );
+
+  // Specialized values are part of the kernel hash
+  ASSERT_NEQ(sum4.hash(), sum5.hash());
+
+  int result = 0;
+  occa::memory o_result = occa::malloc<int>(1, &result);
+
+  sum4(4, o_result);
+  o_result.copyTo(&result);
+  ASSERT_EQ(6, result);
+
+  sum5(5, o_result);
+  o_result.copyTo(&result);
+  ASSERT_EQ(10, result);
+}
+
+void testJitSpecialization() {
+  const std::string sumSource = (
+    "@kernel void sumIndices(const int N, int *result) {\n"
+    "  for (int b = 0; b < 1; ++b; @outer) {\n"
+    "    for (int i = 0; i < 1; ++i; @inner) {\n"
+    "      int total = 0;\n"
+    "      for (int j = 0; j < N; ++j) {\n"
+    "        total += j;\n"
+    "      }\n"
+    "      result[0] = total;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  int result = 0;
+  occa::memory o_result = occa::malloc<int>(1, &result);
+
+  // Variants are built at the first launch with new values
+  occa::kernel sumIndices = occa::buildKernelFromString(
+    sumSource,
+    "sumIndices",
+    occa::json::parse("{ specialize_args: ['N'], specialize_async: false }")
+  );
+  occa::modeKernel_t *modeKernel = sumIndices.getModeKernel();
+
+  for (int N = 3; N < 6; ++N) {
+    sumIndices(N, o_result);
+    o_result.copyTo(&result);
+    ASSERT_EQ(N * (N - 1) / 2, result);
+
+    occa::modeKernel_t *variant = modeKernel->specializer.getVariant(*modeKernel);
+    ASSERT_NEQ((occa::modeKernel_t*) NULL, variant);
+    ASSERT_NEQ(modeKernel->hash, variant->hash);
+    ASSERT_EQ(N, variant->properties.get<int>("okl/specialize/N"));
+  }
+
+  // The generic kernel runs until the variant compiles
+  occa::kernel asyncSumIndices = occa::buildKernelFromString(
+    sumSource,
+    "sumIndices",
+    occa::json::parse("{ specialize_args: ['N'] }")
+  );
+  modeKernel = asyncSumIndices.getModeKernel();
+
+  occa::modeKernel_t *variant = NULL;
+  while (!variant) {
+    asyncSumIndices(7, o_result);
+    o_result.copyTo(&result);
+    ASSERT_EQ(21, result);
+
+    variant = modeKernel->specializer.getVariant(*modeKernel);
+  }
+  ASSERT_EQ(7, variant->properties.get<int>("okl/specialize/N"));
+
+  // Launching, building and updating settings on this thread while
+  //   variants compile in the background
+  occa::kernel concurrentSumIndices = occa::buildKernelFromString(
+    sumSource,
+    "sumIndices",
+    occa::json::parse("{ specialize_args: ['N'] }")
+  );
+  modeKernel = concurrentSumIndices.getModeKernel();
+  occa::modeDevice_t *modeDevice = modeKernel->modeDevice;
+
+  concurrentSumIndices(8, o_result);
+  concurrentSumIndices(9, o_result);
+
+  occa::kernel definedSumIndices = occa::buildKernelFromString(
+    sumSource,
+    "sumIndices",
+    {{"defines/CONCURRENT_BUILD", 1}}
+  );
+  definedSumIndices(4, o_result);
+  o_result.copyTo(&result);
+  ASSERT_EQ(6, result);
+
+  occa::modeKernel_t *variants[2] = {NULL, NULL};
+  for (int launches = 0; !variants[0] || !variants[1]; ++launches) {
+    for (int i = 0; i < 2; ++i) {
+      const int N = 8 + i;
+      concurrentSumIndices(N, o_result);
+      o_result.copyTo(&result);
+      ASSERT_EQ(N * (N - 1) / 2, result);
+
+      variants[i] = modeKernel->specializer.getVariant(*modeKernel);
+    }
+
+    occa::settings()["concurrent_launches"] = launches;
+    modeDevice->properties["concurrent_launches"] = launches;
+  }
+  ASSERT_EQ(8, variants[0]->properties.get<int>("okl/specialize/N"));
+  ASSERT_EQ(9, variants[1]->properties.get<int>("okl/specialize/N"));
+
+  occa::settings().remove("concurrent_launches");
+  modeDevice->properties.remove("concurrent_launches");
+
+  // Only const scalars can be specialized
+  occa::kernel badKernel = occa::buildKernelFromString(
+    sumSource,
+    "sumIndices",
+    occa::json::parse("{ specialize_args: ['result'] }")
+  );
+  ASSERT_THROW(
+    badKernel(1, o_result);
+  );
+  // Later launches keep failing instead of using partial argument indices
+  ASSERT_THROW(
+    badKernel(1, o_result);
+  );
+
+  occa::kernel missingArgKernel = occa::buildKernelFromString(
+    sumSource,
+    "sumIndices",
+    occa::json::parse("{ specialize_args: ['N', 'M'] }")
+  );
+  ASSERT_THROW(
+    missingArgKernel(1, o_result);
+  );
+  ASSERT_THROW(
+    missingArgKernel(1, o_result);
+  );
+}
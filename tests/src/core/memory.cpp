@@ -1,14 +1,23 @@
 #include <occa.hpp>
+#include <occa/internal/utils/dtypeConversion.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 void testMalloc();
 void testSlice();
 void testUnwrap();
+void testLayout();
+void testLayoutKernel();
+void testLayoutAlignment();
+void testConvertedCopies();
 
 int main(const int argc, const char **argv) {
   testMalloc();
   testSlice();
   testUnwrap();
+  testLayout();
+  testLayoutKernel();
+  testLayoutAlignment();
+  testConvertedCopies();
 
   return 0;
 }
@@ -154,3 +163,349 @@ void testUnwrap() {
 
   delete[] host_memory;
 }
+
+struct particle_t {
+  float x;
+  int id;
+  double v[3];
+};
+
+const occa::dtype_t& getParticleDtype() {
+  static occa::dtype_t *dtype = NULL;
+  if (!dtype) {
+    dtype = new occa::dtype_t("particle_t");
+    dtype->addField("x", occa::dtype::float_);
+    dtype->addField("id", occa::dtype::int_);
+    dtype->addField("v", occa::dtype::double_, 3);
+    dtype->registerType();
+  }
+  return *dtype;
+}
+
+void setParticle(particle_t &p, const int i) {
+  p.x = 0.5f * i;
+  p.id = i;
+  for (int c = 0; c < 3; ++c) {
+    p.v[c] = (10 * i) + c;
+  }
+}
+
+void assertParticle(const particle_t &p, const int i) {
+  ASSERT_EQ(p.x, 0.5f * i);
+  ASSERT_EQ(p.id, i);
+  for (int c = 0; c < 3; ++c) {
+    ASSERT_EQ(p.v[c], (double) ((10 * i) + c));
+  }
+}
+
+void testLayout() {
+  const occa::dtype_t &particleDtype = getParticleDtype();
+  ASSERT_EQ(particleDtype.bytes(), (int) sizeof(particle_t));
+
+  const int N = 10;
+  particle_t particles[N];
+  particle_t output[N];
+  for (int i = 0; i < N; ++i) {
+    setParticle(particles[i], i);
+  }
+
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  // SoA
+  {
+    occa::memory mem = device.malloc(N, particleDtype, particles, {
+      {"layout", "soa"}
+    });
+    ASSERT_EQ((int) mem.length(), N);
+    ASSERT_EQ((int) mem.size(), N * (int) sizeof(particle_t));
+
+    const char *ptr = (const char*) mem.ptr();
+    const float *x = (const float*) ptr;
+    const int *id = (const int*) (ptr + (N * sizeof(float)));
+    const double *v = (const double*) (ptr + (N * (sizeof(float) + sizeof(int))));
+    for (int i = 0; i < N; ++i) {
+      ASSERT_EQ(x[i], particles[i].x);
+      ASSERT_EQ(id[i], particles[i].id);
+      ASSERT_EQ(v[(3 * i) + 2], particles[i].v[2]);
+    }
+
+    mem.copyTo(output);
+    for (int i = 0; i < N; ++i) {
+      assertParticle(output[i], i);
+    }
+
+    // Partial copies only touch their entries
+    particle_t updated[2];
+    setParticle(updated[0], 40);
+    setParticle(updated[1], 41);
+    mem.copyFrom(updated, 2 * sizeof(particle_t), 4 * sizeof(particle_t));
+
+    mem.copyTo(output);
+    for (int i = 0; i < N; ++i) {
+      assertParticle(output[i], (i == 4 || i == 5) ? (36 + i) : i);
+    }
+
+    mem.copyTo(output, sizeof(particle_t), 5 * sizeof(particle_t));
+    assertParticle(output[0], 41);
+
+    // Entries need to be copied whole
+    ASSERT_THROW(
+      mem.copyTo(output, 4);
+    );
+    ASSERT_THROW(
+      mem.slice(1);
+    );
+  }
+
+  // AoSoA
+  {
+    occa::memory mem = device.malloc(N, particleDtype, particles, {
+      {"layout", "aosoa"},
+      {"layout_width", 4}
+    });
+    ASSERT_EQ((int) mem.length(), N);
+    // The last block is padded
+    ASSERT_EQ((int) mem.size(), 12 * (int) sizeof(particle_t));
+
+    // Entry 5 is the second entry of the second block
+    const char *block = ((const char*) mem.ptr()) + (4 * sizeof(particle_t));
+    ASSERT_EQ(((const float*) block)[1], particles[5].x);
+    ASSERT_EQ(((const int*) (block + (4 * sizeof(float))))[1], particles[5].id);
+
+    particle_t updated[3];
+    setParticle(updated[0], 43);
+    setParticle(updated[1], 44);
+    setParticle(updated[2], 45);
+    mem.copyFrom(updated, 3 * sizeof(particle_t), 3 * sizeof(particle_t));
+
+    mem.copyTo(output);
+    for (int i = 0; i < N; ++i) {
+      assertParticle(output[i], (3 <= i && i < 6) ? (40 + i) : i);
+    }
+
+    // Device copies keep the layout
+    occa::memory clone = mem.clone();
+    ASSERT_EQ(clone.size(), mem.size());
+
+    for (int i = 0; i < N; ++i) {
+      setParticle(output[i], 0);
+    }
+    clone.copyTo(output);
+    for (int i = 0; i < N; ++i) {
+      assertParticle(output[i], (3 <= i && i < 6) ? (40 + i) : i);
+    }
+
+    occa::memory soaMem = device.malloc(N, particleDtype, {
+      {"layout", "soa"}
+    });
+    ASSERT_THROW(
+      soaMem.copyFrom(mem);
+    );
+  }
+
+  ASSERT_THROW(
+    device.malloc<float>(N, {{"layout", "soa"}});
+  );
+  ASSERT_THROW(
+    device.malloc(N, particleDtype, {{"layout", "unknown"}});
+  );
+}
+
+void testLayoutKernel() {
+  const occa::dtype_t &particleDtype = getParticleDtype();
+
+  const int N = 10;
+  particle_t particles[N];
+  for (int i = 0; i < N; ++i) {
+    setParticle(particles[i], i);
+  }
+
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string kernelSource = (
+    "typedef struct {\n"
+    "  float x;\n"
+    "  int id;\n"
+    "  double v[3];\n"
+    "} particle_t;\n"
+    "@kernel void push(const int N, particle_t *particles) {\n"
+    "  for (int i = 0; i < N; ++i; @tile(4, @outer, @inner)) {\n"
+    "    if (i < N) {\n"
+    "      particles_x(i) += particles_v(i, 0);\n"
+    "      particles_id(i) *= 2;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  const char *layouts[3] = {"aos", "soa", "aosoa"};
+  for (const char *layout : layouts) {
+    occa::memory mem = device.malloc(N, particleDtype, particles, {
+      {"layout", layout},
+      {"layout_width", 4}
+    });
+
+    occa::json props;
+    props["defines"] += mem.layoutDefines("particles");
+
+    occa::kernel push = device.buildKernelFromString(kernelSource, "push", props);
+    push(N, mem);
+
+    particle_t output[N];
+    mem.copyTo(output);
+    for (int i = 0; i < N; ++i) {
+      ASSERT_EQ(output[i].x, (float) (particles[i].x + particles[i].v[0]));
+      ASSERT_EQ(output[i].id, 2 * i);
+      ASSERT_EQ(output[i].v[1], particles[i].v[1]);
+    }
+  }
+}
+
+// Packed the same way as its dtype
+#pragma pack(push, 1)
+struct sample_t {
+  float weight;
+  double value;
+};
+#pragma pack(pop)
+
+const occa::dtype_t& getSampleDtype() {
+  static occa::dtype_t *dtype = NULL;
+  if (!dtype) {
+    dtype = new occa::dtype_t("sample_t");
+    dtype->addField("weight", occa::dtype::float_);
+    dtype->addField("value", occa::dtype::double_);
+    dtype->registerType();
+  }
+  return *dtype;
+}
+
+void testLayoutAlignment() {
+  const occa::dtype_t &sampleDtype = getSampleDtype();
+  ASSERT_EQ(sampleDtype.bytes(), (int) sizeof(sample_t));
+
+  // An odd number of entries and block width would leave the doubles
+  //   4-byte aligned if field arrays were packed back to back
+  const int N = 5;
+  sample_t samples[N];
+  sample_t output[N];
+  for (int i = 0; i < N; ++i) {
+    samples[i].weight = (float) i;
+    samples[i].value = 0.25 * i;
+  }
+
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string kernelSource = (
+    "typedef struct {\n"
+    "  float weight;\n"
+    "  double value;\n"
+    "} sample_t;\n"
+    "@kernel void weigh(const int N, const sample_t *input, sample_t *output) {\n"
+    "  for (int i = 0; i < N; ++i; @tile(4, @outer, @inner)) {\n"
+    "    if (i < N) {\n"
+    "      output_value(i) = input_weight(i) * input_value(i);\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  const char *layouts[2] = {"soa", "aosoa"};
+  for (const char *layout : layouts) {
+    const occa::json layoutProps({
+      {"layout", layout},
+      {"layout_width", 3}
+    });
+    occa::memory input = device.malloc(N, sampleDtype, samples, layoutProps);
+    occa::memory weighed = device.malloc(N, sampleDtype, samples, layoutProps);
+
+    // SoA: 5 weights padded to 24 bytes before the values
+    // AoSoA: 3 weights padded to 16 bytes before the values in each 40-byte block
+    const char *ptr = (const char*) input.ptr();
+    const double *values = (const double*) (
+      (std::string(layout) == "soa")
+      ? (ptr + 24)
+      : (ptr + 40 + 16)
+    );
+    ASSERT_EQ(((occa::udim_t) values) % sizeof(double), (occa::udim_t) 0);
+    ASSERT_EQ(values[1], (std::string(layout) == "soa") ? samples[1].value : samples[4].value);
+
+    input.copyTo(output);
+    for (int i = 0; i < N; ++i) {
+      ASSERT_EQ(output[i].weight, samples[i].weight);
+      ASSERT_EQ(output[i].value, samples[i].value);
+    }
+
+    // Const arguments keep their qualifier through the accessors
+    const occa::json inputDefines = input.layoutDefines("input", true);
+    ASSERT_NEQ(inputDefines["input_value(INDEX)"].string().find("const double*"),
+               std::string::npos);
+
+    occa::json props;
+    props["defines"] += inputDefines;
+    props["defines"] += weighed.layoutDefines("output");
+
+    occa::kernel weigh = device.buildKernelFromString(kernelSource, "weigh", props);
+    weigh(N, input, weighed);
+
+    weighed.copyTo(output);
+    for (int i = 0; i < N; ++i) {
+      ASSERT_EQ(output[i].weight, samples[i].weight);
+      ASSERT_EQ(output[i].value, samples[i].weight * samples[i].value);
+    }
+  }
+}
+
+void testConvertedCopies() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const int N = 8;
+  double values[N];
+  for (int i = 0; i < N; ++i) {
+    values[i] = 0.25 * i;
+  }
+
+  occa::memory mem = device.malloc<double>(N, values);
+
+  float floats[N];
+  mem.copyTo(floats, {{"host_dtype", "float"}});
+  for (int i = 0; i < N; ++i) {
+    ASSERT_EQ(floats[i], (float) values[i]);
+  }
+
+  // Offsets and bytes are given in memory bytes
+  uint16_t halfs[2];
+  mem.copyTo(halfs, 2 * sizeof(double), 4 * sizeof(double), {{"host_dtype", "half"}});
+  ASSERT_EQ(halfs[0], occa::floatToHalf(1.0f));
+  ASSERT_EQ(halfs[1], occa::floatToHalf(1.25f));
+
+  mem.copyFrom(halfs, 2 * sizeof(double), 0, {{"host_dtype", "half"}});
+
+  double output[N];
+  mem.copyTo(output);
+  ASSERT_EQ(output[0], 1.0);
+  ASSERT_EQ(output[1], 1.25);
+  ASSERT_EQ(output[2], 0.5);
+
+  // Same dtype copies don't convert
+  mem.copyTo(output, {{"host_dtype", "double"}});
+  ASSERT_EQ(output[7], values[7]);
+
+  ASSERT_THROW(
+    mem.copyTo(floats, {{"host_dtype", "int"}});
+  );
+  ASSERT_THROW(
+    mem.copyTo(floats, 4, 0, {{"host_dtype", "float"}});
+  );
+  ASSERT_THROW(
+    mem.copyTo(floats, {{"host_dtype", "unknown"}});
+  );
+}
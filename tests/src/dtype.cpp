@@ -3,12 +3,14 @@
 
 void testDtype();
 void testCasting();
+void testSignatures();
 void testGet();
 void testJsonMethods();
 
 int main(const int argc, const char **argv) {
   testDtype();
   testCasting();
+  testSignatures();
   testGet();
   testJsonMethods();
 
@@ -115,6 +117,43 @@ void testCasting() {
   );
 }
 
+void testSignatures() {
+  // Same shortest cycle, different number of entries
+  const uint64_t doubleSignature = occa::dtype::double_.signature();
+  const uint64_t double2Signature = occa::dtype::double2.signature();
+  ASSERT_EQ(doubleSignature >> 32, double2Signature >> 32);
+  ASSERT_EQ((int) (doubleSignature & 0xFFFFFFFF), 1);
+  ASSERT_EQ((int) (double2Signature & 0xFFFFFFFF), 2);
+  ASSERT_NEQ(doubleSignature >> 32,
+             occa::dtype::float_.signature() >> 32);
+
+  // Structs with the same flattened fields share signatures
+  occa::dtype_t foo1("foo");
+  foo1.addField("a", occa::dtype::double_)
+    .addField("b", occa::dtype::double_);
+  ASSERT_EQ(foo1.signature(), double2Signature);
+
+  // Adding fields updates the signature
+  foo1.addField("c", occa::dtype::float_);
+  ASSERT_NEQ(foo1.signature() >> 32, doubleSignature >> 32);
+  ASSERT_FALSE(foo1.canBeCastedTo(occa::dtype::double_));
+
+  occa::dtype_t foo2("foo");
+  foo2.addField("a", occa::dtype::int_)
+    .addField("b", occa::dtype::float_);
+  occa::dtype_t foo4("foo4");
+  foo4.addField("a", foo2)
+    .addField("b", foo2);
+  ASSERT_EQ(foo2.signature() >> 32, foo4.signature() >> 32);
+  ASSERT_TRUE(foo4.canBeCastedTo(foo2));
+  ASSERT_FALSE(foo4.canBeCastedTo(occa::dtype::int_));
+
+  ASSERT_TRUE(
+    occa::dtype_t::canBeCasted(occa::dtype::byte.signature(),
+                               foo4.signature())
+  );
+}
+
 void testGet() {
   ASSERT_EQ(occa::dtype::float_,
             occa::dtype::get<float>());
@@ -0,0 +1,96 @@
+#include <occa.hpp>
+#include <occa/experimental.hpp>
+
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+const std::string tiledAddVectorsFile = (
+  occa::env::OCCA_DIR + "tests/files/tiledAddVectors.okl"
+);
+
+void testSizeClass();
+void testTuning();
+
+int main(const int argc, const char **argv) {
+  testSizeClass();
+  testTuning();
+
+  return 0;
+}
+
+void testSizeClass() {
+  ASSERT_EQ(0, occa::kernelTuner::getSizeClass(0));
+  ASSERT_EQ(0, occa::kernelTuner::getSizeClass(1));
+  ASSERT_EQ(1, occa::kernelTuner::getSizeClass(2));
+  ASSERT_EQ(10, occa::kernelTuner::getSizeClass(1000));
+  ASSERT_EQ(10, occa::kernelTuner::getSizeClass(1024));
+  ASSERT_EQ(11, occa::kernelTuner::getSizeClass(1025));
+}
+
+void testTuning() {
+  const int entries = 1000;
+  float a[entries], b[entries], ab[entries];
+  for (int i = 0; i < entries; ++i) {
+    a[i] = (float) i;
+    b[i] = (float) (1 - i);
+    ab[i] = 0;
+  }
+
+  occa::device device = occa::host();
+  occa::memory o_a = device.malloc<float>(entries, a);
+  occa::memory o_b = device.malloc<float>(entries, b);
+  occa::memory o_ab = device.malloc<float>(entries, ab);
+
+  int runs = 0;
+  auto run = [&](occa::kernel kernel) {
+    kernel(entries, o_a, o_b, o_ab);
+    ++runs;
+  };
+
+  occa::kernelTuner tuner(device,
+                          tiledAddVectorsFile,
+                          "tiledAddVectors",
+                          {{"tuner/iterations", 2}});
+  tuner.addCandidates("TILE_SIZE", {8, 32, 128});
+
+  // Start from a clean cache
+  occa::sys::rmrf(tuner.getResultsFilename());
+
+  // Warm-up and timed runs for each candidate
+  occa::json defines = tuner.getDefines(entries, run);
+  ASSERT_EQ(3 * (1 + 2), runs);
+  ASSERT_TRUE(occa::io::isFile(tuner.getResultsFilename()));
+
+  const int tileSize = defines.get<int>("TILE_SIZE");
+  ASSERT_TRUE((tileSize == 8) || (tileSize == 32) || (tileSize == 128));
+
+  occa::kernel tiledAddVectors = tuner.getKernel(entries, run);
+  ASSERT_EQ(3 * (1 + 2), runs);
+
+  o_ab.copyFrom(ab);
+  tiledAddVectors(entries, o_a, o_b, o_ab);
+  o_ab.copyTo(ab);
+  for (int i = 0; i < entries; ++i) {
+    ASSERT_EQ(1.0f, ab[i]);
+  }
+
+  // Results are loaded from the cache by new tuners
+  occa::kernelTuner cachedTuner(device,
+                                tiledAddVectorsFile,
+                                "tiledAddVectors",
+                                {{"tuner/iterations", 2}});
+  cachedTuner.addCandidates("TILE_SIZE", {8, 32, 128});
+
+  runs = 0;
+  ASSERT_EQ(tileSize,
+            cachedTuner.getDefines(entries + 24, run).get<int>("TILE_SIZE"));
+  ASSERT_EQ(0, runs);
+
+  // Other size classes are tuned separately
+  cachedTuner.getDefines(2 * entries, run);
+  ASSERT_EQ(3 * (1 + 2), runs);
+
+  tuner.free();
+  cachedTuner.free();
+}
@@ -35,8 +35,12 @@ void testCacheInfoMethods() {
                 occa::env::OCCA_CACHE_DIR + "foo.okl"
               ));
   ASSERT_TRUE(occa::io::isCached(
-                occa::env::OCCA_CACHE_DIR + "cache/foo.okl"
+                occa::io::cachePath() + "foo.okl"
               ));
+  // Caches from older layouts aren't reused
+  ASSERT_FALSE(occa::io::isCached(
+                 occa::env::OCCA_CACHE_DIR + "cache/foo.okl"
+               ));
 }
 
 void testHashDir() {
@@ -24,8 +24,11 @@ int main(const int argc, const char **argv) {
 }
 
 void testPathMethods() {
-  ASSERT_EQ(occa::io::cachePath(),
+  ASSERT_EQ(occa::io::cacheRootPath(),
             occa::env::OCCA_CACHE_DIR + "cache/");
+  ASSERT_EQ(occa::io::cachePath(),
+            occa::env::OCCA_CACHE_DIR + "cache/v"
+            + std::to_string(occa::io::cacheVersion) + "/");
 
   ASSERT_EQ(occa::io::libraryPath(),
             occa::env::OCCA_CACHE_DIR + "libraries/");
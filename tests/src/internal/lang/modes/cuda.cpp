@@ -27,6 +27,8 @@ void testKernelArgs();
 void testSharedAnnotation();
 void testBarriers();
 void testAtomic();
+void testReduction();
+void testUnroll();
 void testSource();
 
 int main(const int argc, const char **argv) {
@@ -37,6 +39,8 @@ int main(const int argc, const char **argv) {
   testKernelArgs();
   testSharedAnnotation();
   testBarriers();
+  testReduction();
+  testUnroll();
   testSource();
 
   return 0;
@@ -81,6 +85,175 @@ void testAtomic() {
 //---[ Barriers ]-----------------------
 void testBarriers() {
   // Add barriers barrier(CLK_LOCAL_MEM_FENCE)
+
+  const std::string syncthreads = "__syncthreads();";
+
+  // Each thread only reads the entry it wrote
+  parseSource(
+    "@kernel void copy(const int N, const float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s[i] = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = 2 * s[(i)];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(std::string::npos,
+            getPrintedSource().find(syncthreads));
+  ASSERT_EQ(1, (int) parser.removedBarriers.size());
+
+  // Reading another thread's entry needs a barrier
+  parseSource(
+    "@kernel void reverse(const int N, const float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s[i] = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = s[15 - i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS(syncthreads);
+  ASSERT_EQ(0, (int) parser.removedBarriers.size());
+
+  // Loops mapping threads to different entries
+  parseSource(
+    "@kernel void shift(const int N, const float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[17];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s[i] = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 1; i < 17; ++i; @inner) {\n"
+    "      y[b + i - 1] = s[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS(syncthreads);
+
+  // Reads followed by writes from other threads
+  parseSource(
+    "@kernel void swap(const int N, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = s[i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s[15 - i] = 0;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS(syncthreads);
+
+  // Loop-carried dependencies through an enclosing loop
+  parseSource(
+    "@kernel void iterate(const int N, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int it = 0; it < 4; ++it) {\n"
+    "      for (int i = 0; i < 16; ++i; @inner) {\n"
+    "        y[b + i] += s[15 - i];\n"
+    "      }\n"
+    "      for (int i = 0; i < 16; ++i; @inner) {\n"
+    "        s[i] = y[b + i];\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(0, (int) parser.removedBarriers.size());
+
+  // Aliased @shared memory can't be analyzed
+  parseSource(
+    "@kernel void alias(const int N, const float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s[i] = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      float *p = &s[i];\n"
+    "      y[b + i] = p[0];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS(syncthreads);
+
+  // The analysis can be turned off
+  parser.settings["okl/analyze_barriers"] = false;
+  parseSource(
+    "@kernel void copy(const int N, const float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s[i] = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = s[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS(syncthreads);
+  parser.settings["okl/analyze_barriers"] = true;
+}
+//======================================
+
+//---[ @reduction ]---------------------
+void testReduction() {
+  parseInnerReductionSource();
+
+  // Shared-memory tree after the @inner loop
+  ASSERT_SOURCE_CONTAINS("__shared__ float _occa_reduction_total[16];");
+  ASSERT_SOURCE_CONTAINS("int _occa_reduction_count = blockDim.x * blockDim.y * blockDim.z;");
+  ASSERT_SOURCE_CONTAINS("__syncthreads();");
+
+  testBadInnerReductions();
+}
+//======================================
+
+//---[ @unroll ]------------------------
+void testUnroll() {
+  // Specialized loop bounds give a known trip count
+  parser.settings["okl/specialize/M"] = 4;
+  parseSource(
+    "@kernel void foo(const int N, const int M, float *x) {\n"
+    "  for (int b = 0; b < 10; ++b; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      for (int j = 0; j < M; ++j; @unroll) {\n"
+    "        x[i] += j;\n"
+    "      }\n"
+    "      for (int j = 0; j < N; ++j; @unroll) {\n"
+    "        x[i] += j;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("#pragma unroll 4\n");
+  ASSERT_SOURCE_CONTAINS("#pragma unroll\n");
+  ASSERT_SOURCE_CONTAINS("j < 4;");
+
+  parser.settings["okl/specialize"] = occa::json();
 }
 //======================================
 
@@ -27,6 +27,7 @@ void testKernelArgs();
 void testSharedAnnotation();
 void testBarriers();
 void testAtomic();
+void testReduction();
 void testSource();
 
 int main(const int argc, const char **argv) {
@@ -37,6 +38,7 @@ int main(const int argc, const char **argv) {
   testKernelArgs();
   testSharedAnnotation();
   testBarriers();
+  testReduction();
   testSource();
 
   return 0;
@@ -77,6 +79,19 @@ void testBarriers() {
 }
 //======================================
 
+//---[ @reduction ]---------------------
+void testReduction() {
+  parseInnerReductionSource();
+
+  // Shared-memory tree after the @inner loop
+  ASSERT_SOURCE_CONTAINS("group_local_memory_for_overwrite<float[16]>");
+  ASSERT_SOURCE_CONTAINS("int _occa_reduction_count = item_.get_local_range(2) * item_.get_local_range(1) * item_.get_local_range(0);");
+  ASSERT_SOURCE_CONTAINS("item_.barrier(sycl::access::fence_space::local_space);");
+
+  testBadInnerReductions();
+}
+//======================================
+
 void testSource() {
   
   parseAndPrintSource(
@@ -28,6 +28,7 @@ void testKernelArgs();
 void testSharedAnnotation();
 void testAtomic();
 void testBarriers();
+void testReduction();
 void testSource();
 
 int main(const int argc, const char **argv) {
@@ -41,6 +42,7 @@ int main(const int argc, const char **argv) {
   testKernelArgs();
   testSharedAnnotation();
   testBarriers();
+  testReduction();
   testSource();
 
   return 0;
@@ -93,6 +95,34 @@ void testBarriers() {
 }
 //======================================
 
+//---[ @reduction ]---------------------
+void testReduction() {
+  parseInnerReductionSource();
+
+  // Shared-memory tree after the @inner loop
+  ASSERT_SOURCE_CONTAINS("threadgroup float _occa_reduction_total[16];");
+  ASSERT_SOURCE_CONTAINS("int _occa_reduction_count = _occa_threads_per_group.x * _occa_threads_per_group.y * _occa_threads_per_group.z;");
+  ASSERT_SOURCE_CONTAINS("threadgroup_barrier(mem_flags::mem_threadgroup);");
+  ASSERT_SOURCE_CONTAINS("uint3 _occa_threads_per_group [[threads_per_threadgroup]]");
+
+  // Only kernels with reductions read the threadgroup size
+  parseSource(
+    "@kernel void copy(const int N, const float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = x[b + i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(std::string::npos,
+            getPrintedSource().find("_occa_threads_per_group"));
+
+  testBadInnerReductions();
+}
+//======================================
+
 void testSource() {
   // TODO:
   //   @exclusive ->
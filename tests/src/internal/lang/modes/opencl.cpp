@@ -28,6 +28,7 @@ void testKernelArgs();
 void testSharedAnnotation();
 void testAtomic();
 void testBarriers();
+void testReduction();
 void testSource();
 
 int main(const int argc, const char **argv) {
@@ -41,6 +42,7 @@ int main(const int argc, const char **argv) {
   testKernelArgs();
   testSharedAnnotation();
   testBarriers();
+  testReduction();
   testSource();
 
   return 0;
@@ -120,6 +122,19 @@ void testBarriers() {
 }
 //======================================
 
+//---[ @reduction ]---------------------
+void testReduction() {
+  parseInnerReductionSource();
+
+  // Shared-memory tree after the @inner loop
+  ASSERT_SOURCE_CONTAINS("__local float _occa_reduction_total[16];");
+  ASSERT_SOURCE_CONTAINS("int _occa_reduction_count = get_local_size(0) * get_local_size(1) * get_local_size(2);");
+  ASSERT_SOURCE_CONTAINS("barrier(CLK_LOCAL_MEM_FENCE);");
+
+  testBadInnerReductions();
+}
+//======================================
+
 void testSource() {
   // TODO:
   //   @exclusive ->
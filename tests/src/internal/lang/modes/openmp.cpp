@@ -5,6 +5,7 @@
 
 void testPragma();
 void testAtomic();
+void testReduction();
 
 int main(const int argc, const char **argv) {
   parser.settings["okl/validate"] = false;
@@ -12,6 +13,7 @@ int main(const int argc, const char **argv) {
 
   testPragma();
   testAtomic();
+  testReduction();
 
   return 0;
 }
@@ -31,6 +33,26 @@ int main(const int argc, const char **argv) {
               ompPragma.value());                                       \
   } while(0)
 
+#define ASSERT_NO_PRAGMAS()                                             \
+  ASSERT_EQ(0,                                                          \
+            (int) parser.root.children                                  \
+            .flatFilterByStatementType(statementType::pragma)           \
+            .length())
+
+#define ASSERT_SOURCE_CODE_EXISTS(SOURCE)                               \
+  do {                                                                  \
+    statementArray sourceStatements = (                                 \
+      parser.root.children                                              \
+      .flatFilterByStatementType(statementType::sourceCode)             \
+    );                                                                  \
+                                                                        \
+    ASSERT_EQ(1,                                                        \
+              (int) sourceStatements.length());                         \
+                                                                        \
+    ASSERT_EQ(SOURCE,                                                   \
+              sourceStatements[0]->to<sourceCodeStatement>().sourceCode); \
+  } while(0)
+
 //---[ Pragma ]-------------------------
 void testPragma() {
   // @outer -> #pragma omp
@@ -72,5 +94,128 @@ void testAtomic() {
     "}\n"
   );
   ASSERT_PRAGMA_EXISTS("omp critical", 1);
+
+  // Compound updates supported by [omp atomic]
+  parseSource(
+    "int i;\n"
+    "@atomic i *= 2;\n"
+  );
+  ASSERT_PRAGMA_EXISTS("omp atomic", 1);
+
+  parseSource(
+    "int i;\n"
+    "@atomic {\n"
+    "  i |= 2;\n"
+    "}\n"
+  );
+  ASSERT_PRAGMA_EXISTS("omp atomic", 1);
+
+  // Min/max updates -> compare-and-swap loops
+  parseSource(
+    "int i, j;\n"
+    "@atomic i = min(i, j);\n"
+  );
+  ASSERT_NO_PRAGMAS();
+  ASSERT_SOURCE_CODE_EXISTS("occa::atomics::min(&i, j);");
+
+  parseSource(
+    "int i, j;\n"
+    "@atomic i = max(j + 1, i);\n"
+  );
+  ASSERT_NO_PRAGMAS();
+  ASSERT_SOURCE_CODE_EXISTS("occa::atomics::max(&i, j + 1);");
+
+  // Other updates lock the stripe of the updated address
+  parseSource(
+    "int i, j;\n"
+    "@atomic i = (2 * i) + j;\n"
+  );
+  ASSERT_NO_PRAGMAS();
+  ASSERT_SOURCE_CODE_EXISTS("auto *_occa_atomic_ptr = &i;\n"
+                            "occa::atomics::stripeLock _occa_atomic_lock(_occa_atomic_ptr);");
+
+  parseSource(
+    "int i, j;\n"
+    "@atomic i = min(j, 2);\n"
+  );
+  ASSERT_NO_PRAGMAS();
+  ASSERT_SOURCE_CODE_EXISTS("auto *_occa_atomic_ptr = &i;\n"
+                            "occa::atomics::stripeLock _occa_atomic_lock(_occa_atomic_ptr);");
+
+  // The updated address is only evaluated once
+  parseSource(
+    "int a[4], j, k;\n"
+    "@atomic a[++k] = min(j, 2);\n"
+  );
+  ASSERT_NO_PRAGMAS();
+  ASSERT_SOURCE_CODE_EXISTS("auto *_occa_atomic_ptr = &a[++k];\n"
+                            "occa::atomics::stripeLock _occa_atomic_lock(_occa_atomic_ptr);");
+  {
+    const std::string source = parser.toString();
+    ASSERT_EQ(source.find("++k"), source.rfind("++k"));
+    ASSERT_NEQ(source.find("*_occa_atomic_ptr = min(j, 2);"), std::string::npos);
+  }
+}
+//======================================
+
+//---[ @reduction ]---------------------
+void testReduction() {
+  parser.settings["okl/validate"] = true;
+
+  // @outer -> #pragma omp parallel for reduction(...)
+  parseSource(
+    "@kernel void sum(const int N, const float *x, float *result) {\n"
+    "  float total = 0;\n"
+    "  float upper = 0;\n"
+    "  for (int b = 0; b < N; ++b; @outer @reduction(\"+\", total, \"max\", upper)) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      total += x[(16 * b) + i];\n"
+    "      upper = x[(16 * b) + i];\n"
+    "    }\n"
+    "  }\n"
+    "  *result = total + upper;\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_PRAGMA_EXISTS("omp parallel for reduction(+:total) reduction(max:upper)", 1);
+
+  // @inner loops run in one thread, leaving a plain accumulator
+  parseSource(
+    "@kernel void sum(const int N, const float *x, float *result) {\n"
+    "  for (int b = 0; b < N; ++b; @outer) {\n"
+    "    float total = 0;\n"
+    "    for (int i = 0; i < 16; ++i; @inner @reduction(\"+\", total)) {\n"
+    "      total += x[(16 * b) + i];\n"
+    "    }\n"
+    "    result[b] = total;\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_PRAGMA_EXISTS("omp parallel for", 1);
+  ASSERT_EQ(std::string::npos,
+            getPrintedSource().find("_occa_reduction"));
+
+  parseBadSource(
+    "@kernel void sum(const int N, float *result) {\n"
+    "  float total = 0;\n"
+    "  for (int b = 0; b < N; ++b; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      for (int j = 0; j < 4; ++j; @reduction(\"+\", total)) {}\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  parseBadSource(
+    "@kernel void sum(const int N, float *result) {\n"
+    "  float total = 0;\n"
+    "  for (int b = 0; b < N; ++b; @outer @reduction(\"-\", total)) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {}\n"
+    "  }\n"
+    "}\n"
+  );
+
+  parser.settings["okl/validate"] = false;
 }
 //======================================
@@ -7,6 +7,14 @@ void testPreprocessor();
 void testKernel();
 void testExclusives();
 void testAtomic();
+void testReduction();
+void testUnroll();
+void testSpecialization();
+void testInnerLoopFusion();
+void testExclusiveDemotion();
+void testExclusiveSizes();
+void testKernelFusion();
+void testSharedHoisting();
 
 int main(const int argc, const char **argv) {
   parser.settings["serial/include_std"] = false;
@@ -18,6 +26,15 @@ int main(const int argc, const char **argv) {
   // parser.settings["okl/validate"] = true;
   // testExclusives();
 
+  testReduction();
+  testUnroll();
+  testSpecialization();
+  testInnerLoopFusion();
+  testExclusiveDemotion();
+  testExclusiveSizes();
+  testKernelFusion();
+  testSharedHoisting();
+
   return 0;
 }
 
@@ -134,3 +151,627 @@ void testAtomic() {
   // TODO(dmed)
 }
 //======================================
+
+//---[ @reduction ]---------------------
+void testReduction() {
+  // @reduction -> plain accumulator
+  parseSource(
+    "@kernel void sum(const int N, const float *x, float *result) {\n"
+    "  float total = 0;\n"
+    "  for (int b = 0; b < N; ++b; @outer @reduction(\"+\", total)) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      total += x[(16 * b) + i];\n"
+    "    }\n"
+    "  }\n"
+    "  *result = total;\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+
+  const std::string printedSource = getPrintedSource();
+  ASSERT_NEQ(std::string::npos,
+             printedSource.find("total += x[(16 * b) + i];"));
+  ASSERT_EQ(std::string::npos,
+            printedSource.find("_occa_reduction"));
+  ASSERT_EQ(std::string::npos,
+            printedSource.find("#pragma"));
+}
+//======================================
+
+//---[ @unroll ]------------------------
+void testUnroll() {
+  // Known trip count -> full unroll
+  parseSource(
+    "@kernel void foo(float *x) {\n"
+    "  for (int b = 0; b < 10; ++b; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      for (int j = 0; j < 4; ++j; @unroll) {\n"
+    "        x[i] += j;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("#pragma GCC unroll 4\n");
+
+  // Explicit factor
+  parseSource(
+    "@kernel void foo(const int N, float *x) {\n"
+    "  for (int b = 0; b < 10; ++b; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      for (int j = 0; j < N; ++j; @unroll(2)) {\n"
+    "        x[i] += j;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("#pragma GCC unroll 2\n");
+
+  // Unknown trip count -> no pragma
+  parseSource(
+    "@kernel void foo(const int N, float *x) {\n"
+    "  for (int b = 0; b < 10; ++b; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      for (int j = 0; j < N; ++j; @unroll) {\n"
+    "        x[i] += j;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(std::string::npos,
+            getPrintedSource().find("#pragma"));
+
+  parseBadSource(
+    "@kernel void foo(float *x) {\n"
+    "  for (int j = 0; j < 4; ++j; @unroll(0)) {\n"
+    "    x[j] = j;\n"
+    "  }\n"
+    "}\n"
+  );
+
+  parseBadSource(
+    "@kernel void foo(float *x) {\n"
+    "  for (int b = 0; b < 10; ++b; @outer @unroll) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      x[i] = i;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+}
+//======================================
+
+//---[ Specialization ]-----------------
+void testSpecialization() {
+  const std::string kernelSource = (
+    "@kernel void foo(const int N, const float alpha, float *x) {\n"
+    "  for (int b = 0; b < 10; ++b; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      for (int j = 0; j < N; ++j; @unroll) {\n"
+    "        x[i] += alpha * j;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  // Folded arguments give the @unroll loop a known trip count
+  parser.settings["okl/specialize/N"] = 8;
+  parser.settings["okl/specialize/alpha"] = 0.5;
+  parseSource(kernelSource);
+  ASSERT_TRUE(parser.success);
+
+  const std::string printedSource = getPrintedSource();
+  ASSERT_NEQ(std::string::npos,
+             printedSource.find("#pragma GCC unroll 8\n"));
+  ASSERT_NEQ(std::string::npos,
+             printedSource.find("j < 8;"));
+  ASSERT_NEQ(std::string::npos,
+             printedSource.find("x[i] += 5.00000000e-01f * j;"));
+
+  // Booleans specialize bool arguments
+  parser.settings["okl/specialize"] = occa::json();
+  parser.settings["okl/specialize/flip"] = true;
+  parseSource(
+    "@kernel void foo(const bool flip, float *x) {\n"
+    "  for (int b = 0; b < 10; ++b; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      x[i] = flip ? -x[i] : x[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("x[i] = true ? -x[i] : x[i];");
+
+  // Only const scalars can be specialized
+  parser.settings["okl/specialize"] = occa::json();
+  parser.settings["okl/specialize/x"] = 1;
+  parseBadSource(kernelSource);
+
+  parser.settings["okl/specialize"] = occa::json();
+  parser.settings["okl/specialize/N"] = 1.5;
+  parseBadSource(kernelSource);
+
+  parser.settings["okl/specialize"] = occa::json();
+  parser.settings["okl/specialize/N"] = true;
+  parseBadSource(kernelSource);
+
+  parser.settings["okl/specialize"] = occa::json();
+}
+//======================================
+
+//---[ Inner Loop Fusion ]--------------
+void testInnerLoopFusion() {
+  // Threads only read their own @shared and global entries
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s[i] = 2 * x[b + i];\n"
+    "    }\n"
+    "    for (int j = 0; j < 16; ++j; @inner) {\n"
+    "      y[b + j] = s[j] + x[b + j];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  {
+    const std::string printedSource = getPrintedSource();
+    ASSERT_EQ(std::string::npos,
+              printedSource.find("for (int j"));
+    ASSERT_NEQ(std::string::npos,
+               printedSource.find("y[b + i] = s[i] + x[b + i];"));
+  }
+
+  // Distinct pointers could be slices of the same memory
+  parseSource(
+    "@kernel void foo(const int N, float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      x[b + i] = 2 * x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] += x[b + i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("y[b + i] += x[b + i];\n    }\n");
+
+  // Reading other threads' entries needs the first loop to finish
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s[i] = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = s[15 - i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("y[b + i] = s[15 - i];\n    }\n");
+
+  // Different iteration spaces
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 8; ++i; @inner) {\n"
+    "      y[b + i] += x[b + i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("for (int i = 0; i < 8; ++i)");
+
+  // Shared scalars written by one loop
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    float total = 0;\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      total += x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = total;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("y[b + i] = total;\n    }\n");
+
+  // Renaming the iterator can't clash with other variables
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = x[b + i];\n"
+    "    }\n"
+    "    for (int j = 0; j < 16; ++j; @inner) {\n"
+    "      const int i = 15 - j;\n"
+    "      y[b + j] += i;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("for (int j = 0; j < 16; ++j)");
+
+  parser.settings["serial/fuse_inner_loops"] = false;
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = x[b + i];\n"
+    "    }\n"
+    "    for (int j = 0; j < 16; ++j; @inner) {\n"
+    "      y[b + j] += x[b + j];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("for (int j = 0; j < 16; ++j)");
+  parser.settings["serial/fuse_inner_loops"] = true;
+}
+//======================================
+
+//---[ @exclusive Demotion ]------------
+void testExclusiveDemotion() {
+  // Fused loops leave the @exclusive value in a single loop
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @exclusive float value = 0;\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      value += x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = value;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  {
+    const std::string printedSource = getPrintedSource();
+    ASSERT_NEQ(std::string::npos,
+               printedSource.find("for (int i = 0; i < 16; ++i) {\n      float value = 0;"));
+    ASSERT_EQ(std::string::npos,
+              printedSource.find("_occa_exclusive_index"));
+  }
+
+  // Values kept across loops stay per-thread arrays
+  parseSource(
+    "@kernel void foo(const int N, const float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    @exclusive float value;\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      value = x[b + i];\n"
+    "      s[i] = value;\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      y[b + i] = value + s[15 - i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("float value[16];");
+  ASSERT_SOURCE_CONTAINS("value[_occa_exclusive_index]");
+
+  // Values persisting across iterations of regular loops stay per-thread arrays
+  parseSource(
+    "@kernel void foo(const int N, const float *x, float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @exclusive float value = 0;\n"
+    "    for (int it = 0; it < 4; ++it) {\n"
+    "      for (int i = 0; i < 16; ++i; @inner) {\n"
+    "        value += x[b + i];\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("value[_occa_exclusive_index]");
+}
+//======================================
+
+//---[ @exclusive Sizes ]---------------
+void testExclusiveSizes() {
+  parser.settings["serial/demote_exclusives"] = false;
+
+  // Sized for the largest @inner loop nest
+  parseSource(
+    "@kernel void foo(const int N, float *x) {\n"
+    "  for (int b = 0; b < N; b += 32; @outer) {\n"
+    "    @exclusive float value;\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      value = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 32; ++i; @inner) {\n"
+    "      x[b + i] = value;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("float value[32];");
+
+  // Runtime sizes from const kernel arguments use per-thread storage
+  parseSource(
+    "@kernel void foo(const int N, const int B, float *x) {\n"
+    "  for (int b = 0; b < N; b += B; @outer) {\n"
+    "    @exclusive float value;\n"
+    "    for (int i = 0; i < B; ++i; @inner) {\n"
+    "      value = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < B; ++i; @inner) {\n"
+    "      x[b + i] = value;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("static thread_local std::vector<float> _occa_exclusive_value;");
+  ASSERT_SOURCE_CONTAINS("_occa_exclusive_value.resize((B - 0));");
+  ASSERT_SOURCE_CONTAINS("float * value = _occa_exclusive_value.data();");
+  ASSERT_SOURCE_CONTAINS("value[_occa_exclusive_index]");
+
+  // Arguments that could change fall back to @max_inner_dims
+  parseSource(
+    "@kernel void foo(const int N, int B, float *x) {\n"
+    "  for (int b = 0; b < N; b += B; @outer @max_inner_dims(64)) {\n"
+    "    @exclusive float value;\n"
+    "    for (int i = 0; i < B; ++i; @inner) {\n"
+    "      value = x[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < B; ++i; @inner) {\n"
+    "      x[b + i] = value;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("float value[64];");
+
+  parser.settings["serial/demote_exclusives"] = true;
+}
+//======================================
+
+//---[ Kernel Fusion ]------------------
+void testKernelFusion() {
+  const std::string kernelSource = (
+    "@kernel void scale(const int N, const float alpha, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = b; i < b + 16; ++i; @inner) {\n"
+    "      if (i < N) {\n"
+    "        y[i] = alpha * x[i];\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "@kernel void axpy(const int N, const float alpha, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b2 = 0; b2 < N; b2 += 16; @outer) {\n"
+    "    for (int i2 = b2; i2 < b2 + 16; ++i2; @inner) {\n"
+    "      if (i2 < N) {\n"
+    "        y[i2] += alpha * x[i2];\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "@kernel void scale32(const int N, const float alpha, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 32; @outer) {\n"
+    "    for (int i = b; i < b + 32; ++i; @inner) {\n"
+    "      y[i] = alpha * x[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  occa::json fusion = occa::json::parse(
+    "{"
+    "  name: 'scaleAxpy',"
+    "  stages: ["
+    "    { kernel: 'scale', arguments: { alpha: 'a', y: 'tmp' } },"
+    "    { kernel: 'axpy', arguments: { alpha: 'c', x: 'tmp' } },"
+    "  ],"
+    "  intermediates: ['tmp'],"
+    "}"
+  );
+
+  // Intermediates are kept in a value per thread
+  parser.settings["okl/fusion"] = fusion;
+  parseSource(kernelSource);
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("extern \"C\" void scaleAxpy(const int & N,");
+  ASSERT_SOURCE_CONTAINS("float _occa_fused_tmp;");
+  ASSERT_SOURCE_CONTAINS("_occa_fused_tmp = a * x[i];");
+  ASSERT_SOURCE_CONTAINS("y[i] += c * _occa_fused_tmp;");
+
+  // Renamed arguments can't clash with variables in the kernels
+  fusion["stages"][1]["arguments"]["alpha"] = "b";
+  parser.settings["okl/fusion"] = fusion;
+  parseBadSource(kernelSource);
+
+  // Loops need to match
+  fusion["stages"][1]["arguments"]["alpha"] = "c";
+  fusion["stages"][1]["kernel"] = "scale32";
+  parser.settings["okl/fusion"] = fusion;
+  parseBadSource(kernelSource);
+
+  // Stages can't read entries other threads wrote in earlier stages
+  const std::string shiftSource = (
+    "@kernel void scale(const int N, @restrict float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = b; i < b + 16; ++i; @inner) {\n"
+    "      y[i] = 2 * x[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "@kernel void shift(const int N, @restrict float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = b; i < b + 16; ++i; @inner) {\n"
+    "      x[i] = y[i + 1];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "@kernel void square(const int N, @restrict float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = b; i < b + 16; ++i; @inner) {\n"
+    "      x[i] = y[i] * y[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  occa::json shiftFusion = occa::json::parse(
+    "{"
+    "  name: 'scaleShift',"
+    "  stages: [{ kernel: 'scale' }, { kernel: 'shift' }],"
+    "}"
+  );
+  parser.settings["okl/fusion"] = shiftFusion;
+  parseBadSource(shiftSource);
+
+  // Reading the entry written by the same thread is fine
+  shiftFusion["stages"][1]["kernel"] = "square";
+  parser.settings["okl/fusion"] = shiftFusion;
+  parseSource(shiftSource);
+  ASSERT_TRUE(parser.success);
+  ASSERT_SOURCE_CONTAINS("x[i] = y[i] * y[i];");
+
+  // Locals with the same name in each stage can hold different offsets
+  const std::string localIndexSource = (
+    "@kernel void produce(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = b; i < b + 16; ++i; @inner) {\n"
+    "      const int k = 0;\n"
+    "      y[i + k] = 2 * x[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "@kernel void consume(const int N, @restrict const float *x, @restrict float *y) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    for (int i = b; i < b + 16; ++i; @inner) {\n"
+    "      const int k = 1;\n"
+    "      y[i] = x[i + k];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  const occa::json localIndexFusion = occa::json::parse(
+    "{"
+    "  name: 'produceConsume',"
+    "  stages: ["
+    "    { kernel: 'produce', arguments: { y: 'tmp' } },"
+    "    { kernel: 'consume', arguments: { x: 'tmp' } },"
+    "  ],"
+    "  intermediates: ['tmp'],"
+    "}"
+  );
+  parser.settings["okl/fusion"] = localIndexFusion;
+  parseBadSource(localIndexSource);
+
+  // Intermediates need to be arguments
+  fusion["stages"][1]["kernel"] = "axpy";
+  fusion["intermediates"] += "z";
+  parser.settings["okl/fusion"] = fusion;
+  parseBadSource(kernelSource);
+
+  parser.settings["okl/fusion"] = occa::json();
+}
+//======================================
+
+//---[ @shared Hoisting ]---------------
+void testSharedHoisting() {
+  const std::string kernelSource = (
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s_w[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s_w[i] = 2 * w[i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      x[b + i] *= s_w[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  // Tables filled from read-only arguments are filled once before the @outer loop
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *w, float *x) {\n"
+    + kernelSource
+  );
+  ASSERT_TRUE(parser.success);
+
+  std::string printedSource = getPrintedSource();
+  const size_t fillIndex = printedSource.find("if (0 < N) {");
+  ASSERT_NEQ(std::string::npos, fillIndex);
+  ASSERT_LT(printedSource.find("float s_w[16];"), fillIndex);
+  ASSERT_LT(fillIndex, printedSource.find("for (int b = 0; b < N; b += 16) {"));
+
+  // [w] could alias [x] without @restrict
+  parseSource(
+    "@kernel void foo(const int N, const float *w, float *x) {\n"
+    + kernelSource
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(std::string::npos,
+            getPrintedSource().find("if (0 < N) {"));
+
+  // Values depending on the @outer loop change every iteration
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *w, float *x) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s_w[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s_w[i] = w[b + i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      x[b + i] *= s_w[i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(std::string::npos,
+            getPrintedSource().find("if (0 < N) {"));
+
+  // Tables updated later on can't be shared across @outer iterations
+  parseSource(
+    "@kernel void foo(const int N, @restrict const float *w, float *x) {\n"
+    "  for (int b = 0; b < N; b += 16; @outer) {\n"
+    "    @shared float s_w[16];\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s_w[i] = w[i];\n"
+    "    }\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {\n"
+    "      s_w[i] += x[b + i];\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(std::string::npos,
+            getPrintedSource().find("if (0 < N) {"));
+}
+//======================================
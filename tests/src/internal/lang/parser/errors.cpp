@@ -62,6 +62,8 @@ void testNamespaceErrors() {
 
 void testFunctionErrors() {
   parseBadSource("int foo()");
+  parseBadSource("int foo() {}\n"
+                 "int foo() {}");
 }
 
 void testStructErrors() {
@@ -0,0 +1,92 @@
+#include <occa/internal/lang/modes/serial.hpp>
+#include <occa/internal/lang/parserPool.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+using namespace occa::lang;
+
+void testReuse();
+void testSettings();
+
+const std::string source = (
+  "@kernel void foo(@restrict float *a) {\n"
+  "  for (int i = 0; i < N; ++i; @tile(16, @outer, @inner)) {\n"
+  "    a[i] = VALUE;\n"
+  "  }\n"
+  "}\n"
+);
+
+occa::json getSettings(const std::string &restrictStr,
+                       const int value) {
+  occa::json settings;
+  settings["serial/include_std"] = false;
+  settings["okl/restrict"] = restrictStr;
+  settings["defines/N"] = 64;
+  settings["defines/VALUE"] = value;
+  return settings;
+}
+
+int main(const int argc, const char **argv) {
+  testReuse();
+  testSettings();
+
+  return 0;
+}
+
+void testReuse() {
+  parserPool_t<okl::serialParser> pool;
+  ASSERT_EQ(pool.idleCount(), 0);
+
+  okl::serialParser *first = pool.acquire(getSettings("__restrict__", 1));
+  okl::serialParser *second = pool.acquire(getSettings("__restrict__", 1));
+  ASSERT_NEQ(first, second);
+
+  pool.release(first);
+  pool.release(second);
+  ASSERT_EQ(pool.idleCount(), 2);
+
+  {
+    pooledParser_t<okl::serialParser> parser(pool, getSettings("__restrict__", 1));
+    ASSERT_EQ(pool.idleCount(), 1);
+    ASSERT_EQ(&(*parser), second);
+
+    parser->parseSource(source);
+    ASSERT_TRUE(parser->succeeded());
+    ASSERT_NEQ(second->root.size(), 0);
+  }
+  ASSERT_EQ(pool.idleCount(), 2);
+
+  // Idle parsers don't hold on to the last AST
+  ASSERT_EQ(second->root.size(), 0);
+}
+
+void testSettings() {
+  parserPool_t<okl::serialParser> pool;
+
+  // Reused parsers pick up the new settings
+  std::string restrictOutput, disabledOutput;
+  {
+    pooledParser_t<okl::serialParser> parser(pool, getSettings("__restrict__", 1));
+    parser->parseSource(source);
+    ASSERT_TRUE(parser->succeeded());
+    restrictOutput = parser->toString();
+  }
+  {
+    pooledParser_t<okl::serialParser> parser(pool, getSettings("disabled", 2));
+    parser->parseSource(source);
+    ASSERT_TRUE(parser->succeeded());
+    disabledOutput = parser->toString();
+  }
+  ASSERT_EQ(pool.idleCount(), 1);
+
+  ASSERT_NEQ(restrictOutput.find("__restrict__"), std::string::npos);
+  ASSERT_NEQ(restrictOutput.find("= 1;"), std::string::npos);
+
+  ASSERT_EQ(disabledOutput.find("__restrict__"), std::string::npos);
+  ASSERT_NEQ(disabledOutput.find("= 2;"), std::string::npos);
+
+  // Swapping back restores the @restrict qualifier
+  pooledParser_t<okl::serialParser> parser(pool, getSettings("__restrict__", 1));
+  parser->parseSource(source);
+  ASSERT_TRUE(parser->succeeded());
+  ASSERT_EQ(parser->toString(), restrictOutput);
+}
@@ -1,6 +1,8 @@
 #ifndef OCCA_TESTS_PARSER_PARSERUTILS_HEADER
 #define OCCA_TESTS_PARSER_PARSERUTILS_HEADER
 
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/env.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 #include <occa/internal/lang/expr.hpp>
@@ -42,12 +44,59 @@ void parseSource(const std::string &s) {
   parseSource(str_);                            \
   ASSERT_FALSE(parser.success);
 
+std::string getPrintedSource() {
+  printer pout;
+  parser.root.print(pout);
+  return pout.str();
+}
+
+#define ASSERT_SOURCE_CONTAINS(str_)                                    \
+  ASSERT_NEQ(std::string::npos,                                         \
+             getPrintedSource().find(str_))
+
 template <class smntType>
 smntType& getStatement(const int index = 0) {
   return parser.root[index]->to<smntType>();
 }
 //======================================
 
+//---[ @reduction ]---------------------
+// GPU modes lower @inner reductions the same way, only the printed
+//   tree differs between them
+void parseInnerReductionSource() {
+  parseSource(
+    occa::io::read(occa::env::OCCA_DIR + "tests/files/innerReduction.okl")
+  );
+  ASSERT_TRUE(parser.success);
+
+  ASSERT_SOURCE_CONTAINS("if ((_occa_reduction_thread + 8) < _occa_reduction_count)");
+  ASSERT_SOURCE_CONTAINS("total = _occa_reduction_total[0];");
+  ASSERT_SOURCE_CONTAINS("upper = _occa_reduction_upper[0];");
+}
+
+void testBadInnerReductions() {
+  // Only @inner loops are reduced in GPU modes
+  parseBadSource(
+    "@kernel void sum(const int N, float *result) {\n"
+    "  float total = 0;\n"
+    "  for (int b = 0; b < N; ++b; @outer @reduction(\"+\", total)) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner) {}\n"
+    "  }\n"
+    "}\n"
+  );
+
+  // Reduction variables are per-thread values declared inside @outer loops
+  parseBadSource(
+    "@kernel void sum(const int N, float *result) {\n"
+    "  float total = 0;\n"
+    "  for (int b = 0; b < N; ++b; @outer) {\n"
+    "    for (int i = 0; i < 16; ++i; @inner @reduction(\"+\", total)) {}\n"
+    "  }\n"
+    "}\n"
+  );
+}
+//======================================
+
 //---[ Macro Util Methods ]-------------
 #define testStatementPeek(str_, type_)          \
   setSource(str_);                              \
@@ -3,6 +3,7 @@
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/utils/testing.hpp>
 
+#include <occa/internal/lang/headerCache.hpp>
 #include <occa/internal/lang/tokenizer.hpp>
 #include <occa/internal/lang/processingStages.hpp>
 #include <occa/internal/lang/preprocessor.hpp>
@@ -190,6 +191,16 @@ void testMacroDefines() {
   ASSERT_EQ("hi_1_2",
             identifier);
 
+  // Test function-like defines passed through settings
+  setStream(
+    "SQUARE(x)\n"
+  );
+  preprocessor_t &sourcePp = *((preprocessor_t*) tokenStream.getInput("preprocessor_t"));
+  sourcePp.addSourceDefine("SQUARE(X)", "X ## _squared");
+  getToken();
+  ASSERT_EQ("x_squared",
+            identifier);
+
 #undef identifier
 }
 
@@ -668,6 +679,16 @@ void testInclude() {
   preprocessor_t &pp = *((preprocessor_t*) tokenStream.getInput("preprocessor_t"));
   ASSERT_EQ(1,
             (int) pp.dependencies.size());
+
+  // Includes after the first one replay the cached tokens
+  cachedHeaderPtr header = headerCache.get(testFile);
+  ASSERT_TRUE(header->canReplay);
+  ASSERT_EQ(header, headerCache.get(testFile));
+
+  // Headers with nested includes are lexed every time
+  const std::string nestedFile = (occa::env::OCCA_DIR
+                                  + "tests/files/addVectors.okl");
+  ASSERT_FALSE(headerCache.get(nestedFile)->canReplay);
 }
 
 void testIncludeStandardHeader() {
@@ -2,12 +2,14 @@
 
 void testPeekMethods();
 void testTokenMethods();
+void testOperatorMatcher();
 
 using namespace occa::lang;
 
 int main(const int argc, const char **argv) {
   testPeekMethods();
   testTokenMethods();
+  testOperatorMatcher();
 
   return 0;
 }
@@ -232,3 +234,40 @@ void testTokenMethods() {
   testCharToken("U'\\''" , encodingType::U);
   testCharToken("L'\\''" , encodingType::L);
 }
+
+void testOperatorMatcher() {
+  operatorTrie operators;
+  getOperators(operators);
+  operators.freeze();
+
+  operatorMatcher_t matcher;
+  matcher.setup(operators);
+
+  // The matcher should always agree with the trie
+  const char *sources[] = {
+    "+", "++", "+=", "+++", "<<=", "<<<", ">>>", "->*", "...", "..",
+    "::", "sizeof", "sizeofx", "new", "delete", "throw", "@", "a",
+    "/*", "//", "#", "##", "#define", "", NULL
+  };
+  for (int i = 0; sources[i]; ++i) {
+    const char *str = sources[i];
+    operatorTrie::result_t expected = operators.getLongest(str);
+    operatorTrie::result_t result = matcher.getLongest(str);
+
+    ASSERT_EQ(expected.success(), result.success());
+    if (expected.success()) {
+      ASSERT_EQ(expected.length, result.length);
+      ASSERT_EQ(expected.value(), result.value());
+    }
+    ASSERT_EQ(operators.has(str), matcher.has(str));
+  }
+
+  // Every operator matches itself
+  const int operatorCount = (int) operators.values.size();
+  for (int i = 0; i < operatorCount; ++i) {
+    const std::string &str = operators.values[i]->str;
+    ASSERT_TRUE(matcher.has(str));
+    ASSERT_EQ(operators.get(str.c_str()).value(),
+              matcher.getLongest(str.c_str()).value());
+  }
+}
@@ -169,4 +169,16 @@ void testComparision() {
 
   qType2 += const_;
   ASSERT_TRUE(qType1 == qType2);
+
+  // Test pointers
+  vartype_t floatPointer(float_);
+  floatPointer += pointer_t();
+  vartype_t floatPointer2(float_);
+  floatPointer2 += pointer_t();
+  ASSERT_TRUE(floatPointer == floatPointer2);
+  ASSERT_TRUE(floatPointer != fakeFloat);
+  ASSERT_TRUE(fakeFloat != floatPointer);
+
+  floatPointer2 += pointer_t();
+  ASSERT_TRUE(floatPointer != floatPointer2);
 }
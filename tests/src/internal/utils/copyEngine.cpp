@@ -0,0 +1,136 @@
+#include <vector>
+
+#include <occa/internal/utils/copyEngine.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+using occa::copyEngine_t;
+
+void testCopyBytes();
+void testParallelCopy();
+void testAsyncCopy();
+void testConvert();
+
+int main(const int argc, const char **argv) {
+  testCopyBytes();
+  testParallelCopy();
+  testAsyncCopy();
+  testConvert();
+
+  return 0;
+}
+
+std::vector<char> getData(const occa::udim_t bytes, const int seed) {
+  std::vector<char> data(bytes);
+  for (occa::udim_t i = 0; i < bytes; ++i) {
+    data[i] = (char) ((i * 31) + seed);
+  }
+  return data;
+}
+
+void testCopyBytes() {
+  const std::vector<char> src = getData(1000, 1);
+
+  // Test unaligned heads and tails with streaming stores
+  for (int offset = 0; offset < 20; ++offset) {
+    for (const bool nonTemporal : {false, true}) {
+      std::vector<char> dest(1000, 0);
+      const occa::udim_t bytes = 1000 - (2 * offset);
+      copyEngine_t::copyBytes(&dest[offset], &src[offset], bytes, nonTemporal);
+
+      for (int i = 0; i < 1000; ++i) {
+        const bool copied = ((offset <= i) && (i < (1000 - offset)));
+        ASSERT_EQ(copied ? src[i] : (char) 0, dest[i]);
+      }
+    }
+  }
+}
+
+void testParallelCopy() {
+  copyEngine_t engine(4);
+  ASSERT_EQ(4, engine.getThreads());
+
+  // Large enough to be split and not a multiple of the chunk size
+  const occa::udim_t bytes = (
+    copyEngine_t::nonTemporalBytes + 12345
+  );
+  const std::vector<char> src = getData(bytes, 2);
+  std::vector<char> dest(bytes, 0);
+
+  engine.copy(&dest[0], &src[0], bytes);
+  ASSERT_TRUE(engine.isFinished());
+  ASSERT_TRUE(src == dest);
+
+  // Small copies are done in place
+  std::vector<char> smallDest(100, 0);
+  engine.copy(&smallDest[0], &src[0], 100);
+  ASSERT_EQ(src[99], smallDest[99]);
+
+  engine.setThreads(1);
+  ASSERT_EQ(1, engine.getThreads());
+
+  std::vector<char> dest2(bytes, 0);
+  engine.copy(&dest2[0], &src[0], bytes);
+  ASSERT_TRUE(src == dest2);
+}
+
+void testAsyncCopy() {
+  copyEngine_t engine(3);
+
+  const occa::udim_t bytes = 3 * copyEngine_t::parallelBytes;
+  const std::vector<char> src = getData(bytes, 3);
+  std::vector<char> a(bytes, 0);
+  std::vector<char> b(bytes, 0);
+
+  // Copies are done in order: src -> a -> b
+  engine.copy(&a[0], &src[0], bytes, true);
+  engine.copy(&b[0], &a[0], bytes, true);
+  engine.finish();
+  ASSERT_TRUE(engine.isFinished());
+  ASSERT_TRUE(src == a);
+  ASSERT_TRUE(src == b);
+
+  // Sync copies wait for async ones
+  std::vector<char> c(bytes, 0);
+  std::vector<char> d(10, 0);
+  engine.copy(&c[0], &src[0], bytes, true);
+  engine.copy(&d[0], &c[bytes - 10], 10);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(src[bytes - 10 + i], d[i]);
+  }
+
+  // Pending copies are finished on destruction
+  {
+    copyEngine_t tempEngine(2);
+    std::vector<char> e(bytes, 0);
+    tempEngine.copy(&e[0], &src[0], bytes, true);
+    tempEngine.setThreads(2);
+    ASSERT_TRUE(src == e);
+  }
+}
+
+void testConvert() {
+  copyEngine_t engine(3);
+
+  // Enough values to be split into chunks
+  const occa::udim_t entries = copyEngine_t::parallelBytes;
+  std::vector<double> src(entries);
+  for (occa::udim_t i = 0; i < entries; ++i) {
+    src[i] = 0.5 * (double) (i % 1000);
+  }
+
+  std::vector<float> dest(entries, 0);
+  engine.convert(&dest[0], &src[0], entries,
+                 sizeof(float), sizeof(double),
+                 occa::getDtypeConversion(occa::dtype::float_, occa::dtype::double_));
+  for (occa::udim_t i = 0; i < entries; ++i) {
+    ASSERT_EQ(dest[i], (float) src[i]);
+  }
+
+  std::vector<double> roundTrip(entries, 0);
+  engine.convert(&roundTrip[0], &dest[0], entries,
+                 sizeof(double), sizeof(float),
+                 occa::getDtypeConversion(occa::dtype::double_, occa::dtype::float_),
+                 true);
+  engine.finish();
+  ASSERT_TRUE(src == roundTrip);
+}
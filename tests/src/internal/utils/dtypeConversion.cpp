@@ -0,0 +1,91 @@
+#include <cmath>
+#include <limits>
+
+#include <occa/internal/utils/dtypeConversion.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+void testHalf();
+void testConversions();
+
+int main(const int argc, const char **argv) {
+  testHalf();
+  testConversions();
+
+  return 0;
+}
+
+void testHalf() {
+  ASSERT_EQ(occa::floatToHalf(0.0f), (uint16_t) 0x0000);
+  ASSERT_EQ(occa::floatToHalf(-0.0f), (uint16_t) 0x8000);
+  ASSERT_EQ(occa::floatToHalf(1.0f), (uint16_t) 0x3C00);
+  ASSERT_EQ(occa::floatToHalf(-2.0f), (uint16_t) 0xC000);
+  ASSERT_EQ(occa::floatToHalf(65504.0f), (uint16_t) 0x7BFF);
+
+  // Rounding
+  ASSERT_EQ(occa::floatToHalf(65519.0f), (uint16_t) 0x7BFF);
+  ASSERT_EQ(occa::floatToHalf(65520.0f), (uint16_t) 0x7C00);
+  ASSERT_EQ(occa::floatToHalf(1.0f + std::ldexp(1.0f, -11)), (uint16_t) 0x3C00);
+  ASSERT_EQ(occa::floatToHalf(1.0f + std::ldexp(3.0f, -11)), (uint16_t) 0x3C02);
+
+  // Subnormals
+  ASSERT_EQ(occa::floatToHalf(std::ldexp(1.0f, -24)), (uint16_t) 0x0001);
+  ASSERT_EQ(occa::floatToHalf(std::ldexp(1.0f, -25)), (uint16_t) 0x0000);
+  ASSERT_EQ(occa::floatToHalf(std::ldexp(3.0f, -25)), (uint16_t) 0x0002);
+
+  // Inf and NaN
+  ASSERT_EQ(occa::floatToHalf(std::numeric_limits<float>::infinity()), (uint16_t) 0x7C00);
+  ASSERT_EQ(occa::floatToHalf(-std::numeric_limits<float>::infinity()), (uint16_t) 0xFC00);
+  ASSERT_TRUE(std::isnan(
+    occa::halfToFloat(occa::floatToHalf(std::numeric_limits<float>::quiet_NaN()))
+  ));
+
+  // Every non-NaN half survives a round trip
+  for (int i = 0; i < (1 << 16); ++i) {
+    const uint16_t value = (uint16_t) i;
+    const float f = occa::halfToFloat(value);
+    if (std::isnan(f)) {
+      ASSERT_EQ(value & 0x7C00, 0x7C00);
+      continue;
+    }
+    ASSERT_EQ(occa::floatToHalf(f), value);
+    ASSERT_EQ(occa::doubleToHalf((double) f), value);
+  }
+
+  // Doubles round once, going through float would round down to 0x3C00
+  ASSERT_EQ(occa::doubleToHalf(1.0 + std::ldexp(1.0, -11) + std::ldexp(1.0, -40)),
+            (uint16_t) 0x3C01);
+  ASSERT_EQ(occa::doubleToHalf(1.0 + std::ldexp(1.0, -11)), (uint16_t) 0x3C00);
+  ASSERT_EQ(occa::doubleToHalf(65520.0), (uint16_t) 0x7C00);
+  ASSERT_EQ(occa::doubleToHalf(-65519.0), (uint16_t) 0xFBFF);
+  ASSERT_EQ(occa::doubleToHalf(std::ldexp(1.0, -25) + std::ldexp(1.0, -60)),
+            (uint16_t) 0x0001);
+  ASSERT_EQ(occa::doubleToHalf(std::ldexp(3.0, -25)), (uint16_t) 0x0002);
+  ASSERT_EQ(occa::doubleToHalf(1e-30), (uint16_t) 0x0000);
+  ASSERT_EQ(occa::doubleToHalf(-std::numeric_limits<double>::infinity()),
+            (uint16_t) 0xFC00);
+  ASSERT_TRUE(std::isnan(
+    occa::halfToFloat(occa::doubleToHalf(std::numeric_limits<double>::quiet_NaN()))
+  ));
+}
+
+void testConversions() {
+  ASSERT_TRUE(
+    occa::getDtypeConversion(occa::dtype::int_, occa::dtype::float_) == NULL
+  );
+  ASSERT_TRUE(
+    occa::getDtypeConversion(occa::dtype::float_, occa::dtype::byte) == NULL
+  );
+
+  const double src[4] = {1.5, -2.25, 1e-3, 3e5};
+  uint16_t halfs[4];
+  double doubles[4];
+
+  occa::getDtypeConversion(occa::dtype::half, occa::dtype::double_)(halfs, src, 4);
+  occa::getDtypeConversion(occa::dtype::double_, occa::dtype::half)(doubles, halfs, 4);
+
+  ASSERT_EQ(doubles[0], 1.5);
+  ASSERT_EQ(doubles[1], -2.25);
+  ASSERT_TRUE(std::abs(doubles[2] - 1e-3) < 1e-6);
+  // Too large for half
+  ASSERT_TRUE(std::isinf(doubles[3]));
+}
@@ -38,6 +38,15 @@ void testCharsetMethods() {
 
   ASSERT_TRUE(occa::lex::inCharset('a', "abc"));
   ASSERT_FALSE(occa::lex::inCharset('d', "abc"));
+
+  occa::lex::charsetTable_t charset("abc");
+  charset.add('\n');
+  for (int i = 0; i < 256; ++i) {
+    const char c = (char) i;
+    ASSERT_EQ(charset.has(c),
+              occa::lex::inCharset(c, "abc\n"));
+  }
+  ASSERT_FALSE(charset.has('\0'));
 }
 
 void testSkipToMethods() {
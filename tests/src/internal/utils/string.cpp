@@ -37,6 +37,10 @@ void testStrip() {
   ASSERT_EQ(strip("  a"), "a");
   ASSERT_EQ(strip("a  "), "a");
   ASSERT_EQ(strip("  a  "), "a");
+  ASSERT_EQ(strip("  "), "");
+
+  ASSERT_EQ(stripLeft("  ab  "), "ab  ");
+  ASSERT_EQ(stripRight("  ab  "), "  ab");
 }
 
 void testEscape() {
@@ -1,4 +1,5 @@
 #include <sstream>
+#include <thread>
 
 #include <occa/internal/io.hpp>
 #include <occa/types/json.hpp>
@@ -17,6 +18,9 @@ void testSize();
 void testTruthyValues();
 void testComparisons();
 void testConversions();
+void testPathValue();
+void testHash();
+void testCopyOnWrite();
 void testErrors();
 
 int main(const int argc, const char **argv) {
@@ -32,6 +36,9 @@ int main(const int argc, const char **argv) {
   testTruthyValues();
   testComparisons();
   testConversions();
+  testPathValue();
+  testHash();
+  testCopyOnWrite();
   testErrors();
 
   return 0;
@@ -486,6 +493,204 @@ void testConversions() {
             (double) j["null"]);
 }
 
+void testPathValue() {
+  occa::json j = occa::json::parse(
+    "{ a: { b: { c: 1 } }, d: [1, 2] }"
+  );
+
+  // Values are returned by reference
+  const occa::json &c = j.getPathValue("a/b/c");
+  ASSERT_EQ(&c, &(j["a"]["b"]["c"]));
+  ASSERT_EQ(1, (int) c);
+
+  ASSERT_FALSE(j.getPathValue("a/b/e").isInitialized());
+  ASSERT_FALSE(j.getPathValue("d/0").isInitialized());
+
+  ASSERT_EQ(1, j.get<int>("a/b/c"));
+  ASSERT_EQ(3, j.get<int>("a/b/e", 3));
+
+  std::vector<int> d = j.toVector<int>("d");
+  ASSERT_EQ(2, (int) d.size());
+  ASSERT_EQ(2, d[1]);
+}
+
+void testHash() {
+  const std::string source = "{ a: { b: [1, 'b', true, null] }, c: 2.5 }";
+  occa::json j = occa::json::parse(source);
+  const occa::hash_t h = j.hash();
+
+  // Hashing is structural
+  ASSERT_EQ(h, occa::json::parse(source).hash());
+  ASSERT_EQ(h, j.hash());
+  ASSERT_EQ(occa::json(1).hash(), occa::json((uint64_t) 1).hash());
+  ASSERT_NEQ(occa::json(1).hash(), occa::json("1").hash());
+  ASSERT_NEQ(occa::json(1).hash(), occa::json(true).hash());
+  ASSERT_NEQ(occa::json::parse("[]").hash(), occa::json::parse("{}").hash());
+  ASSERT_NEQ(occa::json::parse("{ ab: 'c' }").hash(),
+             occa::json::parse("{ a: 'bc' }").hash());
+
+  // Copies keep the cached hash
+  occa::json copy = j;
+  ASSERT_EQ(h, copy.hash());
+
+  // Modifying through the path invalidates the cache
+  j["a/b"][1] = "c";
+  ASSERT_NEQ(h, j.hash());
+  j["a/b"][1] = "b";
+  ASSERT_EQ(h, j.hash());
+
+  // Modifying through child references
+  occa::json &a = j["a"];
+  j.hash();
+  a["e"] = 1;
+  ASSERT_NEQ(h, j.hash());
+
+  // Rehashing the child first still updates the parent
+  a.remove("e");
+  a.hash();
+  ASSERT_EQ(h, j.hash());
+
+  // Modifying through raw value references
+  occa::jsonObject &object = j.object();
+  object.erase("c");
+  ASSERT_NEQ(h, j.hash());
+  object["c"] = 2.5;
+  ASSERT_EQ(h, j.hash());
+
+  std::string &str = j["a/b"][1].string();
+  j.hash();
+  str = "c";
+  ASSERT_NEQ(h, j.hash());
+  str = "b";
+  ASSERT_EQ(h, j.hash());
+
+  // Assigning a previously hashed value
+  occa::json other = occa::json::parse("{ x: 1 }");
+  other.hash();
+  j["a"] = other;
+  ASSERT_EQ(occa::json::parse("{ a: { x: 1 }, c: 2.5 }").hash(), j.hash());
+
+  // Merging
+  j += occa::json::parse("{ a: { b: [1, 'b', true, null] } }");
+  j["a"].remove("x");
+  ASSERT_EQ(h, j.hash());
+
+  // Copies sharing children hash them independently
+  const occa::json base = occa::json::parse(source);
+  std::vector<occa::json> copies(4, base);
+  std::vector<occa::hash_t> hashes(copies.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < copies.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      hashes[i] = copies[i].hash();
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (const occa::hash_t &copyHash : hashes) {
+    ASSERT_EQ(h, copyHash);
+  }
+
+  // Changing one copy doesn't leave the other with a stale hash
+  occa::json copy1 = base;
+  occa::json copy2 = base;
+  copy1.hash();
+  copy2.hash();
+  copy1["a/b"][1] = "c";
+  ASSERT_NEQ(h, copy1.hash());
+  ASSERT_EQ(h, copy2.hash());
+  copy2["a/b"][1] = "c";
+  ASSERT_EQ(copy1.hash(), copy2.hash());
+}
+
+void testCopyOnWrite() {
+  occa::json a = occa::json::parse("{ a: { b: 1 }, c: 1 }");
+  const occa::json &constA = a;
+
+  // Copies share objects until they're modified
+  occa::json b = a;
+  const occa::json &constB = b;
+  ASSERT_EQ(&constA.object(), &constB.object());
+  ASSERT_EQ(a, b);
+
+  b["c"] = 2;
+  ASSERT_EQ(1, (int) constA["c"]);
+  ASSERT_EQ(2, (int) constB["c"]);
+  ASSERT_NEQ(&constA.object(), &constB.object());
+
+  // Untouched subtrees are still shared
+  ASSERT_EQ(&constA["a"].object(), &constB["a"].object());
+
+  // Copies made after handing out references don't see writes made through them
+  occa::json &refA = a["a"];
+  occa::json c = a;
+  const occa::json &constC = c;
+  ASSERT_NEQ(&constA.object(), &constC.object());
+  // The referenced entry is shared until it's written to
+  ASSERT_EQ(&constA["a"].object(), &constC["a"].object());
+
+  // The copy itself shares again
+  const occa::json c2 = c;
+  ASSERT_EQ(&constC.object(), &c2.object());
+
+  refA["b"] = 3;
+  refA["f"] = 1;
+  ASSERT_NEQ(&constA["a"].object(), &constC["a"].object());
+  ASSERT_EQ(3, (int) constA["a/b"]);
+  ASSERT_EQ(1, c.get<int>("a/b"));
+  ASSERT_FALSE(c.has("a/f"));
+
+  c["a"]["g"] = 1;
+  ASSERT_FALSE(a.has("a/g"));
+  ASSERT_FALSE(c2.has("a/g"));
+  refA.remove("f");
+
+  occa::json d = a;
+  occa::jsonObject &objectA = a.object();
+  objectA["e"] = 1;
+  ASSERT_TRUE(a.has("e"));
+  ASSERT_FALSE(d.has("e"));
+
+  // Object references stay valid after assignments
+  a = constA["a"];
+  ASSERT_EQ(&objectA, &constA.object());
+  ASSERT_EQ(1, (int) objectA.size());
+  ASSERT_EQ(3, (int) constA["b"]);
+
+  a.clear();
+  ASSERT_EQ(&objectA, &a.object());
+  ASSERT_EQ(0, (int) objectA.size());
+
+  // Copying doesn't write to the source, so threads can copy the same json
+  occa::json settings = occa::json::parse("{ a: { b: 1 }, c: 1 }");
+  settings["a"]["d"] = 2;
+  const occa::json &constSettings = settings;
+  std::vector<occa::json> settingsCopies(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < settingsCopies.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      settingsCopies[i] = constSettings;
+      settingsCopies[i]["a/e"] = (int) i;
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < settingsCopies.size(); ++i) {
+    ASSERT_EQ(2, settingsCopies[i].get<int>("a/d"));
+    ASSERT_EQ((int) i, settingsCopies[i].get<int>("a/e"));
+  }
+  ASSERT_FALSE(settings.has("a/e"));
+
+  // Merging doesn't modify the original
+  occa::json props = occa::json::parse("{ a: { b: 1 }, c: 1 }");
+  occa::json merged = props + occa::json::parse("{ a: { d: 2 } }");
+  ASSERT_FALSE(props.has("a/d"));
+  ASSERT_EQ(2, merged.get<int>("a/d"));
+  ASSERT_EQ(1, merged.get<int>("a/b"));
+}
+
 void testErrors() {
   // Unknown type
   ASSERT_THROW(
@@ -0,0 +1,86 @@
+#include <thread>
+#include <vector>
+
+#include <occa.hpp>
+
+#include <occa/internal/utils/testing.hpp>
+
+void testMinMax();
+void testStripeLock();
+
+int main(const int argc, const char **argv) {
+  testMinMax();
+  testStripeLock();
+
+  return 0;
+}
+
+void testMinMax() {
+  int i = 5;
+  occa::atomics::min(&i, 7);
+  ASSERT_EQ(5, i);
+  occa::atomics::min(&i, -2);
+  ASSERT_EQ(-2, i);
+  occa::atomics::max(&i, 3);
+  ASSERT_EQ(3, i);
+  occa::atomics::max(&i, 1);
+  ASSERT_EQ(3, i);
+
+  double d = 1.5;
+  occa::atomics::min(&d, 0.25);
+  ASSERT_EQ(0.25, d);
+  occa::atomics::max(&d, 2);
+  ASSERT_EQ(2.0, d);
+
+  // Concurrent updates keep the extremes
+  const int threadCount = 4;
+  const int updates = 10000;
+  int minValue = 0;
+  int maxValue = 0;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.push_back(std::thread([&, t]() {
+      for (int u = 0; u < updates; ++u) {
+        const int value = (u * threadCount) + t;
+        occa::atomics::min(&minValue, -value);
+        occa::atomics::max(&maxValue, value);
+      }
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(-((updates * threadCount) - 1), minValue);
+  ASSERT_EQ((updates * threadCount) - 1, maxValue);
+}
+
+void testStripeLock() {
+  // Neighboring entries use different stripes
+  double values[2] = {0, 0};
+  ASSERT_NEQ(occa::atomics::stripeLock::getStripe(&values[0]),
+             occa::atomics::stripeLock::getStripe(&values[1]));
+  ASSERT_EQ(occa::atomics::stripeLock::getStripe(&values[0]),
+            occa::atomics::stripeLock::getStripe(&values[0]));
+
+  // Non-atomic updates under the same stripe don't race
+  const int threadCount = 4;
+  const int updates = 10000;
+  double sum = 0;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.push_back(std::thread([&]() {
+      for (int u = 0; u < updates; ++u) {
+        occa::atomics::stripeLock lock(&sum);
+        sum = (sum * 1.0) + 1;
+      }
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ((double) (threadCount * updates), sum);
+}
@@ -0,0 +1,75 @@
+#include <set>
+
+#include <occa.hpp>
+
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+void testHash();
+void testStreaming();
+void testHashFile();
+
+int main(const int argc, const char **argv) {
+  testHash();
+  testStreaming();
+  testHashFile();
+
+  return 0;
+}
+
+void testHash() {
+  const occa::hash_t emptyHash = occa::hash("");
+  ASSERT_TRUE(emptyHash.isInitialized());
+  ASSERT_FALSE(occa::hash_t().isInitialized());
+
+  ASSERT_EQ(occa::hash("foo"), occa::hash(std::string("foo")));
+  ASSERT_NEQ(occa::hash("foo"), occa::hash("bar"));
+
+  // Zero-padding of the last stripe doesn't cause collisions
+  const char zeros[64] = {0};
+  std::set<std::string> hashes;
+  for (int bytes = 0; bytes <= 64; ++bytes) {
+    hashes.insert(occa::hash(zeros, bytes).getFullString());
+  }
+  ASSERT_EQ((int) hashes.size(), 65);
+
+  // Hashes survive a round trip through their string representation
+  const occa::hash_t hash = occa::hash("round trip");
+  ASSERT_EQ(occa::hash_t::fromString(hash.getFullString()), hash);
+}
+
+void testStreaming() {
+  std::string data;
+  for (int i = 0; i < 1000; ++i) {
+    data += (char) ('a' + (i * 7) % 26);
+  }
+  const occa::hash_t expected = occa::hash(data);
+
+  // Any split of the data gives the same hash
+  const int chunkSizes[] = {1, 3, 31, 32, 33, 100, 1000};
+  for (const int chunkSize : chunkSizes) {
+    occa::hasher_t hasher;
+    for (int i = 0; i < (int) data.size(); i += chunkSize) {
+      hasher.update(data.substr(i, chunkSize));
+    }
+    ASSERT_EQ(hasher.digest(), expected);
+  }
+
+  // Digests don't consume the state
+  occa::hasher_t hasher;
+  hasher.update(data.substr(0, 500));
+  const occa::hash_t partialHash = hasher.digest();
+  ASSERT_EQ(partialHash, occa::hash(data.substr(0, 500)));
+  hasher.update(data.substr(500));
+  ASSERT_EQ(hasher.digest(), expected);
+
+  hasher.clear();
+  ASSERT_EQ(hasher.digest(), occa::hash(""));
+}
+
+void testHashFile() {
+  const std::string filename = occa::env::OCCA_DIR + "tests/files/addVectors.okl";
+  ASSERT_EQ(occa::hashFile(filename),
+            occa::hash(occa::io::read(filename)));
+}